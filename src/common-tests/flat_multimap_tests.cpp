@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "common/flat_multimap.h"
+#include "common/timer.h"
+#include "common/types.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+TEST(FlatMultiMap, Empty)
+{
+  FlatMultiMap<u32, void*> map;
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.GetSize(), 0u);
+  EXPECT_EQ(map.Count(0x80010000u), 0u);
+}
+
+TEST(FlatMultiMap, InsertAndLookup)
+{
+  FlatMultiMap<u32, int> map;
+  map.Insert(0x80010000u, 1);
+  map.Insert(0x80010000u, 2);
+  map.Insert(0x80020000u, 3);
+  EXPECT_EQ(map.GetSize(), 3u);
+  EXPECT_EQ(map.Count(0x80010000u), 2u);
+  EXPECT_EQ(map.Count(0x80020000u), 1u);
+  EXPECT_EQ(map.Count(0x80030000u), 0u);
+
+  std::vector<int> values;
+  map.ForEach(0x80010000u, [&values](int value) { values.push_back(value); });
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(values, (std::vector<int>{1, 2}));
+}
+
+TEST(FlatMultiMap, EraseByHandle)
+{
+  FlatMultiMap<u32, int> map;
+  const auto h1 = map.Insert(0x100u, 1);
+  const auto h2 = map.Insert(0x100u, 2);
+  const auto h3 = map.Insert(0x100u, 3);
+
+  // middle, head and tail of the chain
+  map.Erase(h2);
+  EXPECT_EQ(map.Count(0x100u), 2u);
+  map.Erase(h3);
+  EXPECT_EQ(map.Count(0x100u), 1u);
+  map.Erase(h1);
+  EXPECT_EQ(map.Count(0x100u), 0u);
+  EXPECT_TRUE(map.IsEmpty());
+}
+
+TEST(FlatMultiMap, ReusesErasedNodes)
+{
+  FlatMultiMap<u32, int> map;
+  const auto h1 = map.Insert(0x100u, 1);
+  map.Erase(h1);
+  const auto h2 = map.Insert(0x200u, 2);
+  EXPECT_EQ(h1, h2);
+  EXPECT_EQ(map.Count(0x100u), 0u);
+  EXPECT_EQ(map.Count(0x200u), 1u);
+}
+
+TEST(FlatMultiMap, Clear)
+{
+  FlatMultiMap<u32, int> map;
+  for (u32 i = 0; i < 100; i++)
+    map.Insert(i * 4, static_cast<int>(i));
+  map.Clear();
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(map.Count(0u), 0u);
+  map.Insert(0u, 1);
+  EXPECT_EQ(map.Count(0u), 1u);
+}
+
+TEST(FlatMultiMap, MatchesUnorderedMultimap)
+{
+  FlatMultiMap<u32, u32> map;
+  std::unordered_multimap<u32, u32> reference;
+  std::vector<std::pair<FlatMultiMap<u32, u32>::Handle, std::unordered_multimap<u32, u32>::iterator>> handles;
+
+  // simple LCG so the sequence is reproducible
+  u32 seed = 12345;
+  const auto next = [&seed]() {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+  };
+
+  for (u32 i = 0; i < 20000; i++)
+  {
+    if (handles.empty() || (next() % 3) != 0)
+    {
+      const u32 key = (next() % 512) * 4;
+      const u32 value = next();
+      handles.emplace_back(map.Insert(key, value), reference.emplace(key, value));
+    }
+    else
+    {
+      const size_t index = next() % handles.size();
+      map.Erase(handles[index].first);
+      reference.erase(handles[index].second);
+      handles[index] = handles.back();
+      handles.pop_back();
+    }
+  }
+
+  ASSERT_EQ(map.GetSize(), reference.size());
+  for (u32 key = 0; key < 512 * 4; key += 4)
+  {
+    std::vector<u32> values, expected;
+    map.ForEach(key, [&values](u32 value) { values.push_back(value); });
+    const auto range = reference.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+      expected.push_back(it->second);
+
+    std::sort(values.begin(), values.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(values, expected);
+  }
+}
+
+// Models the code cache's block links while a game keeps rewriting the code in a page: every block in the page has
+// its exit links removed and re-created, and the blocks linking to it are looked up for backpatching.
+// Run with --gtest_also_run_disabled_tests.
+namespace {
+static constexpr u32 BENCH_BLOCKS = 8192;
+static constexpr u32 BENCH_BLOCKS_PER_PAGE = 64;
+static constexpr u32 BENCH_ITERATIONS = 200;
+
+template<typename InsertFunc, typename EraseFunc, typename LookupFunc, typename Handle>
+double RunLinkBenchmark(std::vector<Handle>& links, const InsertFunc& insert, const EraseFunc& erase,
+                        const LookupFunc& lookup)
+{
+  const auto target_pc = [](u32 block, u32 exit) { return ((block * 7 + exit * 13) % BENCH_BLOCKS) * 16; };
+  for (u32 block = 0; block < BENCH_BLOCKS; block++)
+  {
+    for (u32 exit = 0; exit < 2; exit++)
+      links[block * 2 + exit] = insert(target_pc(block, exit), block);
+  }
+
+  Timer timer;
+  u32 found = 0;
+  for (u32 iter = 0; iter < BENCH_ITERATIONS; iter++)
+  {
+    const u32 first_block = (iter * BENCH_BLOCKS_PER_PAGE) % BENCH_BLOCKS;
+    for (u32 block = first_block; block < (first_block + BENCH_BLOCKS_PER_PAGE); block++)
+    {
+      for (u32 exit = 0; exit < 2; exit++)
+        erase(links[block * 2 + exit]);
+      found += lookup(block * 16);
+    }
+    for (u32 block = first_block; block < (first_block + BENCH_BLOCKS_PER_PAGE); block++)
+    {
+      for (u32 exit = 0; exit < 2; exit++)
+        links[block * 2 + exit] = insert(target_pc(block, exit), block);
+    }
+  }
+
+  const double ms = timer.GetTimeMilliseconds();
+  EXPECT_GT(found, 0u);
+  return ms;
+}
+} // namespace
+
+TEST(FlatMultiMap, DISABLED_BenchmarkInvalidation)
+{
+  using StdMap = std::unordered_multimap<u32, void*>;
+  StdMap std_map;
+  std::vector<StdMap::iterator> std_links(BENCH_BLOCKS * 2);
+  const double std_ms = RunLinkBenchmark(
+    std_links,
+    [&std_map](u32 pc, u32 block) {
+      return std_map.emplace(pc, reinterpret_cast<void*>(static_cast<uintptr_t>(block)));
+    },
+    [&std_map](StdMap::iterator it) { std_map.erase(it); },
+    [&std_map](u32 pc) {
+      const auto range = std_map.equal_range(pc);
+      return static_cast<u32>(std::distance(range.first, range.second));
+    });
+
+  using FlatMap = FlatMultiMap<u32, void*>;
+  FlatMap flat_map;
+  std::vector<FlatMap::Handle> flat_links(BENCH_BLOCKS * 2);
+  const double flat_ms = RunLinkBenchmark(
+    flat_links,
+    [&flat_map](u32 pc, u32 block) {
+      return flat_map.Insert(pc, reinterpret_cast<void*>(static_cast<uintptr_t>(block)));
+    },
+    [&flat_map](FlatMap::Handle handle) { flat_map.Erase(handle); },
+    [&flat_map](u32 pc) { return static_cast<u32>(flat_map.Count(pc)); });
+
+  std::printf("std::unordered_multimap: %.3f ms\nFlatMultiMap:            %.3f ms\n", std_ms, flat_ms);
+}
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/// Multimap from integer keys to values, without any per-element allocations.
+/// Values live in a single array and are chained per key, the chain heads live in an open-addressed table.
+/// Inserting returns a handle, which can be used to erase that value in constant time.
+template<typename K, typename V>
+class FlatMultiMap
+{
+  static_assert(std::is_integral_v<K>, "Key is an integer");
+  static_assert(std::is_trivially_copyable_v<V>, "Value is trivially copyable");
+
+public:
+  using Handle = std::uint32_t;
+  static constexpr Handle INVALID_HANDLE = 0xFFFFFFFFu;
+
+  FlatMultiMap() = default;
+  ~FlatMultiMap() = default;
+
+  std::size_t GetSize() const { return m_size; }
+  bool IsEmpty() const { return (m_size == 0); }
+
+  void Clear()
+  {
+    m_nodes.clear();
+    m_slots.clear();
+    m_used_slots = 0;
+    m_size = 0;
+    m_free_list = INVALID_HANDLE;
+  }
+
+  Handle Insert(K key, V value)
+  {
+    Handle handle;
+    if (m_free_list != INVALID_HANDLE)
+    {
+      handle = m_free_list;
+      m_free_list = m_nodes[handle].next;
+    }
+    else
+    {
+      handle = static_cast<Handle>(m_nodes.size());
+      m_nodes.emplace_back();
+    }
+
+    Slot& slot = m_slots[FindOrCreateSlot(key)];
+    Node& node = m_nodes[handle];
+    node.key = key;
+    node.value = value;
+    node.prev = INVALID_HANDLE;
+    node.next = slot.head;
+    if (slot.head != INVALID_HANDLE)
+      m_nodes[slot.head].prev = handle;
+    slot.head = handle;
+
+    m_size++;
+    return handle;
+  }
+
+  void Erase(Handle handle)
+  {
+    Node& node = m_nodes[handle];
+    if (node.prev != INVALID_HANDLE)
+      m_nodes[node.prev].next = node.next;
+    else
+      m_slots[FindSlot(node.key)].head = node.next;
+    if (node.next != INVALID_HANDLE)
+      m_nodes[node.next].prev = node.prev;
+
+    // Slots with an empty chain are kept around, keys tend to come back, and they're dropped on rehash.
+    node.prev = INVALID_HANDLE;
+    node.next = m_free_list;
+    m_free_list = handle;
+    m_size--;
+  }
+
+  /// Calls func(value) for every value with the specified key.
+  template<typename F>
+  void ForEach(K key, const F& func) const
+  {
+    if (m_slots.empty())
+      return;
+
+    const std::size_t slot_index = FindSlot(key);
+    if (slot_index == INVALID_SLOT)
+      return;
+
+    for (Handle handle = m_slots[slot_index].head; handle != INVALID_HANDLE;)
+    {
+      const Node& node = m_nodes[handle];
+      handle = node.next;
+      func(node.value);
+    }
+  }
+
+  std::size_t Count(K key) const
+  {
+    std::size_t count = 0;
+    ForEach(key, [&count](const V&) { count++; });
+    return count;
+  }
+
+private:
+  static constexpr std::size_t MIN_SLOTS = 64;
+  static constexpr std::size_t INVALID_SLOT = ~static_cast<std::size_t>(0);
+
+  struct Node
+  {
+    K key;
+    Handle prev;
+    Handle next;
+    V value;
+  };
+
+  struct Slot
+  {
+    K key;
+    Handle head;
+    bool used;
+  };
+
+  static std::size_t HashKey(K key)
+  {
+    // Fibonacci hashing, PCs are word aligned and tend to cluster.
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+  }
+
+  std::size_t FindSlot(K key) const
+  {
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = HashKey(key) & mask;; i = (i + 1) & mask)
+    {
+      const Slot& slot = m_slots[i];
+      if (!slot.used)
+        return INVALID_SLOT;
+      else if (slot.key == key)
+        return i;
+    }
+  }
+
+  std::size_t FindOrCreateSlot(K key)
+  {
+    // Keep the load factor under 50%, so probe sequences stay short.
+    if ((m_used_slots + 1) * 2 > m_slots.size())
+      Rehash();
+
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = HashKey(key) & mask;; i = (i + 1) & mask)
+    {
+      Slot& slot = m_slots[i];
+      if (!slot.used)
+      {
+        slot.key = key;
+        slot.head = INVALID_HANDLE;
+        slot.used = true;
+        m_used_slots++;
+        return i;
+      }
+      else if (slot.key == key)
+      {
+        return i;
+      }
+    }
+  }
+
+  void Rehash()
+  {
+    std::vector<Slot> old_slots = std::move(m_slots);
+
+    std::size_t live_slots = 0;
+    for (const Slot& slot : old_slots)
+      live_slots += static_cast<std::size_t>(slot.used && slot.head != INVALID_HANDLE);
+
+    std::size_t new_size = MIN_SLOTS;
+    while (new_size < (live_slots + 1) * 4)
+      new_size *= 2;
+
+    m_slots.assign(new_size, Slot{K(), INVALID_HANDLE, false});
+    m_used_slots = 0;
+
+    const std::size_t mask = new_size - 1;
+    for (const Slot& old_slot : old_slots)
+    {
+      if (!old_slot.used || old_slot.head == INVALID_HANDLE)
+        continue;
+
+      std::size_t i = HashKey(old_slot.key) & mask;
+      while (m_slots[i].used)
+        i = (i + 1) & mask;
+
+      m_slots[i] = old_slot;
+      m_used_slots++;
+    }
+  }
+
+  std::vector<Node> m_nodes;
+  std::vector<Slot> m_slots;
+  std::size_t m_used_slots = 0;
+  std::size_t m_size = 0;
+  Handle m_free_list = INVALID_HANDLE;
+};
@@ -5,21 +5,25 @@
 #include "align.h"
 #include "assert.h"
 #include "error.h"
+#include "file_system.h"
 #include "log.h"
 #include "small_string.h"
 #include "string_util.h"
 
 #include "fmt/format.h"
 
+#include <limits>
 #include <memory>
 
 #if defined(_WIN32)
 #include "windows_headers.h"
 #include <Psapi.h>
+#include <io.h>
 #elif defined(__APPLE__)
 #ifdef __aarch64__
 #include <pthread.h> // pthread_jit_write_protect_np()
 #endif
+#include <cerrno>
 #include <mach-o/dyld.h>
 #include <mach-o/getsect.h>
 #include <mach/mach_init.h>
@@ -985,3 +989,166 @@ void* MemMap::AllocateJITMemory(size_t size)
 
   return ptr;
 }
+
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Map(std::FILE* fp, Error* error)
+{
+  Unmap();
+
+  const s64 size = FileSystem::FSize64(fp, error);
+  if (size <= 0 || static_cast<u64>(size) > std::numeric_limits<size_t>::max())
+  {
+    Error::SetStringView(error, "File is empty or too large to map.");
+    return false;
+  }
+
+  const HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(fp)));
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+  {
+    Error::SetWin32(error, "CreateFileMappingW() failed: ", GetLastError());
+    return false;
+  }
+
+  // The view holds a reference to the mapping object.
+  void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  const DWORD map_error = GetLastError();
+  CloseHandle(mapping);
+  if (!ptr)
+  {
+    Error::SetWin32(error, "MapViewOfFile() failed: ", map_error);
+    return false;
+  }
+
+  m_data = static_cast<const u8*>(ptr);
+  m_size = static_cast<size_t>(size);
+  return true;
+}
+
+void MappedFile::Unmap()
+{
+  if (!m_data)
+    return;
+
+  if (m_locked)
+    VirtualUnlock(const_cast<u8*>(m_data), m_size);
+
+  UnmapViewOfFile(m_data);
+  m_data = nullptr;
+  m_size = 0;
+  m_locked = false;
+}
+
+void MappedFile::AdviseSequential()
+{
+  // No equivalent, the cache manager already detects sequential access.
+}
+
+bool MappedFile::Lock(Error* error)
+{
+  if (m_locked)
+    return true;
+
+  WIN32_MEMORY_RANGE_ENTRY range = {const_cast<u8*>(m_data), m_size};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+  if (!VirtualLock(const_cast<u8*>(m_data), m_size))
+  {
+    Error::SetWin32(error, "VirtualLock() failed: ", GetLastError());
+    return false;
+  }
+
+  m_locked = true;
+  return true;
+}
+
+void MappedFile::Unlock()
+{
+  if (!m_locked)
+    return;
+
+  VirtualUnlock(const_cast<u8*>(m_data), m_size);
+  m_locked = false;
+}
+
+#else
+
+bool MappedFile::Map(std::FILE* fp, Error* error)
+{
+  Unmap();
+
+  const s64 size = FileSystem::FSize64(fp, error);
+  if (size <= 0 || static_cast<u64>(size) > std::numeric_limits<size_t>::max())
+  {
+    Error::SetStringView(error, "File is empty or too large to map.");
+    return false;
+  }
+
+  void* ptr = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fileno(fp), 0);
+  if (ptr == MAP_FAILED)
+  {
+    Error::SetErrno(error, "mmap() failed: ", errno);
+    return false;
+  }
+
+  m_data = static_cast<const u8*>(ptr);
+  m_size = static_cast<size_t>(size);
+  return true;
+}
+
+void MappedFile::Unmap()
+{
+  if (!m_data)
+    return;
+
+  if (m_locked)
+    munlock(m_data, m_size);
+
+  munmap(const_cast<u8*>(m_data), m_size);
+  m_data = nullptr;
+  m_size = 0;
+  m_locked = false;
+}
+
+void MappedFile::AdviseSequential()
+{
+  if (madvise(const_cast<u8*>(m_data), m_size, MADV_SEQUENTIAL) != 0)
+    WARNING_LOG("madvise(MADV_SEQUENTIAL) failed: {}", errno);
+}
+
+bool MappedFile::Lock(Error* error)
+{
+  if (m_locked)
+    return true;
+
+  if (madvise(const_cast<u8*>(m_data), m_size, MADV_WILLNEED) != 0)
+    WARNING_LOG("madvise(MADV_WILLNEED) failed: {}", errno);
+
+  if (mlock(m_data, m_size) != 0)
+  {
+    Error::SetErrno(error, "mlock() failed: ", errno);
+    return false;
+  }
+
+  m_locked = true;
+  return true;
+}
+
+void MappedFile::Unlock()
+{
+  if (!m_locked)
+    return;
+
+  munlock(m_data, m_size);
+  m_locked = false;
+}
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "types.h"
 
+#include <cstdio>
 #include <map>
 #include <string>
 
@@ -126,3 +127,34 @@ private:
   PlaceholderMap m_placeholder_ranges;
 #endif
 };
+
+/// Read-only view of an entire file. The file can be closed once it is mapped.
+class MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ALWAYS_INLINE bool IsMapped() const { return (m_data != nullptr); }
+  ALWAYS_INLINE const u8* GetData() const { return m_data; }
+  ALWAYS_INLINE size_t GetSize() const { return m_size; }
+  ALWAYS_INLINE bool IsLocked() const { return m_locked; }
+
+  bool Map(std::FILE* fp, Error* error);
+  void Unmap();
+
+  /// Hints to the OS that the file will be read front to back, so it can read ahead more aggressively.
+  void AdviseSequential();
+
+  /// Faults in and locks the whole file in memory. The pages are shared with the OS file cache.
+  bool Lock(Error* error);
+  void Unlock();
+
+private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+  bool m_locked = false;
+};
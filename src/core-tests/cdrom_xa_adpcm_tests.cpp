@@ -0,0 +1,371 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "test_random.h"
+
+#include "core/cdrom_dsp.h"
+
+#include "common/bitutils.h"
+#include "common/timer.h"
+#include "common/types.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using CDROM::DSP::XA_ADPCMBlockHeader;
+
+namespace {
+static constexpr u32 SECTOR_DATA_SIZE = 18 * 128;
+static constexpr u32 SAMPLES_PER_SECTOR_4BIT = 4032;
+static constexpr u32 SAMPLES_PER_SECTOR_8BIT = 2016;
+
+struct XAState
+{
+  std::array<s32, 4> last_samples{};
+  CDROM::DSP::XAResampleState resample;
+  std::vector<u32> frames;
+
+  void AddFrame(s16 left, s16 right)
+  {
+    frames.push_back(ZeroExtend32(static_cast<u16>(left)) | (ZeroExtend32(static_cast<u16>(right)) << 16));
+  }
+};
+} // namespace
+
+// Previous scalar implementations of the CDROM decoder and resamplers, which the vector versions have to match.
+template<bool IS_STEREO, bool IS_8BIT>
+static void DecodeXAADPCMChunks_Scalar(XAState& state, const u8* chunk_ptr, s16* samples)
+{
+  static constexpr std::array<s8, 16> filter_table_pos = {{0, 60, 115, 98, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+  static constexpr std::array<s8, 16> filter_table_neg = {{0, 0, -52, -55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+
+  // The data layout is annoying here. Each word of data is interleaved with the other blocks, requiring multiple
+  // passes to decode the whole chunk.
+  constexpr u32 NUM_CHUNKS = 18;
+  constexpr u32 CHUNK_SIZE_IN_BYTES = 128;
+  constexpr u32 WORDS_PER_CHUNK = 28;
+  constexpr u32 SAMPLES_PER_CHUNK = WORDS_PER_CHUNK * (IS_8BIT ? 4 : 8);
+  constexpr u32 NUM_BLOCKS = IS_8BIT ? 4 : 8;
+  constexpr u32 WORDS_PER_BLOCK = 28;
+
+  for (u32 i = 0; i < NUM_CHUNKS; i++)
+  {
+    const u8* headers_ptr = chunk_ptr + 4;
+    const u8* words_ptr = chunk_ptr + 16;
+
+    for (u32 block = 0; block < NUM_BLOCKS; block++)
+    {
+      const XA_ADPCMBlockHeader block_header{headers_ptr[block]};
+      const u8 shift = block_header.GetShift();
+      const u8 filter = block_header.GetFilter();
+      const s32 filter_pos = filter_table_pos[filter];
+      const s32 filter_neg = filter_table_neg[filter];
+
+      s16* out_samples_ptr =
+        IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
+      constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
+
+      for (u32 word = 0; word < 28; word++)
+      {
+        // NOTE: assumes LE
+        u32 word_data;
+        std::memcpy(&word_data, &words_ptr[word * sizeof(u32)], sizeof(word_data));
+
+        // extract nibble from block
+        const u32 nibble = IS_8BIT ? ((word_data >> (block * 8)) & 0xFF) : ((word_data >> (block * 4)) & 0x0F);
+        const s16 sample = static_cast<s16>(Truncate16(nibble << (IS_8BIT ? 8 : 12))) >> shift;
+
+        // mix in previous values
+        s32* prev = IS_STEREO ? &state.last_samples[(block & 1) * 2] : &state.last_samples[0];
+        const s32 interp_sample = std::clamp<s32>(
+          static_cast<s32>(sample) + ((prev[0] * filter_pos) >> 6) + ((prev[1] * filter_neg) >> 6), -32768, 32767);
+
+        // update previous values
+        prev[1] = prev[0];
+        prev[0] = interp_sample;
+
+        *out_samples_ptr = static_cast<s16>(interp_sample);
+        out_samples_ptr += out_samples_increment;
+      }
+    }
+
+    samples += SAMPLES_PER_CHUNK;
+    chunk_ptr += CHUNK_SIZE_IN_BYTES;
+  }
+}
+
+template<bool STEREO>
+static void ResampleXAADPCM_Scalar(XAState& state, const s16* frames_in, u32 num_frames_in)
+{
+  static constexpr auto zigzag_interpolate = [](const s16* ringbuf, u32 table_index, u32 p) -> s16 {
+    static std::array<std::array<s16, 29>, 7> tables = {
+      {{0,      0x0,     0x0,     0x0,    0x0,     -0x0002, 0x000A,  -0x0022, 0x0041, -0x0054,
+        0x0034, 0x0009,  -0x010A, 0x0400, -0x0A78, 0x234C,  0x6794,  -0x1780, 0x0BCD, -0x0623,
+        0x0350, -0x016D, 0x006B,  0x000A, -0x0010, 0x0011,  -0x0008, 0x0003,  -0x0001},
+       {0,       0x0,    0x0,     -0x0002, 0x0,    0x0003,  -0x0013, 0x003C,  -0x004B, 0x00A2,
+        -0x00E3, 0x0132, -0x0043, -0x0267, 0x0C9D, 0x74BB,  -0x11B4, 0x09B8,  -0x05BF, 0x0372,
+        -0x01A8, 0x00A6, -0x001B, 0x0005,  0x0006, -0x0008, 0x0003,  -0x0001, 0x0},
+       {0,      0x0,     -0x0001, 0x0003,  -0x0002, -0x0005, 0x001F,  -0x004A, 0x00B3, -0x0192,
+        0x02B1, -0x039E, 0x04F8,  -0x05A6, 0x7939,  -0x05A6, 0x04F8,  -0x039E, 0x02B1, -0x0192,
+        0x00B3, -0x004A, 0x001F,  -0x0005, -0x0002, 0x0003,  -0x0001, 0x0,     0x0},
+       {0,       -0x0001, 0x0003,  -0x0008, 0x0006, 0x0005,  -0x001B, 0x00A6, -0x01A8, 0x0372,
+        -0x05BF, 0x09B8,  -0x11B4, 0x74BB,  0x0C9D, -0x0267, -0x0043, 0x0132, -0x00E3, 0x00A2,
+        -0x004B, 0x003C,  -0x0013, 0x0003,  0x0,    -0x0002, 0x0,     0x0,    0x0},
+       {-0x0001, 0x0003,  -0x0008, 0x0011,  -0x0010, 0x000A, 0x006B,  -0x016D, 0x0350, -0x0623,
+        0x0BCD,  -0x1780, 0x6794,  0x234C,  -0x0A78, 0x0400, -0x010A, 0x0009,  0x0034, -0x0054,
+        0x0041,  -0x0022, 0x000A,  -0x0001, 0x0,     0x0001, 0x0,     0x0,     0x0},
+       {0x0002,  -0x0008, 0x0010,  -0x0023, 0x002B, 0x001A,  -0x00EB, 0x027B,  -0x0548, 0x0AFA,
+        -0x16FA, 0x53E0,  0x3C07,  -0x1249, 0x080E, -0x0347, 0x015B,  -0x0044, -0x0017, 0x0046,
+        -0x0023, 0x0011,  -0x0005, 0x0,     0x0,    0x0,     0x0,     0x0,     0x0},
+       {-0x0005, 0x0011,  -0x0023, 0x0046, -0x0017, -0x0044, 0x015B,  -0x0347, 0x080E, -0x1249,
+        0x3C07,  0x53E0,  -0x16FA, 0x0AFA, -0x0548, 0x027B,  -0x00EB, 0x001A,  0x002B, -0x0023,
+        0x0010,  -0x0008, 0x0002,  0x0,    0x0,     0x0,     0x0,     0x0,     0x0}}};
+
+    const s16* table = tables[table_index].data();
+    s32 sum = 0;
+    for (u32 i = 0; i < 29; i++)
+      sum += (static_cast<s32>(ringbuf[(p - i) & 0x1F]) * static_cast<s32>(table[i])) >> 15;
+
+    return static_cast<s16>(std::clamp<s32>(sum, -0x8000, 0x7FFF));
+  };
+
+  s16* const left_ringbuf = state.resample.ring_buffer[0].data();
+  [[maybe_unused]] s16* const right_ringbuf = state.resample.ring_buffer[1].data();
+  u32 p = state.resample.p;
+  u32 sixstep = state.resample.sixstep;
+
+  for (u32 in_sample_index = 0; in_sample_index < num_frames_in; in_sample_index++)
+  {
+    // TODO: We can vectorize the multiplications in zigzag_interpolate by duplicating the sample in the ringbuffer at
+    // offset +32, allowing it to wrap once.
+    left_ringbuf[p] = *(frames_in++);
+    if constexpr (STEREO)
+      right_ringbuf[p] = *(frames_in++);
+    p = (p + 1) % 32;
+    sixstep--;
+
+    if (sixstep == 0)
+    {
+      sixstep = 6;
+      for (u32 j = 0; j < 7; j++)
+      {
+        const s16 left_interp = zigzag_interpolate(left_ringbuf, j, p);
+        const s16 right_interp = STEREO ? zigzag_interpolate(right_ringbuf, j, p) : left_interp;
+        state.AddFrame(left_interp, right_interp);
+      }
+    }
+  }
+
+  state.resample.p = Truncate8(p);
+  state.resample.sixstep = Truncate8(sixstep);
+}
+
+template<bool STEREO>
+static void ResampleXAADPCM18900_Scalar(XAState& state, const s16* frames_in, u32 num_frames_in)
+{
+  // Weights originally from Mednafen's interpolator. It's unclear where these came from, perhaps it was calculated
+  // somehow. This doesn't appear to use a zigzag pattern like psx-spx suggests, therefore it is restricted to only
+  // 18900hz resampling. Duplicating the 18900hz samples to 37800hz sounds even more awful than lower sample rate audio
+  // should, with a big spike at ~16KHz, especially with music in FMVs. Fortunately, few games actually use 18900hz XA.
+  static constexpr auto interpolate = [](const s16* ringbuf, u32 table_index, u32 p) -> s16 {
+    static std::array<std::array<s16, 25>, 7> tables = {{
+      {{0x0,     -0x5,  0x11,   -0x23, 0x46,  -0x17, -0x44, 0x15b, -0x347, 0x80e, -0x1249, 0x3c07, 0x53e0,
+        -0x16fa, 0xafa, -0x548, 0x27b, -0xeb, 0x1a,  0x2b,  -0x23, 0x10,   -0x8,  0x2,     0x0}},
+      {{0x0,     -0x2,  0xa,    -0x22, 0x41,   -0x54, 0x34, 0x9,   -0x10a, 0x400, -0xa78, 0x234c, 0x6794,
+        -0x1780, 0xbcd, -0x623, 0x350, -0x16d, 0x6b,  0xa,  -0x10, 0x11,   -0x8,  0x3,    -0x1}},
+      {{-0x2,    0x0,   0x3,    -0x13, 0x3c,   -0x4b, 0xa2,  -0xe3, 0x132, -0x43, -0x267, 0xc9d, 0x74bb,
+        -0x11b4, 0x9b8, -0x5bf, 0x372, -0x1a8, 0xa6,  -0x1b, 0x5,   0x6,   -0x8,  0x3,    -0x1}},
+      {{-0x1,   0x3,   -0x2,   -0x5,  0x1f,   -0x4a, 0xb3,  -0x192, 0x2b1, -0x39e, 0x4f8, -0x5a6, 0x7939,
+        -0x5a6, 0x4f8, -0x39e, 0x2b1, -0x192, 0xb3,  -0x4a, 0x1f,   -0x5,  -0x2,   0x3,   -0x1}},
+      {{-0x1,  0x3,    -0x8,  0x6,   0x5,   -0x1b, 0xa6,  -0x1a8, 0x372, -0x5bf, 0x9b8, -0x11b4, 0x74bb,
+        0xc9d, -0x267, -0x43, 0x132, -0xe3, 0xa2,  -0x4b, 0x3c,   -0x13, 0x3,    0x0,   -0x2}},
+      {{-0x1,   0x3,    -0x8,  0x11,   -0x10, 0xa,  0x6b,  -0x16d, 0x350, -0x623, 0xbcd, -0x1780, 0x6794,
+        0x234c, -0xa78, 0x400, -0x10a, 0x9,   0x34, -0x54, 0x41,   -0x22, 0xa,    -0x2,  0x0}},
+      {{0x0,    0x2,     -0x8,  0x10,   -0x23, 0x2b,  0x1a,  -0xeb, 0x27b, -0x548, 0xafa, -0x16fa, 0x53e0,
+        0x3c07, -0x1249, 0x80e, -0x347, 0x15b, -0x44, -0x17, 0x46,  -0x23, 0x11,   -0x5,  0x0}},
+    }};
+
+    const s16* table = tables[table_index].data();
+    s32 sum = 0;
+    for (u32 i = 0; i < 25; i++)
+      sum += (static_cast<s32>(ringbuf[(p + 32 - 25 + i) & 0x1F]) * static_cast<s32>(table[i]));
+
+    return static_cast<s16>(std::clamp<s32>(sum >> 15, -0x8000, 0x7FFF));
+  };
+
+  s16* const left_ringbuf = state.resample.ring_buffer[0].data();
+  [[maybe_unused]] s16* const right_ringbuf = state.resample.ring_buffer[1].data();
+  u32 p = state.resample.p;
+  u32 sixstep = state.resample.sixstep;
+
+  for (u32 in_sample_index = 0; in_sample_index < num_frames_in;)
+  {
+    if (sixstep >= 7)
+    {
+      sixstep -= 7;
+      p = (p + 1) % 32;
+
+      left_ringbuf[p] = *(frames_in++);
+      if constexpr (STEREO)
+        right_ringbuf[p] = *(frames_in++);
+
+      in_sample_index++;
+    }
+
+    const s16 left_interp = interpolate(left_ringbuf, sixstep, p);
+    const s16 right_interp = STEREO ? interpolate(right_ringbuf, sixstep, p) : left_interp;
+    state.AddFrame(left_interp, right_interp);
+    sixstep += 3;
+  }
+
+  state.resample.p = Truncate8(p);
+  state.resample.sixstep = Truncate8(sixstep);
+}
+
+namespace {
+struct XAFormat
+{
+  bool stereo;
+  bool is_8bit;
+  bool half_rate;
+};
+
+static constexpr XAFormat s_formats[] = {
+  {false, false, false}, {true, false, false}, {false, true, false}, {true, true, false},
+  {false, false, true},  {true, false, true},  {false, true, true},  {true, true, true},
+};
+} // namespace
+
+// Random sector data. Real streams only use filters 0-3 and shifts 0-12, the other values are covered when
+// valid_headers is false.
+static std::vector<u8> GenerateSectors(TestRandom& rand, u32 count, bool valid_headers)
+{
+  std::vector<u8> data(SECTOR_DATA_SIZE * count);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rand.Next());
+
+  if (valid_headers)
+  {
+    for (size_t chunk = 0; chunk < data.size(); chunk += 128)
+    {
+      for (u32 i = 0; i < 16; i++)
+        data[chunk + i] = static_cast<u8>(((rand.Next() % 4) << 4) | (rand.Next() % 13));
+    }
+  }
+
+  return data;
+}
+
+template<bool IS_STEREO, bool IS_8BIT>
+static void DecodeSector(XAState& state, const u8* sector, s16* samples, bool vector)
+{
+  if (vector)
+    CDROM::DSP::DecodeXAADPCMChunks<IS_STEREO, IS_8BIT>(sector, samples, &state.last_samples);
+  else
+    DecodeXAADPCMChunks_Scalar<IS_STEREO, IS_8BIT>(state, sector, samples);
+}
+
+template<bool STEREO>
+static void ResampleSector(XAState& state, const s16* samples, u32 num_frames, bool half_rate, bool vector)
+{
+  const auto add_frame = [&state](s16 left, s16 right) { state.AddFrame(left, right); };
+  if (half_rate)
+  {
+    if (vector)
+      CDROM::DSP::ResampleXAADPCM18900<STEREO>(&state.resample, samples, num_frames, add_frame);
+    else
+      ResampleXAADPCM18900_Scalar<STEREO>(state, samples, num_frames);
+  }
+  else
+  {
+    if (vector)
+      CDROM::DSP::ResampleXAADPCM<STEREO>(&state.resample, samples, num_frames, add_frame);
+    else
+      ResampleXAADPCM_Scalar<STEREO>(state, samples, num_frames);
+  }
+}
+
+// Same as CDROM::ProcessXAADPCMSector().
+static void ProcessSector(XAState& state, const u8* sector, const XAFormat& format, bool vector)
+{
+  std::array<s16, SAMPLES_PER_SECTOR_4BIT> samples;
+  const u32 num_frames = (format.is_8bit ? SAMPLES_PER_SECTOR_8BIT : SAMPLES_PER_SECTOR_4BIT) >> format.stereo;
+  if (format.is_8bit)
+  {
+    if (format.stereo)
+      DecodeSector<true, true>(state, sector, samples.data(), vector);
+    else
+      DecodeSector<false, true>(state, sector, samples.data(), vector);
+  }
+  else
+  {
+    if (format.stereo)
+      DecodeSector<true, false>(state, sector, samples.data(), vector);
+    else
+      DecodeSector<false, false>(state, sector, samples.data(), vector);
+  }
+
+  if (format.stereo)
+    ResampleSector<true>(state, samples.data(), num_frames, format.half_rate, vector);
+  else
+    ResampleSector<false>(state, samples.data(), num_frames, format.half_rate, vector);
+}
+
+TEST(CDROMDSP, XAADPCMDecodeAndResample)
+{
+  static constexpr u32 NUM_SECTORS = 64;
+
+  TestRandom rand;
+  for (const bool valid_headers : {true, false})
+  {
+    for (const XAFormat& format : s_formats)
+    {
+      const std::vector<u8> sectors = GenerateSectors(rand, NUM_SECTORS, valid_headers);
+      XAState scalar_state, vector_state;
+      for (u32 i = 0; i < NUM_SECTORS; i++)
+      {
+        ProcessSector(scalar_state, &sectors[i * SECTOR_DATA_SIZE], format, false);
+        ProcessSector(vector_state, &sectors[i * SECTOR_DATA_SIZE], format, true);
+      }
+
+      ASSERT_EQ(scalar_state.frames, vector_state.frames);
+      ASSERT_EQ(scalar_state.last_samples, vector_state.last_samples);
+      ASSERT_EQ(scalar_state.resample.ring_buffer, vector_state.resample.ring_buffer);
+      ASSERT_EQ(scalar_state.resample.p, vector_state.resample.p);
+      ASSERT_EQ(scalar_state.resample.sixstep, vector_state.resample.sixstep);
+    }
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(CDROMDSP, DISABLED_BenchmarkXAADPCM)
+{
+  // 60 seconds of 37800hz 4-bit stereo, the usual format for streamed music.
+  static constexpr XAFormat format = {true, false, false};
+  static constexpr u32 NUM_SECTORS = 75 * 60;
+
+  TestRandom rand;
+  const std::vector<u8> sectors = GenerateSectors(rand, NUM_SECTORS, true);
+
+  XAState scalar_state;
+  scalar_state.frames.reserve(NUM_SECTORS * 2352);
+  Timer timer;
+  for (u32 i = 0; i < NUM_SECTORS; i++)
+    ProcessSector(scalar_state, &sectors[i * SECTOR_DATA_SIZE], format, false);
+  const double scalar_ms = timer.GetTimeMilliseconds();
+
+  XAState vector_state;
+  vector_state.frames.reserve(NUM_SECTORS * 2352);
+  timer.Reset();
+  for (u32 i = 0; i < NUM_SECTORS; i++)
+    ProcessSector(vector_state, &sectors[i * SECTOR_DATA_SIZE], format, true);
+  const double vector_ms = timer.GetTimeMilliseconds();
+
+  EXPECT_EQ(scalar_state.frames, vector_state.frames);
+  std::printf("60 seconds of 37800hz stereo XA\nScalar: %.3f ms\nVector: %.3f ms\n", scalar_ms, vector_ms);
+}
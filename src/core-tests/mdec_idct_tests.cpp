@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "test_random.h"
+
+#include "core/mdec_dsp.h"
+
+#include "common/bitutils.h"
+#include "common/timer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+// Previous implementation of MDEC::IDCT_New(), which the vector version has to match.
+static s16 IDCTRow_Scalar(const s16* blk, const s16* idct_matrix)
+{
+  // IDCT matrix is -32768..32767, block is -16384..16383. 4 adds can happen without overflow.
+  GSVector4i sum = GSVector4i::load<false>(blk).madd_s16(GSVector4i::load<true>(idct_matrix)).addp_s32();
+  return static_cast<s16>(((static_cast<s64>(sum.extract32<0>()) + static_cast<s64>(sum.extract32<1>())) + 0x20000) >>
+                          18);
+}
+
+static void IDCT_Scalar(s16* blk, const std::array<s16, 64>& scale_table)
+{
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> temp;
+  for (u32 x = 0; x < 8; x++)
+  {
+    for (u32 y = 0; y < 8; y++)
+      temp[y * 8 + x] = IDCTRow_Scalar(&blk[x * 8], &scale_table[y * 8]);
+  }
+  for (u32 x = 0; x < 8; x++)
+  {
+    for (u32 y = 0; y < 8; y++)
+    {
+      const s32 sum = IDCTRow_Scalar(&temp[x * 8], &scale_table[y * 8]);
+      blk[x * 8 + y] = static_cast<s16>(std::clamp(SignExtendN<9, s32>(sum), -128, 127));
+    }
+  }
+}
+
+namespace {
+struct alignas(VECTOR_ALIGNMENT) Block
+{
+  std::array<s16, 64> data;
+};
+} // namespace
+
+static void CheckIDCT(const Block& input, const std::array<s16, 64>& scale_table)
+{
+  Block scalar = input;
+  Block vector = input;
+  IDCT_Scalar(scalar.data.data(), scale_table);
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> idct_matrix;
+  MDEC::DSP::ComputeIDCTMatrix(scale_table, &idct_matrix);
+  MDEC::DSP::IDCT(vector.data.data(), idct_matrix.data());
+  ASSERT_EQ(scalar.data, vector.data);
+}
+
+TEST(MDECDSP, IDCT)
+{
+  // Standard scale table, as uploaded by the BIOS.
+  static constexpr std::array<u16, 64> bios_scale_matrix = {
+    0x5A82, 0x5A82, 0x5A82, 0x5A82, 0x5A82, 0x5A82, 0x5A82, 0x5A82, 0x7D8A, 0x6A6D, 0x471C, 0x18F8, 0xE707,
+    0xB8E3, 0x9592, 0x8275, 0x7641, 0x30FB, 0xCF04, 0x89BE, 0x89BE, 0xCF04, 0x30FB, 0x7641, 0x6A6D, 0xE707,
+    0x8275, 0xB8E3, 0x471C, 0x7D8A, 0x18F8, 0x9592, 0x5A82, 0xA57D, 0xA57D, 0x5A82, 0x5A82, 0xA57D, 0xA57D,
+    0x5A82, 0x471C, 0x8275, 0x18F8, 0x6A6D, 0x9592, 0xE707, 0x7D8A, 0xB8E3, 0x30FB, 0x89BE, 0x7641, 0xCF04,
+    0xCF04, 0x7641, 0x89BE, 0x30FB, 0x18F8, 0xB8E3, 0x6A6D, 0x8275, 0x7D8A, 0x9592, 0x471C, 0xE707};
+  std::array<s16, 64> bios_scale_table;
+  for (u32 y = 0; y < 8; y++)
+  {
+    for (u32 x = 0; x < 8; x++)
+      bios_scale_table[y * 8 + x] = static_cast<s16>(bios_scale_matrix[x * 8 + y]);
+  }
+
+  TestRandom rand;
+  for (u32 iter = 0; iter < 100000; iter++)
+  {
+    // Decoded coefficients are 11-bit values multiplied by the quantization scale, cover the full range as well.
+    Block block;
+    const u32 range = iter % 3;
+    for (s16& value : block.data)
+    {
+      value = (range == 0) ? static_cast<s16>(SignExtendN<11, s32>(static_cast<s32>(rand.Next()))) :
+              (range == 1) ? static_cast<s16>(std::clamp<s32>(rand.NextS16() / 2, -16384, 16383)) :
+                             rand.NextS16();
+    }
+
+    std::array<s16, 64> scale_table = bios_scale_table;
+    if (iter & 1)
+    {
+      for (s16& value : scale_table)
+        value = rand.NextS16();
+    }
+
+    CheckIDCT(block, scale_table);
+  }
+
+  // Extremes, which overflow the 32-bit halves.
+  for (const s16 block_value : {static_cast<s16>(-32768), static_cast<s16>(32767), static_cast<s16>(-16384)})
+  {
+    for (const s16 scale_value : {static_cast<s16>(-32768), static_cast<s16>(32767)})
+    {
+      Block block;
+      block.data.fill(block_value);
+      std::array<s16, 64> scale_table;
+      scale_table.fill(scale_value);
+      CheckIDCT(block, scale_table);
+    }
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(MDECDSP, DISABLED_BenchmarkIDCT)
+{
+  // Roughly a minute of 320x240 video at 30fps, six blocks per 16x16 macroblock.
+  static constexpr u32 NUM_BLOCKS = 300 * 6 * 30 * 60;
+  static constexpr u32 NUM_UNIQUE_BLOCKS = 1024;
+
+  TestRandom rand;
+  std::vector<Block> blocks(NUM_UNIQUE_BLOCKS);
+  for (Block& block : blocks)
+  {
+    // Mostly zero coefficients, like real video.
+    for (s16& value : block.data)
+      value = ((rand.Next() % 4) == 0) ? static_cast<s16>(SignExtendN<11, s32>(static_cast<s32>(rand.Next()))) : 0;
+  }
+
+  std::array<s16, 64> scale_table;
+  for (s16& value : scale_table)
+    value = rand.NextS16();
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> idct_matrix;
+  MDEC::DSP::ComputeIDCTMatrix(scale_table, &idct_matrix);
+
+  s32 checksum = 0;
+  Timer timer;
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+  {
+    Block block = blocks[i % NUM_UNIQUE_BLOCKS];
+    IDCT_Scalar(block.data.data(), scale_table);
+    checksum += block.data[i % 64];
+  }
+  const double scalar_ms = timer.GetTimeMilliseconds();
+
+  timer.Reset();
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+  {
+    Block block = blocks[i % NUM_UNIQUE_BLOCKS];
+    MDEC::DSP::IDCT(block.data.data(), idct_matrix.data());
+    checksum -= block.data[i % 64];
+  }
+  const double vector_ms = timer.GetTimeMilliseconds();
+
+  EXPECT_EQ(checksum, 0);
+  std::printf("%u blocks\nScalar: %.3f ms\nVector: %.3f ms\n", NUM_BLOCKS, scalar_ms, vector_ms);
+}
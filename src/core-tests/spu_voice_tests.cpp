@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "test_random.h"
+
+#include "core/spu_dsp.h"
+
+#include "common/bitutils.h"
+#include "common/timer.h"
+#include "common/types.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using SPU::DSP::NUM_VOICES;
+using SPU::DSP::VoiceMixBatch;
+using SPU::DSP::VoiceMixSums;
+
+static s16 GetTap(u32 pair, u32 index)
+{
+  return static_cast<s16>(static_cast<u16>(pair >> (index * 16)));
+}
+
+static s32 ApplyVolume(s32 sample, s32 volume)
+{
+  return (sample * volume) >> 15;
+}
+
+// Reference for SPU::DSP::MixVoiceBatch(), one voice at a time like the original SPU::SampleVoice().
+static VoiceMixSums MixVoices_Scalar(VoiceMixBatch& batch, s16 noise_level)
+{
+  VoiceMixSums sums = {};
+  for (u32 i = 0; i < NUM_VOICES; i++)
+  {
+    if (!batch.active_mask[i])
+    {
+      batch.volume[i] = batch.left[i] = batch.right[i] = 0;
+      continue;
+    }
+
+    // Same as the original SPU::Voice::Interpolate().
+    s32 sample;
+    if (batch.noise_mask[i])
+    {
+      sample = noise_level;
+    }
+    else
+    {
+      s32 out = s32(GetTap(batch.gauss01[i], 0)) * s32(GetTap(batch.taps01[i], 0));
+      out += s32(GetTap(batch.gauss01[i], 1)) * s32(GetTap(batch.taps01[i], 1));
+      out += s32(GetTap(batch.gauss23[i], 0)) * s32(GetTap(batch.taps23[i], 0));
+      out += s32(GetTap(batch.gauss23[i], 1)) * s32(GetTap(batch.taps23[i], 1));
+      sample = out >> 15;
+    }
+
+    batch.volume[i] = ApplyVolume(sample, batch.adsr_volume[i]);
+    batch.left[i] = ApplyVolume(batch.volume[i], batch.left_volume[i]);
+    batch.right[i] = ApplyVolume(batch.volume[i], batch.right_volume[i]);
+    sums.left += batch.left[i];
+    sums.right += batch.right[i];
+    if (batch.reverb_mask[i])
+    {
+      sums.reverb_left += batch.left[i];
+      sums.reverb_right += batch.right[i];
+    }
+  }
+
+  return sums;
+}
+
+static void FillBatch(VoiceMixBatch& batch, TestRandom& rand)
+{
+  const auto pack = [](s16 a, s16 b) {
+    return ZeroExtend32(static_cast<u16>(a)) | (ZeroExtend32(static_cast<u16>(b)) << 16);
+  };
+
+  // Gaussian coefficients are never -0x8000, which is the only case where the paired multiply-add can overflow.
+  const auto coefficient = [&rand]() { return static_cast<s16>(std::max<s32>(rand.NextS16(), -0x7FFF)); };
+
+  for (u32 i = 0; i < NUM_VOICES; i++)
+  {
+    batch.taps01[i] = pack(rand.NextS16(), rand.NextS16());
+    batch.taps23[i] = pack(rand.NextS16(), rand.NextS16());
+    batch.gauss01[i] = pack(coefficient(), coefficient());
+    batch.gauss23[i] = pack(coefficient(), coefficient());
+    batch.adsr_volume[i] = (rand.Next() & 1) ? rand.NextS16() : static_cast<s16>(rand.Next() & 0x7FFF);
+    batch.left_volume[i] = rand.NextS16();
+    batch.right_volume[i] = rand.NextS16();
+    batch.active_mask[i] = ((rand.Next() % 4) != 0) ? -1 : 0;
+    batch.noise_mask[i] = ((rand.Next() % 8) == 0) ? -1 : 0;
+    batch.reverb_mask[i] = (rand.Next() & 1) ? -1 : 0;
+  }
+}
+
+TEST(SPUDSP, MixVoiceBatch)
+{
+  TestRandom rand;
+  for (u32 iter = 0; iter < 100000; iter++)
+  {
+    VoiceMixBatch scalar_batch;
+    FillBatch(scalar_batch, rand);
+    VoiceMixBatch vector_batch = scalar_batch;
+
+    const s16 noise_level = rand.NextS16();
+    const VoiceMixSums scalar_sums = MixVoices_Scalar(scalar_batch, noise_level);
+    const VoiceMixSums vector_sums = SPU::DSP::MixVoiceBatch(vector_batch, noise_level);
+    ASSERT_EQ(std::memcmp(scalar_batch.volume, vector_batch.volume, sizeof(scalar_batch.volume)), 0);
+    ASSERT_EQ(std::memcmp(scalar_batch.left, vector_batch.left, sizeof(scalar_batch.left)), 0);
+    ASSERT_EQ(std::memcmp(scalar_batch.right, vector_batch.right, sizeof(scalar_batch.right)), 0);
+    ASSERT_EQ(scalar_sums.left, vector_sums.left);
+    ASSERT_EQ(scalar_sums.right, vector_sums.right);
+    ASSERT_EQ(scalar_sums.reverb_left, vector_sums.reverb_left);
+    ASSERT_EQ(scalar_sums.reverb_right, vector_sums.reverb_right);
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(SPUDSP, DISABLED_BenchmarkMixVoiceBatch)
+{
+  static constexpr u32 NUM_BATCHES = 64;
+  static constexpr u32 NUM_ITERATIONS = 44100 * 60 / NUM_BATCHES;
+
+  TestRandom rand;
+  std::vector<VoiceMixBatch> batches(NUM_BATCHES);
+  for (VoiceMixBatch& batch : batches)
+    FillBatch(batch, rand);
+
+  s32 checksum = 0;
+  Timer timer;
+  for (u32 iter = 0; iter < NUM_ITERATIONS; iter++)
+  {
+    for (VoiceMixBatch& batch : batches)
+      checksum += MixVoices_Scalar(batch, static_cast<s16>(iter)).left;
+  }
+  const double scalar_ms = timer.GetTimeMilliseconds();
+
+  timer.Reset();
+  for (u32 iter = 0; iter < NUM_ITERATIONS; iter++)
+  {
+    for (VoiceMixBatch& batch : batches)
+      checksum -= SPU::DSP::MixVoiceBatch(batch, static_cast<s16>(iter)).left;
+  }
+  const double vector_ms = timer.GetTimeMilliseconds();
+
+  EXPECT_EQ(checksum, 0);
+  std::printf("60 seconds of 24 voices\nScalar: %.3f ms\nVector: %.3f ms\n", scalar_ms, vector_ms);
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "common/types.h"
+
+// Simple LCG, so the inputs to each test are reproducible.
+struct TestRandom
+{
+  u32 seed = 12345;
+
+  u32 Next()
+  {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+  }
+
+  s16 NextS16() { return static_cast<s16>(static_cast<u16>(Next())); }
+};
@@ -1373,6 +1373,27 @@ void Bus::RAMWriteHandler(VirtualMemoryAddress address, u32 value)
 {
   const u32 offset = address & g_ram_mask;
 
+  // Check code pages ourselves instead of faulting, so writes next to code don't throw out the whole page.
+  if (g_settings.cpu_recompiler_subpage_invalidation && g_ram_code_bits[offset >> HOST_PAGE_SHIFT]) [[unlikely]]
+  {
+    if constexpr (size == MemoryAccessSize::Byte)
+    {
+      g_unprotected_ram[offset] = Truncate8(value);
+    }
+    else if constexpr (size == MemoryAccessSize::HalfWord)
+    {
+      const u16 temp = Truncate16(value);
+      std::memcpy(&g_unprotected_ram[offset], &temp, sizeof(u16));
+    }
+    else if constexpr (size == MemoryAccessSize::Word)
+    {
+      std::memcpy(&g_unprotected_ram[offset], &value, sizeof(u32));
+    }
+
+    CPU::CodeCache::InvalidateBlocksForRAMWrite(offset, static_cast<u32>(1u << static_cast<u32>(size)));
+    return;
+  }
+
   if constexpr (size == MemoryAccessSize::Byte)
   {
     g_ram[offset] = Truncate8(value);
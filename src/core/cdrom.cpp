@@ -3,6 +3,7 @@
 
 #include "cdrom.h"
 #include "cdrom_async_reader.h"
+#include "cdrom_dsp.h"
 #include "cdrom_subq_replacement.h"
 #include "dma.h"
 #include "fullscreenui.h"
@@ -56,7 +57,6 @@ enum : u32
   SUBQ_SECTOR_SKEW = 2,
   XA_ADPCM_SAMPLES_PER_SECTOR_4BIT = 4032, // 28 words * 8 nibbles per word * 18 chunks
   XA_ADPCM_SAMPLES_PER_SECTOR_8BIT = 2016, // 28 words * 4 bytes per word * 18 chunks
-  XA_RESAMPLE_RING_BUFFER_SIZE = 32,
   XA_RESAMPLE_ZIGZAG_TABLE_SIZE = 29,
   XA_RESAMPLE_NUM_ZIGZAG_TABLES = 7,
   PRNG_SEED = 0x4B435544u,
@@ -273,24 +273,6 @@ struct XASubHeader
   } codinginfo;
 };
 
-union XA_ADPCMBlockHeader
-{
-  u8 bits;
-
-  BitField<u8, u8, 0, 4> shift;
-  BitField<u8, u8, 4, 4> filter;
-
-  // For both 4bit and 8bit ADPCM, reserved shift values 13..15 will act same as shift=9).
-  u8 GetShift() const
-  {
-    const u8 shift_value = shift;
-    return (shift_value > 12) ? 9 : shift_value;
-  }
-
-  u8 GetFilter() const { return filter; }
-};
-static_assert(sizeof(XA_ADPCMBlockHeader) == 1, "XA-ADPCM block header is one byte");
-
 } // namespace
 
 static TickCount SoftReset(TickCount ticks_late);
@@ -465,9 +447,7 @@ struct CDROMState
   std::array<std::array<u8, 2>, 2> next_cd_audio_volume_matrix{};
 
   std::array<s32, 4> xa_last_samples{};
-  std::array<std::array<s16, XA_RESAMPLE_RING_BUFFER_SIZE>, 2> xa_resample_ring_buffer{};
-  u8 xa_resample_p = 0;
-  u8 xa_resample_sixstep = 6;
+  DSP::XAResampleState xa_resample;
 
   InlineFIFOQueue<u8, PARAM_FIFO_SIZE> param_fifo;
   InlineFIFOQueue<u8, RESPONSE_FIFO_SIZE> response_fifo;
@@ -769,9 +749,9 @@ bool CDROM::DoState(StateWrapper& sw)
   sw.Do(&s_state.cd_audio_volume_matrix);
   sw.Do(&s_state.next_cd_audio_volume_matrix);
   sw.Do(&s_state.xa_last_samples);
-  sw.Do(&s_state.xa_resample_ring_buffer);
-  sw.Do(&s_state.xa_resample_p);
-  sw.Do(&s_state.xa_resample_sixstep);
+  sw.Do(&s_state.xa_resample.ring_buffer);
+  sw.Do(&s_state.xa_resample.p);
+  sw.Do(&s_state.xa_resample.sixstep);
   sw.Do(&s_state.param_fifo);
   sw.Do(&s_state.response_fifo);
   sw.Do(&s_state.async_response_fifo);
@@ -956,6 +936,9 @@ bool CDROM::InsertMedia(std::unique_ptr<CDImage>& media, DiscRegion region, std:
 
   s_state.subq_replacement = std::move(subq);
   s_state.disc_region = region;
+  media->SetDecompressionCache(g_settings.cdrom_decompression_cache_blocks,
+                               g_settings.cdrom_decompression_prefetch_blocks);
+  media->SetMemoryMapping(g_settings.cdrom_memory_map_images);
   s_reader.SetMedia(std::move(media));
   SetHoldPosition(0, 0);
 
@@ -1071,6 +1054,16 @@ void CDROM::SetReadaheadSectors(u32 readahead_sectors)
     s_reader.QueueReadSector(s_state.requested_lba);
 }
 
+void CDROM::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+  s_reader.SetDecompressionCache(cache_blocks, prefetch_blocks);
+}
+
+void CDROM::SetMemoryMapping(bool enabled)
+{
+  s_reader.SetMemoryMapping(enabled);
+}
+
 void CDROM::CPUClockChanged()
 {
   // reschedule the disc read event
@@ -3546,190 +3539,19 @@ s16 CDROM::SaturateVolume(s32 volume)
 template<bool IS_STEREO, bool IS_8BIT>
 void CDROM::DecodeXAADPCMChunks(const u8* chunk_ptr, s16* samples)
 {
-  static constexpr std::array<s8, 16> filter_table_pos = {{0, 60, 115, 98, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
-  static constexpr std::array<s8, 16> filter_table_neg = {{0, 0, -52, -55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
-
-  // The data layout is annoying here. Each word of data is interleaved with the other blocks, requiring multiple
-  // passes to decode the whole chunk.
-  constexpr u32 NUM_CHUNKS = 18;
-  constexpr u32 CHUNK_SIZE_IN_BYTES = 128;
-  constexpr u32 WORDS_PER_CHUNK = 28;
-  constexpr u32 SAMPLES_PER_CHUNK = WORDS_PER_CHUNK * (IS_8BIT ? 4 : 8);
-  constexpr u32 NUM_BLOCKS = IS_8BIT ? 4 : 8;
-  constexpr u32 WORDS_PER_BLOCK = 28;
-
-  for (u32 i = 0; i < NUM_CHUNKS; i++)
-  {
-    const u8* headers_ptr = chunk_ptr + 4;
-    const u8* words_ptr = chunk_ptr + 16;
-
-    for (u32 block = 0; block < NUM_BLOCKS; block++)
-    {
-      const XA_ADPCMBlockHeader block_header{headers_ptr[block]};
-      const u8 shift = block_header.GetShift();
-      const u8 filter = block_header.GetFilter();
-      const s32 filter_pos = filter_table_pos[filter];
-      const s32 filter_neg = filter_table_neg[filter];
-
-      s16* out_samples_ptr =
-        IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
-      constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
-
-      for (u32 word = 0; word < 28; word++)
-      {
-        // NOTE: assumes LE
-        u32 word_data;
-        std::memcpy(&word_data, &words_ptr[word * sizeof(u32)], sizeof(word_data));
-
-        // extract nibble from block
-        const u32 nibble = IS_8BIT ? ((word_data >> (block * 8)) & 0xFF) : ((word_data >> (block * 4)) & 0x0F);
-        const s16 sample = static_cast<s16>(Truncate16(nibble << (IS_8BIT ? 8 : 12))) >> shift;
-
-        // mix in previous values
-        s32* prev = IS_STEREO ? &s_state.xa_last_samples[(block & 1) * 2] : &s_state.xa_last_samples[0];
-        const s32 interp_sample = std::clamp<s32>(
-          static_cast<s32>(sample) + ((prev[0] * filter_pos) >> 6) + ((prev[1] * filter_neg) >> 6), -32768, 32767);
-
-        // update previous values
-        prev[1] = prev[0];
-        prev[0] = interp_sample;
-
-        *out_samples_ptr = static_cast<s16>(interp_sample);
-        out_samples_ptr += out_samples_increment;
-      }
-    }
-
-    samples += SAMPLES_PER_CHUNK;
-    chunk_ptr += CHUNK_SIZE_IN_BYTES;
-  }
+  DSP::DecodeXAADPCMChunks<IS_STEREO, IS_8BIT>(chunk_ptr, samples, &s_state.xa_last_samples);
 }
 
 template<bool STEREO>
 void CDROM::ResampleXAADPCM(const s16* frames_in, u32 num_frames_in)
 {
-  static constexpr auto zigzag_interpolate = [](const s16* ringbuf, u32 table_index, u32 p) -> s16 {
-    static std::array<std::array<s16, 29>, 7> tables = {
-      {{0,      0x0,     0x0,     0x0,    0x0,     -0x0002, 0x000A,  -0x0022, 0x0041, -0x0054,
-        0x0034, 0x0009,  -0x010A, 0x0400, -0x0A78, 0x234C,  0x6794,  -0x1780, 0x0BCD, -0x0623,
-        0x0350, -0x016D, 0x006B,  0x000A, -0x0010, 0x0011,  -0x0008, 0x0003,  -0x0001},
-       {0,       0x0,    0x0,     -0x0002, 0x0,    0x0003,  -0x0013, 0x003C,  -0x004B, 0x00A2,
-        -0x00E3, 0x0132, -0x0043, -0x0267, 0x0C9D, 0x74BB,  -0x11B4, 0x09B8,  -0x05BF, 0x0372,
-        -0x01A8, 0x00A6, -0x001B, 0x0005,  0x0006, -0x0008, 0x0003,  -0x0001, 0x0},
-       {0,      0x0,     -0x0001, 0x0003,  -0x0002, -0x0005, 0x001F,  -0x004A, 0x00B3, -0x0192,
-        0x02B1, -0x039E, 0x04F8,  -0x05A6, 0x7939,  -0x05A6, 0x04F8,  -0x039E, 0x02B1, -0x0192,
-        0x00B3, -0x004A, 0x001F,  -0x0005, -0x0002, 0x0003,  -0x0001, 0x0,     0x0},
-       {0,       -0x0001, 0x0003,  -0x0008, 0x0006, 0x0005,  -0x001B, 0x00A6, -0x01A8, 0x0372,
-        -0x05BF, 0x09B8,  -0x11B4, 0x74BB,  0x0C9D, -0x0267, -0x0043, 0x0132, -0x00E3, 0x00A2,
-        -0x004B, 0x003C,  -0x0013, 0x0003,  0x0,    -0x0002, 0x0,     0x0,    0x0},
-       {-0x0001, 0x0003,  -0x0008, 0x0011,  -0x0010, 0x000A, 0x006B,  -0x016D, 0x0350, -0x0623,
-        0x0BCD,  -0x1780, 0x6794,  0x234C,  -0x0A78, 0x0400, -0x010A, 0x0009,  0x0034, -0x0054,
-        0x0041,  -0x0022, 0x000A,  -0x0001, 0x0,     0x0001, 0x0,     0x0,     0x0},
-       {0x0002,  -0x0008, 0x0010,  -0x0023, 0x002B, 0x001A,  -0x00EB, 0x027B,  -0x0548, 0x0AFA,
-        -0x16FA, 0x53E0,  0x3C07,  -0x1249, 0x080E, -0x0347, 0x015B,  -0x0044, -0x0017, 0x0046,
-        -0x0023, 0x0011,  -0x0005, 0x0,     0x0,    0x0,     0x0,     0x0,     0x0},
-       {-0x0005, 0x0011,  -0x0023, 0x0046, -0x0017, -0x0044, 0x015B,  -0x0347, 0x080E, -0x1249,
-        0x3C07,  0x53E0,  -0x16FA, 0x0AFA, -0x0548, 0x027B,  -0x00EB, 0x001A,  0x002B, -0x0023,
-        0x0010,  -0x0008, 0x0002,  0x0,    0x0,     0x0,     0x0,     0x0,     0x0}}};
-
-    const s16* table = tables[table_index].data();
-    s32 sum = 0;
-    for (u32 i = 0; i < 29; i++)
-      sum += (static_cast<s32>(ringbuf[(p - i) & 0x1F]) * static_cast<s32>(table[i])) >> 15;
-
-    return static_cast<s16>(std::clamp<s32>(sum, -0x8000, 0x7FFF));
-  };
-
-  s16* const left_ringbuf = s_state.xa_resample_ring_buffer[0].data();
-  [[maybe_unused]] s16* const right_ringbuf = s_state.xa_resample_ring_buffer[1].data();
-  u32 p = s_state.xa_resample_p;
-  u32 sixstep = s_state.xa_resample_sixstep;
-
-  for (u32 in_sample_index = 0; in_sample_index < num_frames_in; in_sample_index++)
-  {
-    // TODO: We can vectorize the multiplications in zigzag_interpolate by duplicating the sample in the ringbuffer at
-    // offset +32, allowing it to wrap once.
-    left_ringbuf[p] = *(frames_in++);
-    if constexpr (STEREO)
-      right_ringbuf[p] = *(frames_in++);
-    p = (p + 1) % 32;
-    sixstep--;
-
-    if (sixstep == 0)
-    {
-      sixstep = 6;
-      for (u32 j = 0; j < 7; j++)
-      {
-        const s16 left_interp = zigzag_interpolate(left_ringbuf, j, p);
-        const s16 right_interp = STEREO ? zigzag_interpolate(right_ringbuf, j, p) : left_interp;
-        AddCDAudioFrame(left_interp, right_interp);
-      }
-    }
-  }
-
-  s_state.xa_resample_p = Truncate8(p);
-  s_state.xa_resample_sixstep = Truncate8(sixstep);
+  DSP::ResampleXAADPCM<STEREO>(&s_state.xa_resample, frames_in, num_frames_in, &AddCDAudioFrame);
 }
 
 template<bool STEREO>
 void CDROM::ResampleXAADPCM18900(const s16* frames_in, u32 num_frames_in)
 {
-  // Weights originally from Mednafen's interpolator. It's unclear where these came from, perhaps it was calculated
-  // somehow. This doesn't appear to use a zigzag pattern like psx-spx suggests, therefore it is restricted to only
-  // 18900hz resampling. Duplicating the 18900hz samples to 37800hz sounds even more awful than lower sample rate audio
-  // should, with a big spike at ~16KHz, especially with music in FMVs. Fortunately, few games actually use 18900hz XA.
-  static constexpr auto interpolate = [](const s16* ringbuf, u32 table_index, u32 p) -> s16 {
-    static std::array<std::array<s16, 25>, 7> tables = {{
-      {{0x0,     -0x5,  0x11,   -0x23, 0x46,  -0x17, -0x44, 0x15b, -0x347, 0x80e, -0x1249, 0x3c07, 0x53e0,
-        -0x16fa, 0xafa, -0x548, 0x27b, -0xeb, 0x1a,  0x2b,  -0x23, 0x10,   -0x8,  0x2,     0x0}},
-      {{0x0,     -0x2,  0xa,    -0x22, 0x41,   -0x54, 0x34, 0x9,   -0x10a, 0x400, -0xa78, 0x234c, 0x6794,
-        -0x1780, 0xbcd, -0x623, 0x350, -0x16d, 0x6b,  0xa,  -0x10, 0x11,   -0x8,  0x3,    -0x1}},
-      {{-0x2,    0x0,   0x3,    -0x13, 0x3c,   -0x4b, 0xa2,  -0xe3, 0x132, -0x43, -0x267, 0xc9d, 0x74bb,
-        -0x11b4, 0x9b8, -0x5bf, 0x372, -0x1a8, 0xa6,  -0x1b, 0x5,   0x6,   -0x8,  0x3,    -0x1}},
-      {{-0x1,   0x3,   -0x2,   -0x5,  0x1f,   -0x4a, 0xb3,  -0x192, 0x2b1, -0x39e, 0x4f8, -0x5a6, 0x7939,
-        -0x5a6, 0x4f8, -0x39e, 0x2b1, -0x192, 0xb3,  -0x4a, 0x1f,   -0x5,  -0x2,   0x3,   -0x1}},
-      {{-0x1,  0x3,    -0x8,  0x6,   0x5,   -0x1b, 0xa6,  -0x1a8, 0x372, -0x5bf, 0x9b8, -0x11b4, 0x74bb,
-        0xc9d, -0x267, -0x43, 0x132, -0xe3, 0xa2,  -0x4b, 0x3c,   -0x13, 0x3,    0x0,   -0x2}},
-      {{-0x1,   0x3,    -0x8,  0x11,   -0x10, 0xa,  0x6b,  -0x16d, 0x350, -0x623, 0xbcd, -0x1780, 0x6794,
-        0x234c, -0xa78, 0x400, -0x10a, 0x9,   0x34, -0x54, 0x41,   -0x22, 0xa,    -0x2,  0x0}},
-      {{0x0,    0x2,     -0x8,  0x10,   -0x23, 0x2b,  0x1a,  -0xeb, 0x27b, -0x548, 0xafa, -0x16fa, 0x53e0,
-        0x3c07, -0x1249, 0x80e, -0x347, 0x15b, -0x44, -0x17, 0x46,  -0x23, 0x11,   -0x5,  0x0}},
-    }};
-
-    const s16* table = tables[table_index].data();
-    s32 sum = 0;
-    for (u32 i = 0; i < 25; i++)
-      sum += (static_cast<s32>(ringbuf[(p + 32 - 25 + i) & 0x1F]) * static_cast<s32>(table[i]));
-
-    return static_cast<s16>(std::clamp<s32>(sum >> 15, -0x8000, 0x7FFF));
-  };
-
-  s16* const left_ringbuf = s_state.xa_resample_ring_buffer[0].data();
-  [[maybe_unused]] s16* const right_ringbuf = s_state.xa_resample_ring_buffer[1].data();
-  u32 p = s_state.xa_resample_p;
-  u32 sixstep = s_state.xa_resample_sixstep;
-
-  for (u32 in_sample_index = 0; in_sample_index < num_frames_in;)
-  {
-    if (sixstep >= 7)
-    {
-      sixstep -= 7;
-      p = (p + 1) % 32;
-
-      left_ringbuf[p] = *(frames_in++);
-      if constexpr (STEREO)
-        right_ringbuf[p] = *(frames_in++);
-
-      in_sample_index++;
-    }
-
-    const s16 left_interp = interpolate(left_ringbuf, sixstep, p);
-    const s16 right_interp = STEREO ? interpolate(right_ringbuf, sixstep, p) : left_interp;
-    AddCDAudioFrame(left_interp, right_interp);
-    sixstep += 3;
-  }
-
-  s_state.xa_resample_p = Truncate8(p);
-  s_state.xa_resample_sixstep = Truncate8(sixstep);
+  DSP::ResampleXAADPCM18900<STEREO>(&s_state.xa_resample, frames_in, num_frames_in, &AddCDAudioFrame);
 }
 
 void CDROM::ResetCurrentXAFile()
@@ -3748,9 +3570,9 @@ void CDROM::ResetAudioDecoder()
   s_state.xa_last_samples.fill(0);
   for (u32 i = 0; i < 2; i++)
   {
-    s_state.xa_resample_ring_buffer[i].fill(0);
-    s_state.xa_resample_p = 0;
-    s_state.xa_resample_sixstep = 6;
+    s_state.xa_resample.ring_buffer[i].fill(0);
+    s_state.xa_resample.p = 0;
+    s_state.xa_resample.sixstep = 6;
   }
   s_state.audio_fifo.Clear();
 }
@@ -4131,6 +3953,14 @@ void CDROM::DrawDebugWindow(float scale)
                   s_state.last_sector_header.second, s_state.last_sector_header.frame,
                   s_state.last_sector_header.sector_mode);
 
+      if (s_reader.IsUsingThread())
+      {
+        const CDROMAsyncReader::Stats& stats = s_reader.GetStats();
+        ImGui::Text("Readahead: %u/%u sectors, %u hits, %u recent hits, %u misses, %u stalls (%.2f ms)",
+                    s_reader.GetReadaheadTarget(), s_reader.GetReadaheadCount(), stats.readahead_hits,
+                    stats.recent_hits, stats.misses, stats.stalls, stats.stall_time_ms);
+      }
+
       if (s_state.show_current_file)
       {
         if (media->GetTrackNumber() == 1)
@@ -47,6 +47,8 @@ void DMARead(u32* words, u32 word_count);
 void DrawDebugWindow(float scale);
 
 void SetReadaheadSectors(u32 readahead_sectors);
+void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks);
+void SetMemoryMapping(bool enabled);
 void DisableReadSpeedup();
 
 /// Reads a frame from the audio FIFO, used by the SPU.
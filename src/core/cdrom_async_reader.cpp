@@ -5,6 +5,9 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/timer.h"
+
+#include <algorithm>
+
 LOG_CHANNEL(CDROMAsyncReader);
 
 CDROMAsyncReader::CDROMAsyncReader() = default;
@@ -22,6 +25,9 @@ void CDROMAsyncReader::StartThread(u32 readahead_count)
   m_buffers.clear();
   m_buffers.resize(readahead_count);
   EmptyBuffers();
+  ClearRecentSectors();
+  m_readahead_target.store(readahead_count);
+  m_sequential_hits = 0;
 
   m_shutdown_flag.store(false);
   m_read_thread = std::thread(&CDROMAsyncReader::WorkerThreadEntryPoint, this);
@@ -42,6 +48,8 @@ void CDROMAsyncReader::StopThread()
   m_read_thread.join();
   EmptyBuffers();
   m_buffers.clear();
+  ClearRecentSectors();
+  m_recent_sectors.clear();
 }
 
 void CDROMAsyncReader::SetMedia(std::unique_ptr<CDImage> media)
@@ -49,6 +57,8 @@ void CDROMAsyncReader::SetMedia(std::unique_ptr<CDImage> media)
   if (IsUsingThread())
     CancelReadahead();
 
+  ClearRecentSectors();
+  ResetStats();
   m_media = std::move(media);
 }
 
@@ -57,9 +67,83 @@ std::unique_ptr<CDImage> CDROMAsyncReader::RemoveMedia()
   if (IsUsingThread())
     CancelReadahead();
 
+  ClearRecentSectors();
   return std::move(m_media);
 }
 
+void CDROMAsyncReader::ResetStats()
+{
+  m_stats = {};
+}
+
+void CDROMAsyncReader::AddRecentSector(const BufferSlot& slot)
+{
+  if (!slot.result)
+    return;
+
+  // replace in place if we already have it, otherwise overwrite the oldest
+  for (BufferSlot& recent : m_recent_sectors)
+  {
+    if (recent.result && recent.lba == slot.lba)
+    {
+      recent = slot;
+      return;
+    }
+  }
+
+  m_recent_sectors[m_recent_sector_next] = slot;
+  m_recent_sector_next = (m_recent_sector_next + 1) % RECENT_SECTOR_COUNT;
+}
+
+const CDROMAsyncReader::BufferSlot* CDROMAsyncReader::FindRecentSector(CDImage::LBA lba) const
+{
+  for (const BufferSlot& recent : m_recent_sectors)
+  {
+    if (recent.result && recent.lba == lba)
+      return &recent;
+  }
+
+  return nullptr;
+}
+
+void CDROMAsyncReader::ClearRecentSectors()
+{
+  m_recent_sectors.resize(RECENT_SECTOR_COUNT);
+  for (BufferSlot& recent : m_recent_sectors)
+    recent.result = false;
+  m_recent_sector_next = 0;
+  m_recent_front = nullptr;
+}
+
+void CDROMAsyncReader::UpdateReadaheadTarget(bool sequential)
+{
+  const u32 max_target = static_cast<u32>(m_buffers.size());
+  const u32 min_target = std::min(MIN_READAHEAD_TARGET, max_target);
+  const u32 old_target = m_readahead_target.load();
+  u32 new_target = old_target;
+  if (sequential)
+  {
+    // streaming, ramp up once the current depth has been consumed in order
+    if (++m_sequential_hits >= old_target)
+    {
+      new_target = std::min(old_target * 2, max_target);
+      m_sequential_hits = 0;
+    }
+  }
+  else
+  {
+    // seeking around, reading far ahead just delays the next seek
+    new_target = std::max(old_target / 2, min_target);
+    m_sequential_hits = 0;
+  }
+
+  if (new_target != old_target)
+  {
+    DEBUG_LOG("Readahead target changed from {} to {} sectors", old_target, new_target);
+    m_readahead_target.store(new_target);
+  }
+}
+
 bool CDROMAsyncReader::Precache(ProgressCallback* callback, Error* error)
 {
   WaitForIdle();
@@ -97,6 +181,24 @@ bool CDROMAsyncReader::Precache(ProgressCallback* callback, Error* error)
   return (res == CDImage::PrecacheResult::Success);
 }
 
+void CDROMAsyncReader::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+  WaitForIdle();
+
+  std::unique_lock lock(m_mutex);
+  if (m_media)
+    m_media->SetDecompressionCache(cache_blocks, prefetch_blocks);
+}
+
+void CDROMAsyncReader::SetMemoryMapping(bool enabled)
+{
+  WaitForIdle();
+
+  std::unique_lock lock(m_mutex);
+  if (m_media)
+    m_media->SetMemoryMapping(enabled);
+}
+
 void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
 {
   if (!IsUsingThread())
@@ -105,6 +207,25 @@ void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
     return;
   }
 
+  m_recent_front = nullptr;
+
+  // still waiting for the thread to pick up the last seek? retarget it instead
+  if (m_next_position_set.load())
+  {
+    std::unique_lock lock(m_mutex);
+    if (m_next_position_set.load())
+    {
+      if (m_next_position.load() != lba)
+      {
+        DEBUG_LOG("Seek still pending, retargeting to {}", lba);
+        m_next_position = lba;
+        m_stats.misses++;
+      }
+
+      return;
+    }
+  }
+
   const u32 buffer_count = m_buffer_count.load();
   if (buffer_count > 0)
   {
@@ -123,17 +244,62 @@ void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
     {
       // great, don't need a seek, but still kick the thread to start reading ahead again
       DEBUG_LOG("Readahead buffer hit for sector {}", lba);
+      AddRecentSector(m_buffers[buffer_front]);
       m_buffer_front.store(next_buffer);
       m_buffer_count.fetch_sub(1);
+      m_stats.readahead_hits++;
+      UpdateReadaheadTarget(true);
       m_can_readahead.store(true);
       m_do_read_cv.notify_one();
       return;
     }
   }
 
+  std::unique_lock lock(m_mutex);
+
+  // Is the thread in the middle of reading the sector we want? Happens when storage can't keep up with streaming,
+  // and seeking would throw away the read that's almost done. The slot's LBA is only written with the lock held.
+  if (buffer_count == 1 && m_buffer_count.load() == 1 && m_is_reading.load())
+  {
+    const u32 buffer_front = m_buffer_front.load();
+    const u32 next_buffer = (buffer_front + 1) % static_cast<u32>(m_buffers.size());
+    if (next_buffer == ((m_buffer_back.load() + static_cast<u32>(m_buffers.size()) - 1) %
+                        static_cast<u32>(m_buffers.size())) &&
+        m_buffers[next_buffer].lba == lba)
+    {
+      DEBUG_LOG("Readahead in progress for sector {}", lba);
+      AddRecentSector(m_buffers[buffer_front]);
+      m_buffer_front.store(next_buffer);
+      m_buffer_count.fetch_sub(1);
+      m_stats.readahead_hits++;
+      UpdateReadaheadTarget(true);
+      return;
+    }
+  }
+
+  // Hang on to what's been read so far before it gets thrown away, games often seek back to the sector they just
+  // read, or skip forward a few sectors. Complete slots aren't touched by the thread, only the back one is.
+  const u32 buffer_front = m_buffer_front.load();
+  const u32 keep_count = std::min(m_buffer_count.load(), RECENT_SECTOR_COUNT / 2);
+  for (u32 i = 0; i < keep_count; i++)
+    AddRecentSector(m_buffers[(buffer_front + i) % static_cast<u32>(m_buffers.size())]);
+
+  if (const BufferSlot* recent = FindRecentSector(lba))
+  {
+    // no need to wait for the thread, start reading ahead from the following sector
+    DEBUG_LOG("Recent sector hit for {}, queueing seek to {}", lba, lba + 1);
+    m_recent_front = recent;
+    m_stats.recent_hits++;
+    m_next_position_set.store(true);
+    m_next_position = lba + 1;
+    m_do_read_cv.notify_one();
+    return;
+  }
+
   // we need to toss away our readahead and start fresh
   DEBUG_LOG("Readahead buffer miss, queueing seek to {}", lba);
-  std::unique_lock lock(m_mutex);
+  m_stats.misses++;
+  UpdateReadaheadTarget(false);
   m_next_position_set.store(true);
   m_next_position = lba;
   m_do_read_cv.notify_one();
@@ -180,6 +346,9 @@ bool CDROMAsyncReader::InternalReadSectorUncached(CDImage::LBA lba, CDImage::Sub
 
 bool CDROMAsyncReader::WaitForReadToComplete()
 {
+  if (m_recent_front)
+    return m_recent_front->result;
+
   // Safe without locking with memory_order_seq_cst.
   if (!m_next_position_set.load() && m_buffer_count.load() > 0)
   {
@@ -201,6 +370,8 @@ bool CDROMAsyncReader::WaitForReadToComplete()
 
   const u32 front = m_buffer_front.load();
   const double wait_time = wait_timer.GetTimeMilliseconds();
+  m_stats.stalls++;
+  m_stats.stall_time_ms += static_cast<float>(wait_time);
   if (wait_time > 1.0f) [[unlikely]]
     WARNING_LOG("Had to wait {:.2f} msec for LBA {}", wait_time, m_buffers[front].lba);
 
@@ -357,9 +528,9 @@ void CDROMAsyncReader::WorkerThreadEntryPoint()
       if (!m_can_readahead.load())
         break;
 
-      // readahead time! read as many sectors as we have space for
-      DEBUG_LOG("Reading ahead {} sectors...", static_cast<u32>(m_buffers.size()) - m_buffer_count.load());
-      while (m_buffer_count.load() < static_cast<u32>(m_buffers.size()))
+      // readahead time! read up to the current target, which is never more than we have space for
+      DEBUG_LOG("Reading ahead up to {} sectors...", m_readahead_target.load());
+      while (m_buffer_count.load() < m_readahead_target.load())
       {
         if (m_next_position_set.load())
         {
@@ -24,16 +24,31 @@ public:
     bool result;
   };
 
+  struct Stats
+  {
+    u32 readahead_hits;
+    u32 recent_hits;
+    u32 misses;
+    u32 stalls;
+    float stall_time_ms;
+  };
+
   CDROMAsyncReader();
   ~CDROMAsyncReader();
 
-  CDImage::LBA GetLastReadSector() const { return m_buffers[m_buffer_front.load()].lba; }
-  const SectorBuffer& GetSectorBuffer() const { return m_buffers[m_buffer_front.load()].data; }
-  const CDImage::SubChannelQ& GetSectorSubQ() const { return m_buffers[m_buffer_front.load()].subq; }
+  CDImage::LBA GetLastReadSector() const { return GetFrontSlot().lba; }
+  const SectorBuffer& GetSectorBuffer() const { return GetFrontSlot().data; }
+  const CDImage::SubChannelQ& GetSectorSubQ() const { return GetFrontSlot().subq; }
   u32 GetBufferedSectorCount() const { return m_buffer_count.load(); }
   bool HasBufferedSectors() const { return (m_buffer_count.load() > 0); }
   u32 GetReadaheadCount() const { return static_cast<u32>(m_buffers.size()); }
 
+  /// Number of sectors currently being read ahead, which adapts to the access pattern up to the readahead count.
+  u32 GetReadaheadTarget() const { return m_readahead_target.load(); }
+
+  const Stats& GetStats() const { return m_stats; }
+  void ResetStats();
+
   bool HasMedia() const { return static_cast<bool>(m_media); }
   const CDImage* GetMedia() const { return m_media.get(); }
   CDImage* GetMedia() { return m_media.get(); }
@@ -49,6 +64,12 @@ public:
   /// Precaches image, either to memory, or using the underlying image precache.
   bool Precache(ProgressCallback* callback, Error* error);
 
+  /// Changes the decompressed block cache of the image, waiting for any in-progress read.
+  void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks);
+
+  /// Changes whether the image is read through a memory mapping, waiting for any in-progress read.
+  void SetMemoryMapping(bool enabled);
+
   void QueueReadSector(CDImage::LBA lba);
 
   bool WaitForReadToComplete();
@@ -58,6 +79,16 @@ public:
   bool ReadSectorUncached(CDImage::LBA lba, CDImage::SubChannelQ* subq, SectorBuffer* data);
 
 private:
+  static constexpr u32 RECENT_SECTOR_COUNT = 32;
+  static constexpr u32 MIN_READAHEAD_TARGET = 2;
+
+  const BufferSlot& GetFrontSlot() const { return m_recent_front ? *m_recent_front : m_buffers[m_buffer_front.load()]; }
+
+  void AddRecentSector(const BufferSlot& slot);
+  const BufferSlot* FindRecentSector(CDImage::LBA lba) const;
+  void ClearRecentSectors();
+  void UpdateReadaheadTarget(bool sequential);
+
   void EmptyBuffers();
   bool ReadSectorIntoBuffer(std::unique_lock<std::mutex>& lock);
   void ReadSectorNonThreaded(CDImage::LBA lba);
@@ -85,4 +116,13 @@ private:
   std::atomic<u32> m_buffer_front{0};
   std::atomic<u32> m_buffer_back{0};
   std::atomic<u32> m_buffer_count{0};
+  std::atomic<u32> m_readahead_target{0};
+  u32 m_sequential_hits = 0;
+
+  // Sectors which were read recently, so short seeks don't have to go back to the image. Only used by the caller.
+  std::vector<BufferSlot> m_recent_sectors;
+  u32 m_recent_sector_next = 0;
+  const BufferSlot* m_recent_front = nullptr;
+
+  Stats m_stats = {};
 };
@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "common/bitfield.h"
+#include "common/bitutils.h"
+#include "common/gsvector.h"
+#include "common/types.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// XA-ADPCM decoding and resampling stages of the CD-ROM controller that don't touch its state, so they can be tested
+// on their own.
+namespace CDROM::DSP {
+
+inline constexpr u32 XA_RESAMPLE_RING_BUFFER_SIZE = 32;
+
+union XA_ADPCMBlockHeader
+{
+  u8 bits;
+
+  BitField<u8, u8, 0, 4> shift;
+  BitField<u8, u8, 4, 4> filter;
+
+  // For both 4bit and 8bit ADPCM, reserved shift values 13..15 will act same as shift=9).
+  u8 GetShift() const
+  {
+    const u8 shift_value = shift;
+    return (shift_value > 12) ? 9 : shift_value;
+  }
+
+  u8 GetFilter() const { return filter; }
+};
+static_assert(sizeof(XA_ADPCMBlockHeader) == 1, "XA-ADPCM block header is one byte");
+
+// Input history of the resampler, carried between sectors.
+struct XAResampleState
+{
+  std::array<std::array<s16, XA_RESAMPLE_RING_BUFFER_SIZE>, 2> ring_buffer{};
+  u8 p = 0;
+  u8 sixstep = 6;
+};
+
+// Decodes XA-ADPCM samples in an audio sector. Stereo samples are interleaved with left first.
+template<bool IS_STEREO, bool IS_8BIT>
+inline void DecodeXAADPCMChunks(const u8* chunk_ptr, s16* samples, std::array<s32, 4>* last_samples)
+{
+  static constexpr std::array<s8, 16> filter_table_pos = {{0, 60, 115, 98, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+  static constexpr std::array<s8, 16> filter_table_neg = {{0, 0, -52, -55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+
+  // The data layout is annoying here. Each word of data is interleaved with the other blocks, requiring multiple
+  // passes to decode the whole chunk.
+  constexpr u32 NUM_CHUNKS = 18;
+  constexpr u32 CHUNK_SIZE_IN_BYTES = 128;
+  constexpr u32 WORDS_PER_CHUNK = 28;
+  constexpr u32 SAMPLES_PER_CHUNK = WORDS_PER_CHUNK * (IS_8BIT ? 4 : 8);
+  constexpr u32 NUM_BLOCKS = IS_8BIT ? 4 : 8;
+  constexpr u32 WORDS_PER_BLOCK = 28;
+
+  for (u32 i = 0; i < NUM_CHUNKS; i++)
+  {
+    const u8* headers_ptr = chunk_ptr + 4;
+    const u8* words_ptr = chunk_ptr + 16;
+
+    for (u32 block = 0; block < NUM_BLOCKS; block++)
+    {
+      const XA_ADPCMBlockHeader block_header{headers_ptr[block]};
+      const u8 shift = block_header.GetShift();
+      const u8 filter = block_header.GetFilter();
+      const s32 filter_pos = filter_table_pos[filter];
+      const s32 filter_neg = filter_table_neg[filter];
+
+      // Extract the nibbles/bytes for this block from four words at a time. Moving the nibble to the top of the word
+      // and shifting it back down sign-extends it, and applies the block's shift at the same time.
+      // NOTE: assumes LE
+      alignas(VECTOR_ALIGNMENT) s32 block_samples[WORDS_PER_BLOCK];
+      const s32 extract_shift = IS_8BIT ? (24 - static_cast<s32>(block) * 8) : (28 - static_cast<s32>(block) * 4);
+      const GSVector4i extract_mask = GSVector4i::cxpr(IS_8BIT ? 0xFF000000u : 0xF0000000u);
+      for (u32 word = 0; word < WORDS_PER_BLOCK; word += 4)
+      {
+        const GSVector4i words = GSVector4i::load<false>(&words_ptr[word * sizeof(u32)]);
+        GSVector4i::store<true>(&block_samples[word],
+                                (words.sll32(extract_shift) & extract_mask).sra32(16 + static_cast<s32>(shift)));
+      }
+
+      s16* out_samples_ptr =
+        IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
+      constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
+
+      // mix in previous values, the filter is recursive so this part stays scalar
+      s32* prev = IS_STEREO ? &(*last_samples)[(block & 1) * 2] : &(*last_samples)[0];
+      s32 prev0 = prev[0];
+      s32 prev1 = prev[1];
+      for (u32 word = 0; word < WORDS_PER_BLOCK; word++)
+      {
+        const s32 interp_sample = std::clamp<s32>(
+          block_samples[word] + ((prev0 * filter_pos) >> 6) + ((prev1 * filter_neg) >> 6), -32768, 32767);
+        prev1 = prev0;
+        prev0 = interp_sample;
+
+        *out_samples_ptr = static_cast<s16>(interp_sample);
+        out_samples_ptr += out_samples_increment;
+      }
+
+      prev[0] = prev0;
+      prev[1] = prev1;
+    }
+
+    samples += SAMPLES_PER_CHUNK;
+    chunk_ptr += CHUNK_SIZE_IN_BYTES;
+  }
+}
+
+// Computes sum((window[i] * table[i]) >> 15) over 32 taps, rounding each product down like the scalar version. Each
+// shifted product fits in 16 bits, and is rebuilt from the high and low halves of the multiply.
+ALWAYS_INLINE s32 XAResampleSumShifted(const GSVector4i* window, const s16* table)
+{
+  GSVector4i sum = GSVector4i::zero();
+  for (u32 i = 0; i < 4; i++)
+  {
+    const GSVector4i weights = GSVector4i::load<true>(&table[i * 8]);
+    const GSVector4i lo = window[i].mul16l(weights);
+    const GSVector4i hi = window[i].mul16hs(weights);
+    sum = sum.add32((hi.sll16<1>() | lo.srl16<15>()).madd_s16(GSVector4i::cxpr16(1)));
+  }
+
+  return sum.addv_s32();
+}
+
+// Computes sum(window[i] * table[i]) over 32 taps.
+ALWAYS_INLINE s32 XAResampleSum(const GSVector4i* window, const s16* table)
+{
+  GSVector4i sum = GSVector4i::zero();
+  for (u32 i = 0; i < 4; i++)
+    sum = sum.add32(window[i].madd_s16(GSVector4i::load<true>(&table[i * 8])));
+
+  return sum.addv_s32();
+}
+
+// Resamples decoded frames to 44100hz, passing each output frame to add_frame.
+template<bool STEREO, typename F>
+inline void ResampleXAADPCM(XAResampleState* state, const s16* frames_in, u32 num_frames_in, const F& add_frame)
+{
+  static constexpr s16 zigzag_tables[7][29] = {
+    {0,      0x0,     0x0,     0x0,    0x0,     -0x0002, 0x000A,  -0x0022, 0x0041, -0x0054,
+     0x0034, 0x0009,  -0x010A, 0x0400, -0x0A78, 0x234C,  0x6794,  -0x1780, 0x0BCD, -0x0623,
+     0x0350, -0x016D, 0x006B,  0x000A, -0x0010, 0x0011,  -0x0008, 0x0003,  -0x0001},
+    {0,       0x0,    0x0,     -0x0002, 0x0,    0x0003,  -0x0013, 0x003C,  -0x004B, 0x00A2,
+     -0x00E3, 0x0132, -0x0043, -0x0267, 0x0C9D, 0x74BB,  -0x11B4, 0x09B8,  -0x05BF, 0x0372,
+     -0x01A8, 0x00A6, -0x001B, 0x0005,  0x0006, -0x0008, 0x0003,  -0x0001, 0x0},
+    {0,      0x0,     -0x0001, 0x0003,  -0x0002, -0x0005, 0x001F,  -0x004A, 0x00B3, -0x0192,
+     0x02B1, -0x039E, 0x04F8,  -0x05A6, 0x7939,  -0x05A6, 0x04F8,  -0x039E, 0x02B1, -0x0192,
+     0x00B3, -0x004A, 0x001F,  -0x0005, -0x0002, 0x0003,  -0x0001, 0x0,     0x0},
+    {0,       -0x0001, 0x0003,  -0x0008, 0x0006, 0x0005,  -0x001B, 0x00A6, -0x01A8, 0x0372,
+     -0x05BF, 0x09B8,  -0x11B4, 0x74BB,  0x0C9D, -0x0267, -0x0043, 0x0132, -0x00E3, 0x00A2,
+     -0x004B, 0x003C,  -0x0013, 0x0003,  0x0,    -0x0002, 0x0,     0x0,    0x0},
+    {-0x0001, 0x0003,  -0x0008, 0x0011,  -0x0010, 0x000A, 0x006B,  -0x016D, 0x0350, -0x0623,
+     0x0BCD,  -0x1780, 0x6794,  0x234C,  -0x0A78, 0x0400, -0x010A, 0x0009,  0x0034, -0x0054,
+     0x0041,  -0x0022, 0x000A,  -0x0001, 0x0,     0x0001, 0x0,     0x0,     0x0},
+    {0x0002,  -0x0008, 0x0010,  -0x0023, 0x002B, 0x001A,  -0x00EB, 0x027B,  -0x0548, 0x0AFA,
+     -0x16FA, 0x53E0,  0x3C07,  -0x1249, 0x080E, -0x0347, 0x015B,  -0x0044, -0x0017, 0x0046,
+     -0x0023, 0x0011,  -0x0005, 0x0,     0x0,    0x0,     0x0,     0x0,     0x0},
+    {-0x0005, 0x0011,  -0x0023, 0x0046, -0x0017, -0x0044, 0x015B,  -0x0347, 0x080E, -0x1249,
+     0x3C07,  0x53E0,  -0x16FA, 0x0AFA, -0x0548, 0x027B,  -0x00EB, 0x001A,  0x002B, -0x0023,
+     0x0010,  -0x0008, 0x0002,  0x0,    0x0,     0x0,     0x0,     0x0,     0x0}};
+
+  // Entry i of a table weights the sample i steps back from p. Reverse them to match the order in memory, pad the front
+  // with zeros up to 32 taps, so that the window is the 32 samples starting after p.
+  alignas(VECTOR_ALIGNMENT) static constexpr std::array<std::array<s16, 32>, 7> tables = []() {
+    std::array<std::array<s16, 32>, 7> ret = {};
+    for (u32 i = 0; i < 7; i++)
+    {
+      for (u32 j = 0; j < 29; j++)
+        ret[i][31 - j] = zigzag_tables[i][j];
+    }
+    return ret;
+  }();
+
+  // The ring buffer is mirrored, so that the window never wraps around.
+  alignas(VECTOR_ALIGNMENT) s16 left_ringbuf[64];
+  alignas(VECTOR_ALIGNMENT) s16 right_ringbuf[64];
+  for (u32 i = 0; i < 2; i++)
+  {
+    std::memcpy(&left_ringbuf[i * 32], state->ring_buffer[0].data(), sizeof(s16) * 32);
+    std::memcpy(&right_ringbuf[i * 32], state->ring_buffer[1].data(), sizeof(s16) * 32);
+  }
+
+  u32 p = state->p;
+  u32 sixstep = state->sixstep;
+
+  for (u32 in_sample_index = 0; in_sample_index < num_frames_in; in_sample_index++)
+  {
+    left_ringbuf[p] = left_ringbuf[p + 32] = *(frames_in++);
+    if constexpr (STEREO)
+      right_ringbuf[p] = right_ringbuf[p + 32] = *(frames_in++);
+    p = (p + 1) % 32;
+    sixstep--;
+
+    if (sixstep == 0)
+    {
+      sixstep = 6;
+
+      GSVector4i left_window[4];
+      [[maybe_unused]] GSVector4i right_window[4];
+      for (u32 i = 0; i < 4; i++)
+      {
+        left_window[i] = GSVector4i::load<false>(&left_ringbuf[p + 1 + i * 8]);
+        if constexpr (STEREO)
+          right_window[i] = GSVector4i::load<false>(&right_ringbuf[p + 1 + i * 8]);
+      }
+
+      for (u32 j = 0; j < 7; j++)
+      {
+        const s16 left_interp =
+          static_cast<s16>(std::clamp<s32>(XAResampleSumShifted(left_window, tables[j].data()), -0x8000, 0x7FFF));
+        const s16 right_interp =
+          STEREO ?
+            static_cast<s16>(std::clamp<s32>(XAResampleSumShifted(right_window, tables[j].data()), -0x8000, 0x7FFF)) :
+            left_interp;
+        add_frame(left_interp, right_interp);
+      }
+    }
+  }
+
+  std::memcpy(state->ring_buffer[0].data(), left_ringbuf, sizeof(s16) * 32);
+  std::memcpy(state->ring_buffer[1].data(), right_ringbuf, sizeof(s16) * 32);
+  state->p = Truncate8(p);
+  state->sixstep = Truncate8(sixstep);
+}
+
+// Resamples decoded frames to 44100hz, passing each output frame to add_frame.
+template<bool STEREO, typename F>
+inline void ResampleXAADPCM18900(XAResampleState* state, const s16* frames_in, u32 num_frames_in, const F& add_frame)
+{
+  // Weights originally from Mednafen's interpolator. It's unclear where these came from, perhaps it was calculated
+  // somehow. This doesn't appear to use a zigzag pattern like psx-spx suggests, therefore it is restricted to only
+  // 18900hz resampling. Duplicating the 18900hz samples to 37800hz sounds even more awful than lower sample rate audio
+  // should, with a big spike at ~16KHz, especially with music in FMVs. Fortunately, few games actually use 18900hz XA.
+  static constexpr s16 interpolate_tables[7][25] = {
+    {0x0,     -0x5,  0x11,   -0x23, 0x46,  -0x17, -0x44, 0x15b, -0x347, 0x80e, -0x1249, 0x3c07, 0x53e0,
+     -0x16fa, 0xafa, -0x548, 0x27b, -0xeb, 0x1a,  0x2b,  -0x23, 0x10,   -0x8,  0x2,     0x0},
+    {0x0,     -0x2,  0xa,    -0x22, 0x41,   -0x54, 0x34, 0x9,   -0x10a, 0x400, -0xa78, 0x234c, 0x6794,
+     -0x1780, 0xbcd, -0x623, 0x350, -0x16d, 0x6b,  0xa,  -0x10, 0x11,   -0x8,  0x3,    -0x1},
+    {-0x2,    0x0,   0x3,    -0x13, 0x3c,   -0x4b, 0xa2,  -0xe3, 0x132, -0x43, -0x267, 0xc9d, 0x74bb,
+     -0x11b4, 0x9b8, -0x5bf, 0x372, -0x1a8, 0xa6,  -0x1b, 0x5,   0x6,   -0x8,  0x3,    -0x1},
+    {-0x1,   0x3,   -0x2,   -0x5,  0x1f,   -0x4a, 0xb3,  -0x192, 0x2b1, -0x39e, 0x4f8, -0x5a6, 0x7939,
+     -0x5a6, 0x4f8, -0x39e, 0x2b1, -0x192, 0xb3,  -0x4a, 0x1f,   -0x5,  -0x2,   0x3,   -0x1},
+    {-0x1,  0x3,    -0x8,  0x6,   0x5,   -0x1b, 0xa6,  -0x1a8, 0x372, -0x5bf, 0x9b8, -0x11b4, 0x74bb,
+     0xc9d, -0x267, -0x43, 0x132, -0xe3, 0xa2,  -0x4b, 0x3c,   -0x13, 0x3,    0x0,   -0x2},
+    {-0x1,   0x3,    -0x8,  0x11,   -0x10, 0xa,  0x6b,  -0x16d, 0x350, -0x623, 0xbcd, -0x1780, 0x6794,
+     0x234c, -0xa78, 0x400, -0x10a, 0x9,   0x34, -0x54, 0x41,   -0x22, 0xa,    -0x2,  0x0},
+    {0x0,    0x2,     -0x8,  0x10,   -0x23, 0x2b,  0x1a,  -0xeb, 0x27b, -0x548, 0xafa, -0x16fa, 0x53e0,
+     0x3c07, -0x1249, 0x80e, -0x347, 0x15b, -0x44, -0x17, 0x46,  -0x23, 0x11,   -0x5,  0x0},
+  };
+
+  // Pad the front of the tables with zeros up to 32 taps, so that the window is the 32 samples starting at p.
+  alignas(VECTOR_ALIGNMENT) static constexpr std::array<std::array<s16, 32>, 7> tables = []() {
+    std::array<std::array<s16, 32>, 7> ret = {};
+    for (u32 i = 0; i < 7; i++)
+    {
+      for (u32 j = 0; j < 25; j++)
+        ret[i][7 + j] = interpolate_tables[i][j];
+    }
+    return ret;
+  }();
+
+  // The ring buffer is mirrored, so that the window never wraps around.
+  alignas(VECTOR_ALIGNMENT) s16 left_ringbuf[64];
+  alignas(VECTOR_ALIGNMENT) s16 right_ringbuf[64];
+  for (u32 i = 0; i < 2; i++)
+  {
+    std::memcpy(&left_ringbuf[i * 32], state->ring_buffer[0].data(), sizeof(s16) * 32);
+    std::memcpy(&right_ringbuf[i * 32], state->ring_buffer[1].data(), sizeof(s16) * 32);
+  }
+
+  u32 p = state->p;
+  u32 sixstep = state->sixstep;
+
+  for (u32 in_sample_index = 0; in_sample_index < num_frames_in;)
+  {
+    if (sixstep >= 7)
+    {
+      sixstep -= 7;
+      p = (p + 1) % 32;
+
+      left_ringbuf[p] = left_ringbuf[p + 32] = *(frames_in++);
+      if constexpr (STEREO)
+        right_ringbuf[p] = right_ringbuf[p + 32] = *(frames_in++);
+
+      in_sample_index++;
+    }
+
+    GSVector4i left_window[4];
+    for (u32 i = 0; i < 4; i++)
+      left_window[i] = GSVector4i::load<false>(&left_ringbuf[p + i * 8]);
+
+    const s16 left_interp =
+      static_cast<s16>(std::clamp<s32>(XAResampleSum(left_window, tables[sixstep].data()) >> 15, -0x8000, 0x7FFF));
+    s16 right_interp = left_interp;
+    if constexpr (STEREO)
+    {
+      GSVector4i right_window[4];
+      for (u32 i = 0; i < 4; i++)
+        right_window[i] = GSVector4i::load<false>(&right_ringbuf[p + i * 8]);
+
+      right_interp =
+        static_cast<s16>(std::clamp<s32>(XAResampleSum(right_window, tables[sixstep].data()) >> 15, -0x8000, 0x7FFF));
+    }
+
+    add_frame(left_interp, right_interp);
+    sixstep += 3;
+  }
+
+  std::memcpy(state->ring_buffer[0].data(), left_ringbuf, sizeof(s16) * 32);
+  std::memcpy(state->ring_buffer[1].data(), right_ringbuf, sizeof(s16) * 32);
+  state->p = Truncate8(p);
+  state->sixstep = Truncate8(sixstep);
+}
+
+} // namespace CDROM::DSP
@@ -77,6 +77,11 @@ bool Controller::Transfer(const u8 data_in, u8* data_out)
   return false;
 }
 
+bool Controller::IsInputOnlyReadByTransfers() const
+{
+  return true;
+}
+
 float Controller::GetBindState(u32 index) const
 {
   return 0.0f;
@@ -67,6 +67,9 @@ public:
   // Returns the value of ACK, as well as filling out_data.
   virtual bool Transfer(const u8 data_in, u8* data_out);
 
+  /// Returns false if input can affect the console outside of transfers, e.g. an IRQ timed from the aim position.
+  virtual bool IsInputOnlyReadByTransfers() const;
+
   /// Changes the specified axis state. Values are normalized from -1..1.
   virtual float GetBindState(u32 index) const;
 
@@ -16,9 +16,11 @@
 #include "common/align.h"
 #include "common/assert.h"
 #include "common/error.h"
+#include "common/file_system.h"
 #include "common/intrin.h"
 #include "common/log.h"
 #include "common/memmap.h"
+#include "common/path.h"
 
 LOG_CHANNEL(CodeCache);
 
@@ -32,8 +34,16 @@ LOG_CHANNEL(CodeCache);
 #include "cpu_recompiler.h"
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
+#include <xxhash.h>
 #include <zlib.h>
 
 namespace CPU::CodeCache {
@@ -52,6 +62,15 @@ static constexpr u32 RECOMPILE_FRAMES_FOR_INTERPRETER_FALLBACK = 15;
 static constexpr u32 INVALIDATE_COUNT_FOR_MANUAL_PROTECTION = 4;
 static constexpr u32 INVALIDATE_FRAMES_FOR_MANUAL_PROTECTION = 60;
 
+// Granularity of code tracking within a page when sub-page invalidation is enabled, fits in a 64-bit mask.
+static constexpr u32 CODE_GRANULE_SIZE = std::max<u32>(256, HOST_PAGE_SIZE / 64);
+static constexpr u32 CODE_GRANULE_SHIFT = std::bit_width(CODE_GRANULE_SIZE - 1);
+
+// Blocks ending in a direct jump are recompiled together with the jump target(s) after this many executions.
+static constexpr u32 SUPERBLOCK_PROMOTION_THRESHOLD = 256;
+static constexpr u32 MAX_SUPERBLOCK_SEGMENTS = 8;
+static constexpr u32 MAX_SUPERBLOCK_INSTRUCTIONS = 256;
+
 static void AllocateLUTs();
 static void DeallocateLUTs();
 static void ResetCodeLUT();
@@ -66,13 +85,20 @@ static bool IsBlockCodeCurrent(const Block* block);
 static bool RevalidateBlock(Block* block);
 static PageProtectionMode GetProtectionModeForPC(u32 pc);
 static PageProtectionMode GetProtectionModeForBlock(const Block* block);
-static bool ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata);
+static bool ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata,
+                                  bool superblock = false);
+static bool CanExtendSuperblock(u32 start_pc, u32 target_pc);
 static void FillBlockRegInfo(Block* block);
 static void CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src);
 static void SetRegAccess(InstructionInfo* inst, Reg reg, bool write);
 static void AddBlockToPageList(Block* block);
 static void RemoveBlockFromPageList(Block* block);
+static u64 GetCodeGranuleMask(u32 page_offset, u32 size);
+static u64 GetBlockCodeGranuleMask(const Block* block);
+static BlockState UpdatePageInvalidationCount(u32 index, PageProtectionInfo& ppi);
+static void InvalidateBlocksInPageList(PageProtectionInfo& ppi, BlockState new_block_state);
 
+static void AddBlockFetchTicks(const Block* block);
 static Block* CreateCachedInterpreterBlock(u32 pc);
 [[noreturn]] static void ExecuteCachedInterpreter();
 template<PGXPMode pgxp_mode>
@@ -95,15 +121,143 @@ static void UnlinkBlockExits(Block* block);
 static void ResetCodeBuffer();
 
 static void CompileASMFunctions();
-static bool CompileBlock(Block* block);
+static bool CompileBlock(Block* block, const SpeculativeRegisterSnapshot* snapshot = nullptr,
+                         Block* target_block = nullptr);
+static void CompileAndLinkBlock(u32 start_pc, bool superblock);
 static PageFaultHandler::HandlerResult HandleFastmemException(void* exception_pc, void* fault_address, bool is_write);
 static void BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info);
 static void RemoveBackpatchInfoForRange(const void* host_code, u32 size);
+static bool HasBackpatchInfo(const void* host_pc);
 
 static BlockLinkMap s_block_links;
 static std::map<const void*, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
 
+struct BackgroundCompileJob
+{
+  Block* block;
+  u32 pc;
+  SpeculativeRegisterSnapshot snapshot;
+};
+
+struct BackgroundCompileLink
+{
+  u32 pc;
+  void* code;
+};
+
+/// Output of a compile, linked in by the CPU thread the next time it reaches the block.
+struct BackgroundCompileResult
+{
+  Block* block;
+  Common::unique_aligned_ptr<u8[]> source; // copy of the block the code was compiled from
+  u32 size;                                // before the compiler truncated the copy, if it did
+  std::vector<BackgroundCompileLink> links;
+  std::vector<std::pair<void*, LoadstoreBackpatchInfo>> backpatch_info;
+
+  ALWAYS_INLINE Block* Source() { return reinterpret_cast<Block*>(source.get()); }
+};
+
+/// Everything the worker uses while compiling without the lock. The CPU thread only touches it while it holds both
+/// the lock and s_background_compile_active_mutex.
+struct BackgroundCompileWorkerState
+{
+  u8* code_ptr;
+  u8* free_code_ptr;
+  u32 code_size;
+  u32 code_used;
+
+  u8* far_code_ptr;
+  u8* free_far_code_ptr;
+  u32 far_code_size;
+  u32 far_code_used;
+
+  std::unordered_set<u32> fastmem_faulting_pcs;
+  BackgroundCompileResult* result;
+};
+
+using BackgroundCompileLock = std::unique_lock<std::recursive_mutex>;
+
+static bool IsUsingBackgroundCompile();
+static BackgroundCompileLock LockBackgroundCompile();
+static void StartBackgroundCompileThread();
+static void StopBackgroundCompileThread();
+static void BackgroundCompileThreadEntryPoint();
+static void CompileOrRevalidateBlockInBackground(u32 start_pc);
+static void QueueBackgroundCompile(Block* block);
+static void InterpretBlockWhileCompiling(const Block* block);
+static void WaitForBackgroundCompile();
+static void ReleaseBackgroundCompileCode();
+static bool LinkBackgroundCompileResult(Block* block, BackgroundCompileResult& result);
+
+// The worker only holds the mutex while picking up a job and handing back the result, it compiles from a copy of the
+// block into a reserved slice of the code buffers, so page faults never have to wait for a compile. The CPU thread
+// holds it while modifying blocks, links or the code buffer. Recursive because invalidation can happen while the CPU
+// thread is already in the code cache.
+static std::recursive_mutex s_background_compile_mutex;
+static std::condition_variable_any s_background_compile_cv;
+static std::deque<BackgroundCompileJob> s_background_compile_queue;
+static std::unordered_map<u32, BackgroundCompileResult> s_background_compile_results;
+static std::thread s_background_compile_thread;
+static bool s_background_compile_shutdown = false;
+static bool s_background_compile_paused = false;
+static bool s_background_compile_out_of_space = false;
+
+// Held by the worker while it compiles. Taken by the CPU thread before resetting the code buffer or changing settings.
+static std::mutex s_background_compile_active_mutex;
+static BackgroundCompileWorkerState s_background_compile_worker = {};
+static u32 s_background_compile_generation = 0;
+static thread_local bool s_is_background_compile_thread = false;
+
+// Far code is only exception and slow paths, but each one flushes every dirty register, so it can need more space per
+// instruction than near code. Whatever isn't used is returned after the compile, if nothing was allocated behind it.
+static constexpr u32 BACKGROUND_COMPILE_FAR_CODE_RESERVE_MULTIPLIER = 4;
+
+// Block cache - remembers which blocks a game compiled, so they can be compiled up front next boot.
+// Host code isn't position independent, so only the guest side is stored, and the blocks are compiled
+// once the hash of their code in memory matches. Entries whose code doesn't show up in memory for a few
+// sessions in a row are dropped, so the cache follows the game rather than growing forever.
+static constexpr u32 BLOCK_CACHE_SIGNATURE = 0x4B4C4244; // DBLK
+static constexpr u32 BLOCK_CACHE_VERSION = 2;
+static constexpr u32 MAX_BLOCK_CACHE_ENTRIES = 65536;
+static constexpr u32 MAX_BLOCK_CACHE_UNUSED_SESSIONS = 8;
+static constexpr u32 BLOCK_CACHE_SCANS_PER_FRAME = 1024;
+static constexpr u32 BLOCK_CACHE_COMPILES_PER_FRAME = 32;
+static constexpr u32 BLOCK_CACHE_BACKGROUND_COMPILES_PER_FRAME = 256;
+
+struct BlockCacheHeader
+{
+  u32 signature;
+  u32 version;
+  u32 num_entries;
+  u32 reserved;
+};
+
+struct BlockCacheEntry
+{
+  u32 pc;
+  u32 size;
+  u64 hash; // seeded with pc
+  u32 unused_sessions;
+  u32 reserved;
+};
+
+static std::string GetBlockCachePath();
+static const u8* GetBlockCacheCodePointer(u32 pc, u32 size);
+static void AddCompiledBlocksToBlockCache();
+static void ResetBlockCachePending();
+
+static std::string s_block_cache_path;
+static std::vector<BlockCacheEntry> s_block_cache_entries;
+static std::vector<bool> s_block_cache_used; // code was seen in memory this session
+static std::unordered_map<u64, u32> s_block_cache_hashes; // hash -> index into entries
+static std::vector<u32> s_block_cache_pending;            // indices into entries
+static u32 s_block_cache_scan_position = 0;
+static u32 s_block_cache_dropped_blocks = 0;
+
+// Blocks created before the running game changed belong to the previous game's cache.
+static u16 s_block_cache_session = 0;
+
 NORETURN_FUNCTION_POINTER void (*g_enter_recompiler)();
 const void* g_compile_or_revalidate_block;
 const void* g_run_events_and_dispatch;
@@ -151,10 +305,17 @@ static u8* s_free_far_code_ptr = nullptr;
 static u32 s_far_code_size = 0;
 static u32 s_far_code_used = 0;
 
+// Blocks can be compiled on the background thread.
+static std::atomic<u32> s_blocks_created{0};
+static std::atomic<u32> s_blocks_compiled{0};
+static std::atomic<u32> s_blocks_invalidated{0};
+
 #ifdef DUMP_CODE_SIZE_STATS
 static u32 s_total_instructions_compiled = 0;
 static u32 s_total_host_instructions_emitted = 0;
 static u32 s_total_host_code_used_by_instructions = 0;
+static u32 s_total_superblock_instructions_compiled = 0;
+static u32 s_total_superblock_host_instructions_emitted = 0;
 #endif
 } // namespace CPU::CodeCache
 
@@ -207,19 +368,47 @@ void CPU::CodeCache::ProcessShutdown()
 
 void CPU::CodeCache::Reset()
 {
-  ClearBlocks();
+  {
+    const BackgroundCompileLock lock = LockBackgroundCompile();
+    WaitForBackgroundCompile();
+    if (!s_block_cache_path.empty())
+    {
+      AddCompiledBlocksToBlockCache();
+      ResetBlockCachePending();
+    }
 
-  if (IsUsingRecompiler())
+    ClearBlocks();
+
+    if (IsUsingRecompiler())
+    {
+      ResetCodeBuffer();
+      CompileASMFunctions();
+      ResetCodeLUT();
+    }
+  }
+
+  const bool use_background_compile = (IsUsingRecompiler() && g_settings.cpu_recompiler_background_compile);
+  if (use_background_compile != IsUsingBackgroundCompile())
   {
-    ResetCodeBuffer();
-    CompileASMFunctions();
-    ResetCodeLUT();
+    if (use_background_compile)
+      StartBackgroundCompileThread();
+    else
+      StopBackgroundCompileThread();
   }
 }
 
 void CPU::CodeCache::Shutdown()
 {
+  StopBackgroundCompileThread();
   ClearBlocks();
+
+  s_block_cache_path = {};
+  s_block_cache_entries = {};
+  s_block_cache_used = {};
+  s_block_cache_hashes = {};
+  s_block_cache_pending = {};
+  s_block_cache_scan_position = 0;
+  s_block_cache_dropped_blocks = 0;
 }
 
 void CPU::CodeCache::Execute()
@@ -415,6 +604,8 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
     s_blocks.push_back(block);
   }
 
+  s_blocks_created.fetch_add(1, std::memory_order_relaxed);
+
   block->pc = pc;
   block->size = size;
   block->host_code = nullptr;
@@ -427,7 +618,11 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
   block->icache_line_count = metadata.icache_line_count;
   block->host_code_size = 0;
   block->compile_frame = recompile_frame;
-  block->compile_count = recompile_count + 1;
+  block->block_cache_session = s_block_cache_session;
+  block->execution_counter = SUPERBLOCK_PROMOTION_THRESHOLD;
+
+  // promotion isn't a recompile caused by the code changing, so it shouldn't count towards the fallback
+  block->compile_count = recompile_count + BoolToUInt8(!block->HasFlag(BlockFlags::IsSuperblock));
 
   // copy instructions/info
   {
@@ -480,8 +675,39 @@ bool CPU::CodeCache::IsBlockCodeCurrent(const Block* block)
   const PhysicalMemoryAddress phys_addr = VirtualAddressToPhysical(block->pc);
   DebugAssert((phys_addr + (sizeof(Instruction) * block->size)) <= Bus::g_ram_size);
 
-  // can just do a straight memcmp..
-  return (std::memcmp(Bus::g_ram + phys_addr, block->Instructions(), sizeof(Instruction) * block->size) == 0);
+  if (!block->HasFlag(BlockFlags::IsSuperblock))
+  {
+    // can just do a straight memcmp..
+    return (std::memcmp(Bus::g_ram + phys_addr, block->Instructions(), sizeof(Instruction) * block->size) == 0);
+  }
+
+  // superblocks are made up of multiple runs of instructions, each ending with the delay slot of a jump to the next
+  const Instruction* instructions = block->Instructions();
+  const InstructionInfo* info = block->InstructionsInfo();
+  u32 run_pc = block->pc;
+  u32 run_start = 0;
+  for (u32 i = 1; i < block->size; i++)
+  {
+    const bool continues = info[i - 1].is_superblock_branch;
+    if (!continues && i != (block->size - 1))
+      continue;
+
+    const u32 run_length = i - run_start + 1;
+    if (std::memcmp(Bus::g_ram + VirtualAddressToPhysical(run_pc), &instructions[run_start],
+                    sizeof(Instruction) * run_length) != 0)
+    {
+      return false;
+    }
+
+    if (continues)
+    {
+      const u32 branch_pc = run_pc + ((i - 1 - run_start) * sizeof(Instruction));
+      run_pc = ((branch_pc + sizeof(Instruction)) & UINT32_C(0xF0000000)) | (instructions[i - 1].j.target << 2);
+      run_start = i + 1;
+    }
+  }
+
+  return true;
 }
 
 bool CPU::CodeCache::RevalidateBlock(Block* block)
@@ -517,6 +743,7 @@ void CPU::CodeCache::AddBlockToPageList(Block* block)
   const u32 page_idx = block->StartPageIndex();
   PageProtectionInfo& entry = s_page_protection[page_idx];
   Bus::SetRAMCodePage(page_idx);
+  entry.code_granules |= GetBlockCodeGranuleMask(block);
 
   if (entry.last_block_in_page)
   {
@@ -563,14 +790,26 @@ void CPU::CodeCache::RemoveBlockFromPageList(Block* block)
   }
 }
 
-void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
+u64 CPU::CodeCache::GetCodeGranuleMask(u32 page_offset, u32 size)
 {
-  DebugAssert(index < Bus::RAM_8MB_CODE_PAGE_COUNT);
-  Bus::ClearRAMCodePage(index);
+  DebugAssert(size > 0);
+  const u32 first = page_offset >> CODE_GRANULE_SHIFT;
+  const u32 last = std::min(page_offset + size - 1, HOST_PAGE_SIZE - 1) >> CODE_GRANULE_SHIFT;
+  const u32 count = last - first + 1;
+  return ((count == 64) ? ~UINT64_C(0) : ((UINT64_C(1) << count) - 1)) << first;
+}
 
-  BlockState new_block_state = BlockState::Invalidated;
-  PageProtectionInfo& ppi = s_page_protection[index];
+u64 CPU::CodeCache::GetBlockCodeGranuleMask(const Block* block)
+{
+  // superblocks jump around within the page, don't bother tracking each run
+  if (block->HasFlag(BlockFlags::IsSuperblock))
+    return GetCodeGranuleMask(0, HOST_PAGE_SIZE);
 
+  return GetCodeGranuleMask(VirtualAddressToPhysical(block->pc) & HOST_PAGE_MASK, block->size * sizeof(Instruction));
+}
+
+CPU::CodeCache::BlockState CPU::CodeCache::UpdatePageInvalidationCount(u32 index, PageProtectionInfo& ppi)
+{
   const u32 frame_number = System::GetFrameNumber();
   const u32 frame_delta = frame_number - ppi.invalidate_frame;
   ppi.invalidate_count++;
@@ -585,9 +824,25 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
     DEV_LOG("{} invalidations in {} frames to page {} [0x{:08X} -> 0x{:08X}], switching to manual protection",
             ppi.invalidate_count, frame_delta, index, (index << HOST_PAGE_SHIFT), ((index + 1) << HOST_PAGE_SHIFT));
     ppi.mode = PageProtectionMode::ManualCheck;
-    new_block_state = BlockState::NeedsRecompile;
+    return BlockState::NeedsRecompile;
   }
 
+  return BlockState::Invalidated;
+}
+
+void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
+{
+  DebugAssert(index < Bus::RAM_8MB_CODE_PAGE_COUNT);
+  const BackgroundCompileLock lock = LockBackgroundCompile();
+  Bus::ClearRAMCodePage(index);
+
+  PageProtectionInfo& ppi = s_page_protection[index];
+  InvalidateBlocksInPageList(ppi, UpdatePageInvalidationCount(index, ppi));
+}
+
+void CPU::CodeCache::InvalidateBlocksInPageList(PageProtectionInfo& ppi, BlockState new_block_state)
+{
+  ppi.code_granules = 0;
   if (!ppi.first_block_in_page)
     return;
 
@@ -606,6 +861,69 @@ void CPU::CodeCache::InvalidateBlocksWithPageIndex(u32 index)
   MemMap::EndCodeWrite();
 }
 
+void CPU::CodeCache::InvalidateBlocksForRAMWrite(PhysicalMemoryAddress address, u32 size)
+{
+  const u32 index = Bus::GetRAMCodePageIndex(address);
+  if (!g_settings.cpu_recompiler_subpage_invalidation)
+  {
+    InvalidateBlocksWithPageIndex(index);
+    return;
+  }
+
+  const BackgroundCompileLock lock = LockBackgroundCompile();
+  PageProtectionInfo& ppi = s_page_protection[index];
+  const u64 write_mask = GetCodeGranuleMask(address & HOST_PAGE_MASK, size);
+  if (!(ppi.code_granules & write_mask))
+  {
+    // Data sharing a page with code, leave the blocks alone, and don't count it towards manual protection.
+    return;
+  }
+
+  // Switching to manual protection needs every block in the page to be recompiled.
+  const BlockState new_block_state = UpdatePageInvalidationCount(index, ppi);
+  if (new_block_state == BlockState::NeedsRecompile)
+  {
+    Bus::ClearRAMCodePage(index);
+    InvalidateBlocksInPageList(ppi, new_block_state);
+    return;
+  }
+
+  MemMap::BeginCodeWrite();
+
+  // Pull out overlapping blocks, and rebuild the mask from what's left.
+  Block* prev_block = nullptr;
+  Block* block = ppi.first_block_in_page;
+  ppi.code_granules = 0;
+  while (block)
+  {
+    Block* const next_block = block->next_block_in_page;
+    const u64 block_mask = GetBlockCodeGranuleMask(block);
+    if (block_mask & write_mask)
+    {
+      if (prev_block)
+        prev_block->next_block_in_page = next_block;
+      else
+        ppi.first_block_in_page = next_block;
+
+      block->next_block_in_page = nullptr;
+      InvalidateBlock(block, new_block_state);
+    }
+    else
+    {
+      ppi.code_granules |= block_mask;
+      prev_block = block;
+    }
+
+    block = next_block;
+  }
+
+  ppi.last_block_in_page = prev_block;
+  if (!ppi.first_block_in_page)
+    Bus::ClearRAMCodePage(index);
+
+  MemMap::EndCodeWrite();
+}
+
 CPU::CodeCache::PageProtectionMode CPU::CodeCache::GetProtectionModeForPC(u32 pc)
 {
   if (!AddressInRAM(pc))
@@ -631,6 +949,7 @@ void CPU::CodeCache::InvalidateBlock(Block* block, BlockState new_state)
   {
     SetCodeLUT(block->pc, g_compile_or_revalidate_block);
     BacklinkBlocks(block->pc, g_compile_or_revalidate_block);
+    s_blocks_invalidated.fetch_add(1, std::memory_order_relaxed);
   }
 
   block->state = new_state;
@@ -638,6 +957,8 @@ void CPU::CodeCache::InvalidateBlock(Block* block, BlockState new_state)
 
 void CPU::CodeCache::InvalidateAllRAMBlocks()
 {
+  const BackgroundCompileLock lock = LockBackgroundCompile();
+
   // TODO: maybe combine the backlink into one big instruction flush cache?
   MemMap::BeginCodeWrite();
 
@@ -654,12 +975,24 @@ void CPU::CodeCache::InvalidateAllRAMBlocks()
   {
     ppi.first_block_in_page = nullptr;
     ppi.last_block_in_page = nullptr;
+    ppi.code_granules = 0;
   }
 
   MemMap::EndCodeWrite();
   Bus::ClearRAMCodePageFlags();
 }
 
+void CPU::CodeCache::GetStatistics(Statistics* stats)
+{
+  stats->blocks_created = s_blocks_created.load(std::memory_order_relaxed);
+  stats->blocks_compiled = s_blocks_compiled.load(std::memory_order_relaxed);
+  stats->blocks_invalidated = s_blocks_invalidated.load(std::memory_order_relaxed);
+  stats->code_buffer_used = s_code_used;
+  stats->code_buffer_size = s_code_size;
+  stats->far_code_buffer_used = s_far_code_used;
+  stats->far_code_buffer_size = s_far_code_size;
+}
+
 void CPU::CodeCache::ClearBlocks()
 {
   for (u32 i = 0; i < Bus::RAM_8MB_CODE_PAGE_COUNT; i++)
@@ -673,7 +1006,12 @@ void CPU::CodeCache::ClearBlocks()
 
   s_fastmem_backpatch_info.clear();
   s_fastmem_faulting_pcs.clear();
-  s_block_links.clear();
+  s_block_links.Clear();
+  s_background_compile_queue.clear();
+  s_background_compile_results.clear();
+  s_background_compile_worker.fastmem_faulting_pcs.clear();
+  s_background_compile_out_of_space = false;
+  s_background_compile_generation++;
 
   for (Block* block : s_blocks)
   {
@@ -695,6 +1033,15 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
     DebugAssert(is_write);
     const u32 guest_address = static_cast<u32>(static_cast<const u8*>(fault_address) - Bus::g_ram);
     const u32 page_index = Bus::GetRAMCodePageIndex(guest_address);
+
+    // With sub-page invalidation, recompiled stores are sent through the memory handlers, which check the region.
+    if (g_settings.cpu_recompiler_subpage_invalidation &&
+        CPU::CodeCache::HandleFastmemException(exception_pc, fault_address, is_write) ==
+          PageFaultHandler::HandlerResult::ContinueExecution)
+    {
+      return PageFaultHandler::HandlerResult::ContinueExecution;
+    }
+
     DEV_LOG("Page fault on protected RAM @ 0x{:08X} (page #{}), invalidating code cache.", guest_address, page_index);
     CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
     return PageFaultHandler::HandlerResult::ContinueExecution;
@@ -707,6 +1054,23 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
 // MARK: - Cached Interpreter
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+ALWAYS_INLINE_RELEASE void CPU::CodeCache::AddBlockFetchTicks(const Block* block)
+{
+  if (block->HasFlag(BlockFlags::IsUsingICache))
+  {
+    CheckAndUpdateICacheTags(block->icache_line_count);
+  }
+  else if (block->HasFlag(BlockFlags::NeedsDynamicFetchTicks))
+  {
+    AddPendingTicks(static_cast<TickCount>(
+      block->size * static_cast<u32>(*Bus::GetMemoryAccessTimePtr(block->pc & KSEG_MASK, MemoryAccessSize::Word))));
+  }
+  else
+  {
+    AddPendingTicks(block->uncached_fetch_ticks);
+  }
+}
+
 CPU::CodeCache::Block* CPU::CodeCache::CreateCachedInterpreterBlock(u32 pc)
 {
   BlockMetadata metadata = {};
@@ -770,20 +1134,7 @@ template<PGXPMode pgxp_mode>
       }
 
       DebugAssert(!(HasPendingInterrupt()));
-      if (block->HasFlag(BlockFlags::IsUsingICache))
-      {
-        CheckAndUpdateICacheTags(block->icache_line_count);
-      }
-      else if (block->HasFlag(BlockFlags::NeedsDynamicFetchTicks))
-      {
-        AddPendingTicks(static_cast<TickCount>(
-          block->size * static_cast<u32>(*Bus::GetMemoryAccessTimePtr(block->pc & KSEG_MASK, MemoryAccessSize::Word))));
-      }
-      else
-      {
-        AddPendingTicks(block->uncached_fetch_ticks);
-      }
-
+      AddBlockFetchTicks(block);
       InterpretCachedBlock<pgxp_mode>(block);
 
       CHECK_DOWNCOUNT();
@@ -849,7 +1200,8 @@ void CPU::CodeCache::LogCurrentState()
 // MARK: - Block Compilation: Shared Code
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata)
+bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata,
+                                           bool superblock)
 {
   // TODO: Jump to other block if it exists at this pc?
 
@@ -875,6 +1227,17 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
   u32 last_cache_line = ICACHE_LINES;
   u32 last_page = (protection == PageProtectionMode::WriteProtected) ? Bus::GetRAMCodePageIndex(start_pc) : 0;
 
+  // Icache tags are updated for contiguous lines in the prologue, and manual protection compares contiguous memory,
+  // so neither can be used with superblocks. Uncached fetch ticks are also charged for the whole block in the
+  // prologue, which would run events late and charge the later segments again when exiting at an event check.
+  const bool allow_superblock = (g_settings.cpu_recompiler_superblocks && IsUsingRecompiler() &&
+                                 protection != PageProtectionMode::ManualCheck && use_icache &&
+                                 !g_settings.cpu_recompiler_icache);
+  superblock = superblock && allow_superblock;
+  std::array<std::pair<u32, u32>, MAX_SUPERBLOCK_SEGMENTS> segments;
+  u32 num_segments = 0;
+  u32 segment_start_pc = start_pc;
+
   for (;;)
   {
     if (protection == PageProtectionMode::WriteProtected)
@@ -973,7 +1336,46 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
     // if we're in a branch delay slot, the block is now done
     // except if this is a branch in a branch delay slot, then we grab the one after that, and so on...
     if (is_branch_delay_slot && !info.is_branch_instruction)
-      break;
+    {
+      if (!allow_superblock)
+        break;
+
+      // direct jumps can carry on at the target if we're forming a superblock
+      BlockInstructionInfoPair& branch = (*instructions)[instructions->size() - 2];
+      if ((branch.first.op != InstructionOp::j && branch.first.op != InstructionOp::jal) ||
+          IsExitBlockInstruction(instruction))
+      {
+        break;
+      }
+
+      const u32 target_pc = ((pc - sizeof(Instruction)) & UINT32_C(0xF0000000)) | (branch.first.j.target << 2);
+      if (!CanExtendSuperblock(start_pc, target_pc) || num_segments == (MAX_SUPERBLOCK_SEGMENTS - 1) ||
+          instructions->size() >= MAX_SUPERBLOCK_INSTRUCTIONS ||
+          std::any_of(segments.begin(), segments.begin() + num_segments,
+                      [target_pc](const auto& it) { return (target_pc >= it.first && target_pc < it.second); }) ||
+          (target_pc >= segment_start_pc && target_pc < pc))
+      {
+        break;
+      }
+
+      if (!superblock)
+      {
+        // profile it first, most blocks aren't executed often enough to be worth the extra compile
+        metadata->flags |= BlockFlags::SuperblockCandidate;
+        break;
+      }
+
+      DEBUG_LOG("Extending superblock 0x{:08X} from 0x{:08X} to 0x{:08X}", start_pc, pc - (sizeof(Instruction) * 2),
+                target_pc);
+      segments[num_segments++] = std::make_pair(segment_start_pc, pc);
+      segment_start_pc = target_pc;
+      branch.second.is_superblock_branch = true;
+      metadata->flags |= BlockFlags::IsSuperblock;
+      pc = target_pc;
+      is_branch_delay_slot = false;
+      is_load_delay_slot = info.has_load_delay;
+      continue;
+    }
 
     // if this is a branch, we grab the next instruction (delay slot), and then exit
     is_branch_delay_slot = info.is_branch_instruction;
@@ -994,6 +1396,10 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
 
   instructions->back().second.is_last_instruction = true;
 
+  // if we couldn't read anything from the last jump target, it's just a normal exit
+  if (instructions->size() >= 2 && (instructions->end() - 2)->second.is_superblock_branch)
+    (instructions->end() - 2)->second.is_superblock_branch = false;
+
 #if defined(_DEBUG) || defined(_DEVEL)
   SmallString disasm;
   u32 disasm_pc = start_pc;
@@ -1012,6 +1418,20 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
   return true;
 }
 
+bool CPU::CodeCache::CanExtendSuperblock(u32 start_pc, u32 target_pc)
+{
+  // only cached code, see ReadBlockInstructions()
+  if (!CPU::IsCachedAddress(target_pc))
+    return false;
+
+  // the whole superblock has to be covered by the write protection of the first page
+  if (AddressInRAM(start_pc))
+    return (AddressInRAM(target_pc) && Bus::GetRAMCodePageIndex(target_pc) == Bus::GetRAMCodePageIndex(start_pc));
+
+  // ROM can't change, but keep it close so the fetch timing is the same
+  return (((start_pc ^ target_pc) & ~UINT32_C(0xFFF)) == 0);
+}
+
 void CPU::CodeCache::CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src)
 {
   std::memcpy(dst->reg_flags, src->reg_flags, sizeof(dst->reg_flags));
@@ -1283,6 +1703,12 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
 {
   // TODO: this doesn't currently handle when the cache overflows...
   DebugAssert(IsUsingRecompiler());
+  if (IsUsingBackgroundCompile())
+  {
+    CompileOrRevalidateBlockInBackground(start_pc);
+    return;
+  }
+
   MemMap::BeginCodeWrite();
 
   Block* block = LookupBlock(start_pc);
@@ -1307,8 +1733,13 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
       RemoveBackpatchInfoForRange(block->host_code, block->host_code_size);
   }
 
+  CompileAndLinkBlock(start_pc, false);
+}
+
+void CPU::CodeCache::CompileAndLinkBlock(u32 start_pc, bool superblock)
+{
   BlockMetadata metadata = {};
-  if (!ReadBlockInstructions(start_pc, &s_block_instructions, &metadata))
+  if (!ReadBlockInstructions(start_pc, &s_block_instructions, &metadata, superblock))
   {
     ERROR_LOG("Failed to read block at 0x{:08X}, falling back to uncached interpreter", start_pc);
     SetCodeLUT(start_pc, g_interpret_block);
@@ -1330,6 +1761,7 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
     CodeCache::Reset();
   }
 
+  Block* block;
   if ((block = CreateBlock(start_pc, s_block_instructions, metadata)) == nullptr || block->size == 0 ||
       !CompileBlock(block))
   {
@@ -1349,13 +1781,392 @@ void CPU::CodeCache::DiscardAndRecompileBlock(u32 start_pc)
 {
   MemMap::BeginCodeWrite();
 
-  DEV_LOG("Discard block {:08X} with manual protection", start_pc);
+  bool promoted;
+  {
+    // Don't hold the lock while recompiling, the block may be interpreted if compiling in the background.
+    const BackgroundCompileLock lock = LockBackgroundCompile();
+    Block* block = LookupBlock(start_pc);
+    DebugAssert(block && block->state == BlockState::Valid);
+
+    // Candidates don't use manual protection, so we're only here because the execution counter ran out.
+    promoted = block->HasFlag(BlockFlags::SuperblockCandidate);
+    if (promoted)
+    {
+      DEV_LOG("Promoting block {:08X} to superblock", start_pc);
+      InvalidateBlock(block, BlockState::NeedsRecompile);
+      UnlinkBlockExits(block);
+      if (block->HasFlag(BlockFlags::ContainsLoadStoreInstructions))
+        RemoveBackpatchInfoForRange(block->host_code, block->host_code_size);
+
+      // Compiled synchronously under the lock, it's only a single block.
+      CompileAndLinkBlock(start_pc, true);
+    }
+    else
+    {
+      DEV_LOG("Discard block {:08X} with manual protection", start_pc);
+      InvalidateBlock(block, BlockState::NeedsRecompile);
+    }
+  }
+
+  if (!promoted)
+    CompileOrRevalidateBlock(start_pc);
+
+  MemMap::EndCodeWrite();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Background Compilation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CPU::CodeCache::IsUsingBackgroundCompile()
+{
+  return s_background_compile_thread.joinable();
+}
+
+CPU::CodeCache::BackgroundCompileLock CPU::CodeCache::LockBackgroundCompile()
+{
+  // Without the worker, only the CPU thread touches the code cache, so don't bother locking.
+  return IsUsingBackgroundCompile() ? BackgroundCompileLock(s_background_compile_mutex) : BackgroundCompileLock();
+}
+
+void CPU::CodeCache::StartBackgroundCompileThread()
+{
+  if (IsUsingBackgroundCompile())
+    StopBackgroundCompileThread();
+
+  // Stays paused until execution starts, g_settings may still be changing.
+  s_background_compile_shutdown = false;
+  s_background_compile_paused = true;
+  s_background_compile_thread = std::thread(&BackgroundCompileThreadEntryPoint);
+  INFO_LOG("Background compile thread started.");
+}
+
+void CPU::CodeCache::StopBackgroundCompileThread()
+{
+  if (!IsUsingBackgroundCompile())
+    return;
+
+  {
+    const BackgroundCompileLock lock(s_background_compile_mutex);
+    s_background_compile_shutdown = true;
+    s_background_compile_cv.notify_one();
+  }
+
+  s_background_compile_thread.join();
+  s_background_compile_queue.clear();
+  s_background_compile_results.clear();
+  INFO_LOG("Background compile thread stopped.");
+}
+
+void CPU::CodeCache::SetBackgroundCompilePaused(bool paused)
+{
+  if (!IsUsingBackgroundCompile())
+    return;
+
+  const BackgroundCompileLock lock(s_background_compile_mutex);
+  s_background_compile_paused = paused;
+
+  // Settings may change while paused, so the compile in progress has to finish first.
+  if (paused)
+    WaitForBackgroundCompile();
+  else if (!s_background_compile_queue.empty())
+    s_background_compile_cv.notify_one();
+}
+
+void CPU::CodeCache::WaitForBackgroundCompile()
+{
+  const std::lock_guard active_lock(s_background_compile_active_mutex);
+}
+
+void CPU::CodeCache::BackgroundCompileThreadEntryPoint()
+{
+  s_is_background_compile_thread = true;
+
+  BackgroundCompileLock lock(s_background_compile_mutex);
+  BackgroundCompileWorkerState& worker = s_background_compile_worker;
+
+  for (;;)
+  {
+    s_background_compile_cv.wait(lock, []() {
+      return (s_background_compile_shutdown ||
+              (!s_background_compile_paused && !s_background_compile_queue.empty()));
+    });
+    if (s_background_compile_shutdown)
+      break;
+
+    const BackgroundCompileJob job = s_background_compile_queue.front();
+    s_background_compile_queue.pop_front();
+
+    // The block may have been invalidated or recreated since it was queued, don't touch it unless it's still ours.
+    Block* const block = LookupBlock(job.pc);
+    if (block != job.block || block->state != BlockState::CompilePending || block->host_code)
+      continue;
+
+    // Resetting has to happen on the CPU thread, since it may be executing code from the buffer.
+    const u32 code_reserve =
+      block->size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION + Recompiler::MIN_CODE_RESERVE_FOR_BLOCK;
+    const u32 far_code_reserve = code_reserve * BACKGROUND_COMPILE_FAR_CODE_RESERVE_MULTIPLIER;
+    if ((s_code_size - s_code_used) < code_reserve || (s_far_code_size - s_far_code_used) < far_code_reserve)
+    {
+      s_background_compile_out_of_space = true;
+      s_background_compile_queue.clear();
+      continue;
+    }
+
+    // Compile from a copy, the CPU thread is free to interpret or invalidate the block in the meantime.
+    const size_t block_bytes = sizeof(Block) + ((sizeof(Instruction) + sizeof(InstructionInfo)) * block->size);
+    BackgroundCompileResult result;
+    result.block = block;
+    result.size = block->size;
+    result.source = Common::make_unique_aligned_for_overwrite<u8[]>(alignof(Block), block_bytes);
+    new (result.source.get()) Block(*block);
+    std::memcpy(result.Source()->Instructions(), block->Instructions(),
+                (sizeof(Instruction) + sizeof(InstructionInfo)) * block->size);
+
+    // Faulting PCs are only ever added between resets.
+    if (worker.fastmem_faulting_pcs.size() != s_fastmem_faulting_pcs.size())
+      worker.fastmem_faulting_pcs = s_fastmem_faulting_pcs;
+
+    worker.code_ptr = s_free_code_ptr;
+    worker.free_code_ptr = s_free_code_ptr;
+    worker.code_size = code_reserve;
+    worker.code_used = 0;
+    worker.far_code_ptr = s_free_far_code_ptr;
+    worker.free_far_code_ptr = s_free_far_code_ptr;
+    worker.far_code_size = far_code_reserve;
+    worker.far_code_used = 0;
+    worker.result = &result;
+    s_free_code_ptr += code_reserve;
+    s_code_used += code_reserve;
+    s_free_far_code_ptr += far_code_reserve;
+    s_far_code_used += far_code_reserve;
+
+    std::unique_lock active_lock(s_background_compile_active_mutex);
+    const u32 generation = s_background_compile_generation;
+    lock.unlock();
+
+    MemMap::BeginCodeWrite();
+    CompileBlock(result.Source(), &job.snapshot, block);
+    MemMap::EndCodeWrite();
+    worker.result = nullptr;
+    active_lock.unlock();
+
+    lock.lock();
+
+    // If the code cache was reset while compiling, the code is already gone.
+    if (generation == s_background_compile_generation)
+    {
+      ReleaseBackgroundCompileCode();
+      s_background_compile_results.insert_or_assign(job.pc, std::move(result));
+    }
+
+    // Give the CPU thread a chance to get in before the next block.
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+  }
+}
+
+void CPU::CodeCache::ReleaseBackgroundCompileCode()
+{
+  // Can only give back what's left if nothing was allocated after the reservation.
+  const BackgroundCompileWorkerState& worker = s_background_compile_worker;
+  if (s_free_code_ptr == (worker.code_ptr + worker.code_size))
+  {
+    s_free_code_ptr = worker.free_code_ptr;
+    s_code_used -= worker.code_size - worker.code_used;
+  }
+  if (s_free_far_code_ptr == (worker.far_code_ptr + worker.far_code_size))
+  {
+    s_free_far_code_ptr = worker.free_far_code_ptr;
+    s_far_code_used -= worker.far_code_size - worker.far_code_used;
+  }
+}
+
+bool CPU::CodeCache::LinkBackgroundCompileResult(Block* block, BackgroundCompileResult& result)
+{
+  // If the block changed while it was compiling, a newer compile has already been queued for it.
+  Block* const source = result.Source();
+  if (result.block != block || block->size != result.size || block->flags != source->flags ||
+      block->protection != source->protection ||
+      std::memcmp(block->Instructions(), source->Instructions(), sizeof(Instruction) * result.size) != 0)
+  {
+    DEV_LOG("Discarding background compile of {:08X}, block changed", block->pc);
+    return false;
+  }
+
+  block->host_code = source->host_code;
+  block->host_code_size = source->host_code_size;
+  if (!block->host_code)
+  {
+    // Worker failed to compile it.
+    block->state = BlockState::FallbackToInterpreter;
+    SetCodeLUT(block->pc, g_interpret_block);
+    BacklinkBlocks(block->pc, g_interpret_block);
+    return true;
+  }
+
+  // Match what TruncateBlock() does for blocks compiled on this thread.
+  if (source->size != block->size)
+  {
+    InstructionInfo* const info = block->InstructionsInfo();
+    block->size = source->size;
+    info[block->size - 1].is_last_instruction = true;
+  }
+
+  for (const auto& [code, info] : result.backpatch_info)
+    s_fastmem_backpatch_info.insert_or_assign(code, info);
+
+  // Exits were emitted as jumps to the dispatcher, point them at the real targets now that they can be looked up.
+  for (const BackgroundCompileLink& link : result.links)
+  {
+    const void* dst = (link.pc == block->pc) ? CreateSelfBlockLink(block, link.code, block->host_code) :
+                                               CreateBlockLink(block, link.code, link.pc);
+    EmitJump(link.code, dst, false);
+  }
+
+  block->state = BlockState::Valid;
+  MemMap::FlushInstructionCache(const_cast<void*>(block->host_code), block->host_code_size);
+  SetCodeLUT(block->pc, block->host_code);
+  BacklinkBlocks(block->pc, block->host_code);
+  return true;
+}
+
+void CPU::CodeCache::CompileOrRevalidateBlockInBackground(u32 start_pc)
+{
+  BackgroundCompileLock lock(s_background_compile_mutex, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    // Worker is busy, don't stall waiting for it. We'll queue the block next time we come through here.
+    InterpretBlockWhileCompiling(nullptr);
+    return;
+  }
+
+  if (s_background_compile_out_of_space)
+  {
+    ERROR_LOG("Out of code space while compiling {:08X}. Resetting code cache.", start_pc);
+    CodeCache::Reset();
+  }
+
+  MemMap::BeginCodeWrite();
+
   Block* block = LookupBlock(start_pc);
-  DebugAssert(block && block->state == BlockState::Valid);
-  InvalidateBlock(block, BlockState::NeedsRecompile);
-  CompileOrRevalidateBlock(start_pc);
+  if (block)
+  {
+    // we should only be here if the block got invalidated, or hasn't been linked yet
+    DebugAssert(block->state != BlockState::Valid);
+    if (block->state == BlockState::CompilePending)
+    {
+      if (auto iter = s_background_compile_results.find(start_pc); iter != s_background_compile_results.end())
+      {
+        // Compile finished, safe to link it in now that we're on the CPU thread.
+        BackgroundCompileResult result = std::move(iter->second);
+        s_background_compile_results.erase(iter);
+        if (LinkBackgroundCompileResult(block, result))
+        {
+          MemMap::EndCodeWrite();
+          return;
+        }
+      }
+
+      if (block->protection != PageProtectionMode::ManualCheck || IsBlockCodeCurrent(block))
+      {
+        MemMap::EndCodeWrite();
+        lock.unlock();
+        InterpretBlockWhileCompiling(block);
+        return;
+      }
+
+      // Code changed before the worker got to it, the queued compile will be skipped.
+      block->state = BlockState::NeedsRecompile;
+    }
+    else if (block->state == BlockState::FallbackToInterpreter)
+    {
+      // Failed to compile it.
+      SetCodeLUT(start_pc, g_interpret_block);
+      BacklinkBlocks(start_pc, g_interpret_block);
+      MemMap::EndCodeWrite();
+      return;
+    }
+    else if (RevalidateBlock(block))
+    {
+      if (!block->host_code)
+      {
+        // Invalidated before the worker got to it, but the code is the same, so queue it again.
+        QueueBackgroundCompile(block);
+        MemMap::EndCodeWrite();
+        lock.unlock();
+        InterpretBlockWhileCompiling(block);
+        return;
+      }
+
+      SetCodeLUT(start_pc, block->host_code);
+      BacklinkBlocks(start_pc, block->host_code);
+      MemMap::EndCodeWrite();
+      return;
+    }
+
+    // remove outward links from this block, since we're recompiling it
+    UnlinkBlockExits(block);
+
+    // clean up backpatch info so it doesn't keep growing indefinitely
+    if (block->HasFlag(BlockFlags::ContainsLoadStoreInstructions))
+      RemoveBackpatchInfoForRange(block->host_code, block->host_code_size);
+  }
 
+  BlockMetadata metadata = {};
+  if (!ReadBlockInstructions(start_pc, &s_block_instructions, &metadata) ||
+      (block = CreateBlock(start_pc, s_block_instructions, metadata)) == nullptr || block->size == 0)
+  {
+    ERROR_LOG("Failed to read block at 0x{:08X}, falling back to uncached interpreter", start_pc);
+    SetCodeLUT(start_pc, g_interpret_block);
+    BacklinkBlocks(start_pc, g_interpret_block);
+    MemMap::EndCodeWrite();
+    return;
+  }
+
+  QueueBackgroundCompile(block);
   MemMap::EndCodeWrite();
+  lock.unlock();
+
+  InterpretBlockWhileCompiling(block);
+}
+
+void CPU::CodeCache::QueueBackgroundCompile(Block* block)
+{
+  // Registers are captured now, since the CPU thread will have moved on by the time the worker gets to it.
+  BackgroundCompileJob& job = s_background_compile_queue.emplace_back();
+  job.block = block;
+  job.pc = block->pc;
+  std::copy_n(g_state.regs.r, job.snapshot.regs.size(), job.snapshot.regs.begin());
+  job.snapshot.cop0_sr = g_state.cop0_regs.sr.bits;
+
+  block->state = BlockState::CompilePending;
+  s_background_compile_cv.notify_one();
+}
+
+void CPU::CodeCache::InterpretBlockWhileCompiling(const Block* block)
+{
+  if (!block)
+  {
+    reinterpret_cast<void (*)()>(GetInterpretUncachedBlockFunction())();
+    return;
+  }
+
+  // Same timing as the recompiled block, so it doesn't matter which one ends up running.
+  AddBlockFetchTicks(block);
+
+  if (g_settings.gpu_pgxp_enable)
+  {
+    if (g_settings.gpu_pgxp_cpu)
+      InterpretCachedBlock<PGXPMode::CPU>(block);
+    else
+      InterpretCachedBlock<PGXPMode::Memory>(block);
+  }
+  else
+  {
+    InterpretCachedBlock<PGXPMode::Disabled>(block);
+  }
 }
 
 const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
@@ -1364,7 +2175,12 @@ const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
   DebugAssert(newpc != block->pc);
 
   const void* dst = g_dispatcher;
-  if (g_settings.cpu_recompiler_block_linking)
+  if (g_settings.cpu_recompiler_block_linking && s_is_background_compile_thread)
+  {
+    // Block lookups need the lock, patched when the block is linked in.
+    s_background_compile_worker.result->links.push_back(BackgroundCompileLink{newpc, code});
+  }
+  else if (g_settings.cpu_recompiler_block_linking)
   {
     const Block* next_block = LookupBlock(newpc);
     if (next_block)
@@ -1380,9 +2196,8 @@ const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
       dst = HasBlockLUT(newpc) ? g_compile_or_revalidate_block : g_interpret_block;
     }
 
-    BlockLinkMap::iterator iter = s_block_links.emplace(newpc, code);
     DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
-    block->exit_links[block->num_exit_links++] = iter;
+    block->exit_links[block->num_exit_links++] = s_block_links.Insert(newpc, code);
   }
 
   DEBUG_LOG("Linking {} with dst pc {:08X} to {}{}", code, newpc, dst,
@@ -1397,9 +2212,15 @@ const void* CPU::CodeCache::CreateSelfBlockLink(Block* block, void* code, const
   {
     dst = block_start;
 
-    BlockLinkMap::iterator iter = s_block_links.emplace(block->pc, code);
+    // Registered when the block is linked in.
+    if (s_is_background_compile_thread)
+    {
+      s_background_compile_worker.result->links.push_back(BackgroundCompileLink{block->pc, code});
+      return dst;
+    }
+
     DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
-    block->exit_links[block->num_exit_links++] = iter;
+    block->exit_links[block->num_exit_links++] = s_block_links.Insert(block->pc, code);
   }
 
   DEBUG_LOG("Self linking {} with dst pc {:08X} to {}", code, block->pc, dst);
@@ -1411,20 +2232,18 @@ void CPU::CodeCache::BacklinkBlocks(u32 pc, const void* dst)
   if (!g_settings.cpu_recompiler_block_linking)
     return;
 
-  const auto link_range = s_block_links.equal_range(pc);
-  for (auto it = link_range.first; it != link_range.second; ++it)
-  {
-    DEBUG_LOG("Backlinking {} with dst pc {:08X} to {}{}", it->second, pc, dst,
+  s_block_links.ForEach(pc, [pc, dst](void* code) {
+    DEBUG_LOG("Backlinking {} with dst pc {:08X} to {}{}", code, pc, dst,
               (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
-    EmitJump(it->second, dst, true);
-  }
+    EmitJump(code, dst, true);
+  });
 }
 
 void CPU::CodeCache::UnlinkBlockExits(Block* block)
 {
   const u32 num_exit_links = block->num_exit_links;
   for (u32 i = 0; i < num_exit_links; i++)
-    s_block_links.erase(block->exit_links[i]);
+    s_block_links.Erase(block->exit_links[i]);
   block->num_exit_links = 0;
 }
 
@@ -1463,14 +2282,18 @@ void CPU::CodeCache::ResetCodeBuffer()
   s_far_code_used = 0;
 }
 
+// The background compile thread allocates from the slice it reserved instead.
+
 u8* CPU::CodeCache::GetFreeCodePointer()
 {
-  return s_free_code_ptr;
+  return s_is_background_compile_thread ? s_background_compile_worker.free_code_ptr : s_free_code_ptr;
 }
 
 u32 CPU::CodeCache::GetFreeCodeSpace()
 {
-  return s_code_size - s_code_used;
+  return s_is_background_compile_thread ?
+           (s_background_compile_worker.code_size - s_background_compile_worker.code_used) :
+           (s_code_size - s_code_used);
 }
 
 void CPU::CodeCache::CommitCode(u32 length)
@@ -1478,21 +2301,25 @@ void CPU::CodeCache::CommitCode(u32 length)
   if (length == 0) [[unlikely]]
     return;
 
-  MemMap::FlushInstructionCache(s_free_code_ptr, length);
+  u8*& free_code_ptr = s_is_background_compile_thread ? s_background_compile_worker.free_code_ptr : s_free_code_ptr;
+  u32& code_used = s_is_background_compile_thread ? s_background_compile_worker.code_used : s_code_used;
+  MemMap::FlushInstructionCache(free_code_ptr, length);
 
-  Assert(length <= (s_code_size - s_code_used));
-  s_free_code_ptr += length;
-  s_code_used += length;
+  Assert(length <= GetFreeCodeSpace());
+  free_code_ptr += length;
+  code_used += length;
 }
 
 u8* CPU::CodeCache::GetFreeFarCodePointer()
 {
-  return s_free_far_code_ptr;
+  return s_is_background_compile_thread ? s_background_compile_worker.free_far_code_ptr : s_free_far_code_ptr;
 }
 
 u32 CPU::CodeCache::GetFreeFarCodeSpace()
 {
-  return s_far_code_size - s_far_code_used;
+  return s_is_background_compile_thread ?
+           (s_background_compile_worker.far_code_size - s_background_compile_worker.far_code_used) :
+           (s_far_code_size - s_far_code_used);
 }
 
 void CPU::CodeCache::CommitFarCode(u32 length)
@@ -1500,26 +2327,31 @@ void CPU::CodeCache::CommitFarCode(u32 length)
   if (length == 0) [[unlikely]]
     return;
 
-  MemMap::FlushInstructionCache(s_free_far_code_ptr, length);
+  u8*& free_far_code_ptr =
+    s_is_background_compile_thread ? s_background_compile_worker.free_far_code_ptr : s_free_far_code_ptr;
+  u32& far_code_used = s_is_background_compile_thread ? s_background_compile_worker.far_code_used : s_far_code_used;
+  MemMap::FlushInstructionCache(free_far_code_ptr, length);
 
-  Assert(length <= (s_far_code_size - s_far_code_used));
-  s_free_far_code_ptr += length;
-  s_far_code_used += length;
+  Assert(length <= GetFreeFarCodeSpace());
+  free_far_code_ptr += length;
+  far_code_used += length;
 }
 
 void CPU::CodeCache::AlignCode(u32 alignment)
 {
   DebugAssert(Common::IsPow2(alignment));
+  u8*& free_code_ptr = s_is_background_compile_thread ? s_background_compile_worker.free_code_ptr : s_free_code_ptr;
+  u32& code_used = s_is_background_compile_thread ? s_background_compile_worker.code_used : s_code_used;
   const u32 num_padding_bytes =
-    std::min(static_cast<u32>(Common::AlignUpPow2(reinterpret_cast<uintptr_t>(s_free_code_ptr), alignment) -
-                              reinterpret_cast<uintptr_t>(s_free_code_ptr)),
+    std::min(static_cast<u32>(Common::AlignUpPow2(reinterpret_cast<uintptr_t>(free_code_ptr), alignment) -
+                              reinterpret_cast<uintptr_t>(free_code_ptr)),
              GetFreeCodeSpace());
 
   if (num_padding_bytes > 0)
-    EmitAlignmentPadding(s_free_code_ptr, num_padding_bytes);
+    EmitAlignmentPadding(free_code_ptr, num_padding_bytes);
 
-  s_free_code_ptr += num_padding_bytes;
-  s_code_used += num_padding_bytes;
+  free_code_ptr += num_padding_bytes;
+  code_used += num_padding_bytes;
 }
 
 const void* CPU::CodeCache::GetInterpretUncachedBlockFunction()
@@ -1545,6 +2377,8 @@ void CPU::CodeCache::CompileASMFunctions()
   s_total_instructions_compiled = 0;
   s_total_host_instructions_emitted = 0;
   s_total_host_code_used_by_instructions = 0;
+  s_total_superblock_instructions_compiled = 0;
+  s_total_superblock_host_instructions_emitted = 0;
 #endif
 
   const u32 asm_size = EmitASMFunctions(GetFreeCodePointer(), GetFreeCodeSpace());
@@ -1557,7 +2391,7 @@ void CPU::CodeCache::CompileASMFunctions()
   MemMap::EndCodeWrite();
 }
 
-bool CPU::CodeCache::CompileBlock(Block* block)
+bool CPU::CodeCache::CompileBlock(Block* block, const SpeculativeRegisterSnapshot* snapshot, Block* target_block)
 {
   const void* host_code = nullptr;
   u32 host_code_size = 0;
@@ -1565,7 +2399,10 @@ bool CPU::CodeCache::CompileBlock(Block* block)
 
 #ifdef ENABLE_RECOMPILER
   if (g_settings.cpu_execution_mode == CPUExecutionMode::Recompiler)
-    host_code = g_compiler->CompileBlock(block, &host_code_size, &host_far_code_size);
+  {
+    auto* const compiler = s_is_background_compile_thread ? g_background_compiler : g_compiler;
+    host_code = compiler->CompileBlock(block, &host_code_size, &host_far_code_size, snapshot, target_block);
+  }
 #endif
 
   block->host_code = host_code;
@@ -1578,6 +2415,8 @@ bool CPU::CodeCache::CompileBlock(Block* block)
     return false;
   }
 
+  s_blocks_compiled.fetch_add(1, std::memory_order_relaxed);
+
 #ifdef DUMP_CODE_SIZE_STATS
   const u32 host_instructions = GetHostInstructionCount(host_code, host_code_size);
   s_total_instructions_compiled += block->size;
@@ -1594,6 +2433,22 @@ bool CPU::CodeCache::CompileBlock(Block* block)
     static_cast<float>(s_total_host_instructions_emitted) / static_cast<float>(s_total_instructions_compiled),
     static_cast<float>(block->host_code_size) / static_cast<float>(block->size),
     static_cast<float>(s_total_host_code_used_by_instructions) / static_cast<float>(s_total_instructions_compiled));
+
+  // Compare host instructions per guest instruction between superblocks and the rest, to see what merging saves.
+  if (block->HasFlag(BlockFlags::IsSuperblock))
+  {
+    s_total_superblock_instructions_compiled += block->size;
+    s_total_superblock_host_instructions_emitted += host_instructions;
+  }
+  if (s_total_superblock_instructions_compiled > 0 &&
+      s_total_instructions_compiled > s_total_superblock_instructions_compiled)
+  {
+    DEV_LOG("ipi: superblocks {:.2f}, other blocks {:.2f}",
+            static_cast<float>(s_total_superblock_host_instructions_emitted) /
+              static_cast<float>(s_total_superblock_instructions_compiled),
+            static_cast<float>(s_total_host_instructions_emitted - s_total_superblock_host_instructions_emitted) /
+              static_cast<float>(s_total_instructions_compiled - s_total_superblock_instructions_compiled));
+  }
 #endif
 
 #if 0
@@ -1631,10 +2486,6 @@ void CPU::CodeCache::AddLoadStoreInfo(void* code_address, u32 code_size, u32 gue
   DebugAssert(code_size < std::numeric_limits<u8>::max());
   DebugAssert(cycles >= 0 && cycles < std::numeric_limits<u16>::max());
 
-  auto iter = s_fastmem_backpatch_info.find(code_address);
-  if (iter != s_fastmem_backpatch_info.end())
-    s_fastmem_backpatch_info.erase(iter);
-
   LoadstoreBackpatchInfo info;
   info.thunk_address = nullptr;
   info.guest_pc = guest_pc;
@@ -1647,7 +2498,12 @@ void CPU::CodeCache::AddLoadStoreInfo(void* code_address, u32 code_size, u32 gue
   info.is_signed = is_signed;
   info.is_load = is_load;
   info.code_size = static_cast<u8>(code_size);
-  s_fastmem_backpatch_info.emplace(code_address, info);
+
+  // Added when the block is linked in, the fault handler may be looking at the map.
+  if (s_is_background_compile_thread)
+    s_background_compile_worker.result->backpatch_info.emplace_back(code_address, info);
+  else
+    s_fastmem_backpatch_info.insert_or_assign(code_address, info);
 }
 
 PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(void* exception_pc, void* fault_address,
@@ -1670,8 +2526,10 @@ PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(void* exc
 
     // if we're writing to ram, let it go through a few times, and use manual block protection to sort it out
     // TODO: path for manual protection to return back to read-only pages
+    // with sub-page invalidation, backpatch the store instead, the memory handler checks which blocks it overlaps
     if (!g_state.cop0_regs.sr.Isc && GetSegmentForAddress(guest_address) != CPU::Segment::KSEG2 &&
-        AddressInRAM(guest_address))
+        AddressInRAM(guest_address) &&
+        (!g_settings.cpu_recompiler_subpage_invalidation || !HasBackpatchInfo(exception_pc)))
     {
       DebugAssert(is_write);
       DEV_LOG("Ignoring fault due to RAM write @ 0x{:08X}", guest_address);
@@ -1686,6 +2544,7 @@ PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(void* exc
     guest_address = std::numeric_limits<PhysicalMemoryAddress>::max();
   }
 
+  const BackgroundCompileLock lock = LockBackgroundCompile();
   auto iter = s_fastmem_backpatch_info.find(exception_pc);
   if (iter == s_fastmem_backpatch_info.end())
     return PageFaultHandler::HandlerResult::ExecuteNextHandler;
@@ -1727,7 +2586,9 @@ PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(void* exc
 
 bool CPU::CodeCache::HasPreviouslyFaultedOnPC(u32 guest_pc)
 {
-  return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
+  const std::unordered_set<u32>& pcs =
+    s_is_background_compile_thread ? s_background_compile_worker.fastmem_faulting_pcs : s_fastmem_faulting_pcs;
+  return (pcs.find(guest_pc) != pcs.end());
 }
 
 void CPU::CodeCache::BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchInfo& info)
@@ -1738,6 +2599,12 @@ void CPU::CodeCache::BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchI
 #endif
 }
 
+bool CPU::CodeCache::HasBackpatchInfo(const void* host_pc)
+{
+  const BackgroundCompileLock lock = LockBackgroundCompile();
+  return s_fastmem_backpatch_info.contains(host_pc);
+}
+
 void CPU::CodeCache::RemoveBackpatchInfoForRange(const void* host_code, u32 size)
 {
   const u8* start = static_cast<const u8*>(host_code);
@@ -1761,3 +2628,264 @@ void CPU::CodeCache::RemoveBackpatchInfoForRange(const void* host_code, u32 size
   // erase the whole range at once
   s_fastmem_backpatch_info.erase(start_iter, end_iter);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Block Cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string CPU::CodeCache::GetBlockCachePath()
+{
+  const std::string& serial = System::GetGameSerial();
+  return Path::Combine(EmuFolders::Cache,
+                       TinyString::from_format("blockcache" FS_OSPATH_SEPARATOR_STR "{}_{:016X}.bin",
+                                               serial.empty() ? std::string_view("Unknown") : std::string_view(serial),
+                                               System::GetGameHash()));
+}
+
+const u8* CPU::CodeCache::GetBlockCacheCodePointer(u32 pc, u32 size)
+{
+  const PhysicalMemoryAddress phys_addr = VirtualAddressToPhysical(pc);
+  const u32 code_size = size * sizeof(Instruction);
+  if (AddressInRAM(pc))
+    return ((phys_addr + code_size) <= Bus::g_ram_size) ? (Bus::g_ram + phys_addr) : nullptr;
+  else if (phys_addr >= Bus::BIOS_BASE && (phys_addr - Bus::BIOS_BASE + code_size) <= Bus::BIOS_SIZE)
+    return Bus::g_bios + (phys_addr - Bus::BIOS_BASE);
+  else
+    return nullptr;
+}
+
+void CPU::CodeCache::AddCompiledBlocksToBlockCache()
+{
+  for (const Block* block : s_blocks)
+  {
+    // Only blocks which actually made it to host code, and weren't since modified.
+    // Superblocks aren't contiguous, they'll get promoted again once they're hot.
+    if (block->size == 0 || !block->host_code || block->state != BlockState::Valid ||
+        block->HasFlag(BlockFlags::IsSuperblock) || block->block_cache_session != s_block_cache_session)
+    {
+      continue;
+    }
+
+    const u64 hash = XXH3_64bits_withSeed(block->Instructions(), block->size * sizeof(Instruction), block->pc);
+    if (const auto it = s_block_cache_hashes.find(hash); it != s_block_cache_hashes.end())
+    {
+      s_block_cache_used[it->second] = true;
+      continue;
+    }
+
+    if (s_block_cache_entries.size() >= MAX_BLOCK_CACHE_ENTRIES)
+    {
+      s_block_cache_dropped_blocks++;
+      continue;
+    }
+
+    s_block_cache_hashes.emplace(hash, static_cast<u32>(s_block_cache_entries.size()));
+    s_block_cache_entries.push_back(BlockCacheEntry{block->pc, block->size, hash, 0, 0});
+    s_block_cache_used.push_back(true);
+  }
+}
+
+void CPU::CodeCache::ResetBlockCachePending()
+{
+  s_block_cache_pending.resize(s_block_cache_entries.size());
+  for (u32 i = 0; i < static_cast<u32>(s_block_cache_entries.size()); i++)
+    s_block_cache_pending[i] = i;
+  s_block_cache_scan_position = 0;
+}
+
+void CPU::CodeCache::LoadBlockCache()
+{
+  s_block_cache_path = {};
+  s_block_cache_entries.clear();
+  s_block_cache_used.clear();
+  s_block_cache_hashes.clear();
+  s_block_cache_pending.clear();
+  s_block_cache_scan_position = 0;
+  s_block_cache_dropped_blocks = 0;
+  s_block_cache_session++;
+
+  // Without a serial or hash, the BIOS and any unidentified discs would all share the same cache.
+  if (!g_settings.cpu_recompiler_block_cache || !IsUsingRecompiler() ||
+      (System::GetGameSerial().empty() && System::GetGameHash() == 0))
+  {
+    return;
+  }
+
+  s_block_cache_path = GetBlockCachePath();
+
+  Error error;
+  std::optional<DynamicHeapArray<u8>> data = FileSystem::ReadBinaryFile(s_block_cache_path.c_str(), &error);
+  if (!data.has_value())
+  {
+    DEV_LOG("No block cache at {}: {}", Path::GetFileName(s_block_cache_path), error.GetDescription());
+    return;
+  }
+
+  BlockCacheHeader header = {};
+  if (data->size() >= sizeof(header))
+    std::memcpy(&header, data->data(), sizeof(header));
+  if (header.signature != BLOCK_CACHE_SIGNATURE || header.version != BLOCK_CACHE_VERSION ||
+      header.num_entries > MAX_BLOCK_CACHE_ENTRIES ||
+      data->size() < (sizeof(header) + (sizeof(BlockCacheEntry) * header.num_entries)))
+  {
+    WARNING_LOG("Block cache {} is invalid or from an older version, ignoring.", Path::GetFileName(s_block_cache_path));
+    return;
+  }
+
+  s_block_cache_entries.resize(header.num_entries);
+  std::memcpy(s_block_cache_entries.data(), data->data() + sizeof(header),
+              sizeof(BlockCacheEntry) * header.num_entries);
+  s_block_cache_used.resize(header.num_entries, false);
+  for (u32 i = 0; i < header.num_entries; i++)
+    s_block_cache_hashes.emplace(s_block_cache_entries[i].hash, i);
+
+  ResetBlockCachePending();
+  INFO_LOG("Loaded {} blocks from {}", s_block_cache_entries.size(), Path::GetFileName(s_block_cache_path));
+}
+
+void CPU::CodeCache::SaveBlockCache()
+{
+  if (s_block_cache_path.empty())
+    return;
+
+  {
+    const BackgroundCompileLock lock = LockBackgroundCompile();
+    AddCompiledBlocksToBlockCache();
+  }
+
+  if (s_block_cache_dropped_blocks > 0)
+  {
+    WARNING_LOG("Block cache is full at {} blocks, {} compiled blocks were not added.", MAX_BLOCK_CACHE_ENTRIES,
+                s_block_cache_dropped_blocks);
+  }
+
+  // Age entries whose code never showed up this session, and drop the ones which haven't been seen in a while.
+  std::vector<BlockCacheEntry> entries;
+  entries.reserve(s_block_cache_entries.size());
+  for (size_t i = 0; i < s_block_cache_entries.size(); i++)
+  {
+    BlockCacheEntry entry = s_block_cache_entries[i];
+    entry.unused_sessions = s_block_cache_used[i] ? 0 : (entry.unused_sessions + 1);
+    if (entry.unused_sessions <= MAX_BLOCK_CACHE_UNUSED_SESSIONS)
+      entries.push_back(entry);
+  }
+
+  const size_t num_pruned = s_block_cache_entries.size() - entries.size();
+  if (entries.empty())
+  {
+    if (num_pruned > 0 && !FileSystem::DeleteFile(s_block_cache_path.c_str()))
+      ERROR_LOG("Failed to delete block cache {}", Path::GetFileName(s_block_cache_path));
+    return;
+  }
+
+  const BlockCacheHeader header = {BLOCK_CACHE_SIGNATURE, BLOCK_CACHE_VERSION, static_cast<u32>(entries.size()), 0};
+  DynamicHeapArray<u8> data(sizeof(header) + (sizeof(BlockCacheEntry) * entries.size()));
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + sizeof(header), entries.data(), sizeof(BlockCacheEntry) * entries.size());
+
+  Error error;
+  if (!FileSystem::EnsureDirectoryExists(std::string(Path::GetDirectory(s_block_cache_path)).c_str(), false, &error) ||
+      !FileSystem::WriteAtomicRenamedFile(s_block_cache_path, data.cspan(), &error))
+  {
+    ERROR_LOG("Failed to write block cache: {}", error.GetDescription());
+    return;
+  }
+
+  INFO_LOG("Saved {} blocks to {}, pruned {} unused blocks", entries.size(), Path::GetFileName(s_block_cache_path),
+           num_pruned);
+}
+
+void CPU::CodeCache::PrecompileCachedBlocks()
+{
+  if (s_block_cache_pending.empty() || !IsUsingRecompiler())
+    return;
+
+  const BackgroundCompileLock lock = LockBackgroundCompile();
+  const bool background = IsUsingBackgroundCompile();
+  const u32 max_compiles = background ? BLOCK_CACHE_BACKGROUND_COMPILES_PER_FRAME : BLOCK_CACHE_COMPILES_PER_FRAME;
+  u32 num_compiles = 0;
+
+  MemMap::BeginCodeWrite();
+
+  for (u32 num_scans = 0; num_scans < BLOCK_CACHE_SCANS_PER_FRAME && !s_block_cache_pending.empty(); num_scans++)
+  {
+    if (s_block_cache_scan_position >= s_block_cache_pending.size())
+      s_block_cache_scan_position = 0;
+
+    const u32 entry_index = s_block_cache_pending[s_block_cache_scan_position];
+    const BlockCacheEntry& entry = s_block_cache_entries[entry_index];
+    bool done = true;
+
+    // Skip regions that never get compiled.
+    const u8* code_ptr;
+    if (HasBlockLUT(entry.pc) && (code_ptr = GetBlockCacheCodePointer(entry.pc, entry.size)) != nullptr)
+    {
+      const bool code_matches =
+        (XXH3_64bits_withSeed(code_ptr, entry.size * sizeof(Instruction), entry.pc) == entry.hash);
+      if (LookupBlock(entry.pc))
+      {
+        // Already hit, possibly before the game changed, so it won't be added again when saving.
+        if (code_matches)
+          s_block_cache_used[entry_index] = true;
+      }
+      else if (!code_matches)
+      {
+        // Code might not be loaded yet, try again later.
+        done = false;
+      }
+      else
+      {
+        s_block_cache_used[entry_index] = true;
+
+        if (!background && (GetFreeCodeSpace() < (entry.size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION) ||
+                            GetFreeCodeSpace() < Recompiler::MIN_CODE_RESERVE_FOR_BLOCK ||
+                            GetFreeFarCodeSpace() < Recompiler::MIN_CODE_RESERVE_FOR_BLOCK))
+        {
+          // Leave the remainder for when they're hit, no point resetting the cache for them.
+          s_block_cache_pending.clear();
+          break;
+        }
+
+        BlockMetadata metadata = {};
+        Block* block;
+        if (ReadBlockInstructions(entry.pc, &s_block_instructions, &metadata) &&
+            s_block_instructions.size() == entry.size &&
+            (block = CreateBlock(entry.pc, s_block_instructions, metadata)) != nullptr && block->size > 0)
+        {
+          DEBUG_LOG("Precompiling cached block at 0x{:08X}", entry.pc);
+          if (background)
+          {
+            QueueBackgroundCompile(block);
+          }
+          else if (CompileBlock(block))
+          {
+            SetCodeLUT(entry.pc, block->host_code);
+            BacklinkBlocks(entry.pc, block->host_code);
+          }
+          else
+          {
+            SetCodeLUT(entry.pc, g_interpret_block);
+            BacklinkBlocks(entry.pc, g_interpret_block);
+          }
+
+          num_compiles++;
+        }
+      }
+    }
+
+    if (done)
+    {
+      s_block_cache_pending[s_block_cache_scan_position] = s_block_cache_pending.back();
+      s_block_cache_pending.pop_back();
+    }
+    else
+    {
+      s_block_cache_scan_position++;
+    }
+
+    if (num_compiles == max_compiles)
+      break;
+  }
+
+  MemMap::EndCodeWrite();
+}
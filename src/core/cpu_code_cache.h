@@ -31,10 +31,41 @@ void Reset();
 /// Free all non-persistent resources for the code cache.
 void Shutdown();
 
+/// Stops the background compiler from starting new blocks while the CPU is not executing.
+void SetBackgroundCompilePaused(bool paused);
+
+/// Loads the list of blocks previously compiled by the running game, if the block cache is enabled.
+void LoadBlockCache();
+
+/// Writes the blocks compiled by the running game to the block cache.
+void SaveBlockCache();
+
+/// Compiles blocks from the block cache whose code is now present in memory. Call once per frame.
+void PrecompileCachedBlocks();
+
 /// Invalidates all blocks which are in the range of the specified code page.
 void InvalidateBlocksWithPageIndex(u32 page_index);
 
+/// Invalidates blocks affected by a write to a RAM code page. With sub-page invalidation enabled, only blocks
+/// overlapping the written region are invalidated, otherwise the whole page is.
+void InvalidateBlocksForRAMWrite(PhysicalMemoryAddress address, u32 size);
+
 /// Invalidates all blocks in the cache.
 void InvalidateAllRAMBlocks();
 
+/// Code cache counters, used for benchmarking. Block counts are totals since startup.
+struct Statistics
+{
+  u32 blocks_created;       // Blocks decoded, including recompiles after invalidation.
+  u32 blocks_compiled;      // Blocks which host code was generated for.
+  u32 blocks_invalidated;   // Valid blocks invalidated by code writes or recompile requests.
+  u32 code_buffer_used;
+  u32 code_buffer_size;
+  u32 far_code_buffer_used;
+  u32 far_code_buffer_size;
+};
+
+/// Returns the current code cache counters.
+void GetStatistics(Statistics* stats);
+
 } // namespace CPU::CodeCache
@@ -5,6 +5,7 @@
 
 #include "bus.h"
 #include "common/bitfield.h"
+#include "common/flat_multimap.h"
 #include "common/perf_scope.h"
 #include "cpu_code_cache.h"
 #include "cpu_core_private.h"
@@ -26,7 +27,7 @@ enum : u32
 
 using CodeLUT = const void**;
 using CodeLUTArray = std::array<CodeLUT, LUT_TABLE_COUNT>;
-using BlockLinkMap = std::unordered_multimap<u32, void*>; // TODO: try ordered?
+using BlockLinkMap = FlatMultiMap<u32, void*>;
 
 enum RegInfoFlags : u8
 {
@@ -46,6 +47,7 @@ struct InstructionInfo
   bool is_load_delay_slot : 1;
   bool is_last_instruction : 1;
   bool has_load_delay : 1;
+  bool is_superblock_branch : 1; // branch target follows the delay slot in the same block
 
   u8 reg_flags[static_cast<u8>(Reg::count)];
   // Reg write_reg[3];
@@ -78,7 +80,8 @@ enum class BlockState : u8
   Valid,
   Invalidated,
   NeedsRecompile,
-  FallbackToInterpreter
+  FallbackToInterpreter,
+  CompilePending, // queued for the background compiler, host_code is set once it's ready to be linked
 };
 
 enum class BlockFlags : u8
@@ -89,6 +92,8 @@ enum class BlockFlags : u8
   BranchDelaySpansPages = (1 << 2),
   IsUsingICache = (1 << 3),
   NeedsDynamicFetchTicks = (1 << 4),
+  SuperblockCandidate = (1 << 5),
+  IsSuperblock = (1 << 6),
 };
 IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(BlockFlags);
 
@@ -99,6 +104,13 @@ enum class PageProtectionMode : u8
   Unprotected,
 };
 
+/// Guest register state captured when a block is queued for background compilation.
+struct SpeculativeRegisterSnapshot
+{
+  std::array<u32, static_cast<u8>(Reg::count)> regs;
+  u32 cop0_sr;
+};
+
 struct BlockMetadata
 {
   TickCount uncached_fetch_ticks;
@@ -115,7 +127,7 @@ struct alignas(16) Block
   // links to previous/next block within page
   Block* next_block_in_page;
 
-  BlockLinkMap::iterator exit_links[MAX_BLOCK_EXIT_LINKS];
+  BlockLinkMap::Handle exit_links[MAX_BLOCK_EXIT_LINKS];
   u8 num_exit_links;
 
   // TODO: Move up so it's part of the same cache line
@@ -130,6 +142,12 @@ struct alignas(16) Block
   u32 compile_frame;
   u8 compile_count;
 
+  // block cache session the block was created in, so blocks from a previous game aren't saved for the current one
+  u16 block_cache_session;
+
+  // decremented by the block prologue for superblock candidates, promoted when it hits zero
+  u32 execution_counter;
+
   // followed by Instruction * size, InstructionRegInfo * size
   ALWAYS_INLINE const Instruction* Instructions() const { return reinterpret_cast<const Instruction*>(this + 1); }
   ALWAYS_INLINE Instruction* Instructions() { return reinterpret_cast<Instruction*>(this + 1); }
@@ -202,8 +220,11 @@ struct PageProtectionInfo
   PageProtectionMode mode;
   u16 invalidate_count;
   u32 invalidate_frame;
+
+  // one bit per CODE_GRANULE_SIZE bytes of the page, set if a block in the list overlaps it
+  u64 code_granules;
 };
-static_assert(sizeof(PageProtectionInfo) == (sizeof(Block*) * 2 + 8));
+static_assert(sizeof(PageProtectionInfo) == (sizeof(Block*) * 2 + 16));
 
 template<PGXPMode pgxp_mode>
 void InterpretCachedBlock(const Block* block);
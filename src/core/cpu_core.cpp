@@ -2625,7 +2625,13 @@ void CPU::Execute()
   CheckForExecutionModeChange();
 
   if (fastjmp_set(&s_locals.exit_jmp_buf) != 0)
+  {
+    // Settings can change outside of execution, don't let the compile thread see them half-applied.
+    CodeCache::SetBackgroundCompilePaused(true);
     return;
+  }
+
+  CodeCache::SetBackgroundCompilePaused(false);
 
   if (g_state.using_interpreter)
     ExecuteInterpreter();
@@ -3158,7 +3164,7 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
         {
           g_unprotected_ram[offset] = Truncate8(value);
           if (g_ram_code_bits[page_index])
-            CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+            CPU::CodeCache::InvalidateBlocksForRAMWrite(offset, sizeof(u8));
         }
       }
       else if constexpr (size == MemoryAccessSize::HalfWord)
@@ -3170,7 +3176,7 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
         {
           std::memcpy(&g_unprotected_ram[offset], &new_value, sizeof(u16));
           if (g_ram_code_bits[page_index])
-            CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+            CPU::CodeCache::InvalidateBlocksForRAMWrite(offset, sizeof(u16));
         }
       }
       else if constexpr (size == MemoryAccessSize::Word)
@@ -3181,7 +3187,7 @@ ALWAYS_INLINE bool CPU::DoSafeMemoryAccess(VirtualMemoryAddress address, u32& va
         {
           std::memcpy(&g_unprotected_ram[offset], &value, sizeof(u32));
           if (g_ram_code_bits[page_index])
-            CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+            CPU::CodeCache::InvalidateBlocksForRAMWrite(offset, sizeof(u32));
         }
       }
     }
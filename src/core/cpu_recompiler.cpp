@@ -76,9 +76,13 @@ void CPU::Recompiler::Recompiler::BeginBlock()
   {
     DEBUG_LOG("Generate manual protection for PC {:08X}", m_block->pc);
     const u8* ram_ptr = Bus::g_ram + VirtualAddressToPhysical(m_block->pc);
-    const u8* shadow_ptr = reinterpret_cast<const u8*>(m_block->Instructions());
+    const u8* shadow_ptr = reinterpret_cast<const u8*>(m_target_block->Instructions());
     GenerateBlockProtectCheck(ram_ptr, shadow_ptr, m_block->size * sizeof(Instruction));
   }
+  else if (m_block->HasFlag(CodeCache::BlockFlags::SuperblockCandidate))
+  {
+    GenerateExecutionCounterCheck(&m_target_block->execution_counter);
+  }
 
   GenerateICacheCheckAndUpdate();
 
@@ -101,12 +105,16 @@ void CPU::Recompiler::Recompiler::BeginBlock()
 }
 
 const void* CPU::Recompiler::Recompiler::CompileBlock(CodeCache::Block* block, u32* host_code_size,
-                                                      u32* host_far_code_size)
+                                                      u32* host_far_code_size,
+                                                      const CodeCache::SpeculativeRegisterSnapshot* snapshot,
+                                                      CodeCache::Block* target_block)
 {
   CodeCache::AlignCode(FUNCTION_ALIGNMENT);
 
+  m_speculative_snapshot = snapshot;
   Reset(block, CodeCache::GetFreeCodePointer(), CodeCache::GetFreeCodeSpace(), CodeCache::GetFreeFarCodePointer(),
         CodeCache::GetFreeFarCodeSpace());
+  m_target_block = target_block ? target_block : block;
 
   DEBUG_LOG("Block range: {:08X} -> {:08X}", block->pc, block->pc + block->size * 4);
 
@@ -144,6 +152,8 @@ const void* CPU::Recompiler::Recompiler::CompileBlock(CodeCache::Block* block, u
 
   u32 code_size, far_code_size;
   const void* code = EndCompile(&code_size, &far_code_size);
+  m_speculative_snapshot = nullptr;
+  m_target_block = nullptr;
   *host_code_size = code_size;
   *host_far_code_size = far_code_size;
   CodeCache::CommitCode(code_size);
@@ -1369,6 +1379,18 @@ void CPU::Recompiler::Recompiler::CompileBranchDelaySlot(bool dirty_pc /* = true
   m_current_instruction_branch_delay_slot = false;
 }
 
+void CPU::Recompiler::Recompiler::ContinueSuperblock(u32 newpc)
+{
+  // Leave at the jump target when an event is due, the same as if the block had ended here.
+  GenerateSuperblockEventCheck(newpc);
+
+  // Registers and constants stay live across the jump, only the PC needs fixing up.
+  // The main loop advances past the delay slot, so pretend it was the instruction before the target.
+  DEBUG_LOG("Continuing superblock at {:08X}", newpc);
+  m_current_instruction_pc = newpc - sizeof(Instruction);
+  m_compiler_pc = newpc;
+}
+
 void CPU::Recompiler::Recompiler::CompileTemplate(void (Recompiler::*const_func)(CompileFlags),
                                                   void (Recompiler::*func)(CompileFlags), const void* pgxp_cpu_func,
                                                   u32 tflags)
@@ -1715,9 +1737,13 @@ void CPU::Recompiler::Recompiler::CompileLoadStoreTemplate(
       GetSegmentForAddress(spec_addr.value()) != Segment::KSEG2)
   {
     // Get rid of physical aliases.
+    // Superblocks aren't contiguous, but they're always contained within a single page.
     const u32 phys_spec_addr = VirtualAddressToPhysical(spec_addr.value());
-    if (phys_spec_addr >= VirtualAddressToPhysical(m_compiler_pc) &&
-        phys_spec_addr < VirtualAddressToPhysical(m_block->pc + (m_block->size * sizeof(Instruction))))
+    if (m_block->HasFlag(CodeCache::BlockFlags::IsSuperblock) ?
+          (Bus::IsRAMAddress(phys_spec_addr) &&
+           Bus::GetRAMCodePageIndex(phys_spec_addr) == Bus::GetRAMCodePageIndex(m_block->pc)) :
+          (phys_spec_addr >= VirtualAddressToPhysical(m_compiler_pc) &&
+           phys_spec_addr < VirtualAddressToPhysical(m_block->pc + (m_block->size * sizeof(Instruction)))))
     {
       WARNING_LOG("Instruction {:08X} speculatively writes to {:08X} inside block {:08X}-{:08X}. Truncating block.",
                   m_current_instruction_pc, phys_spec_addr, m_block->pc,
@@ -1729,7 +1755,7 @@ void CPU::Recompiler::Recompiler::CompileLoadStoreTemplate(
 
 void CPU::Recompiler::Recompiler::TruncateBlock()
 {
-  m_block->size = ((m_current_instruction_pc - m_block->pc) / sizeof(Instruction)) + 1;
+  m_block->size = static_cast<u32>(iinfo - m_block->InstructionsInfo()) + 1;
   iinfo->is_last_instruction = true;
 }
 
@@ -1783,11 +1809,15 @@ void CPU::Recompiler::Recompiler::CompileMoveRegTemplate(Reg dst, Reg src, bool
 void CPU::Recompiler::Recompiler::Compile_j()
 {
   const u32 newpc = (m_compiler_pc & UINT32_C(0xF0000000)) | (inst->j.target << 2);
+  const bool superblock_branch = iinfo->is_superblock_branch;
 
   // TODO: Delay slot swap.
   // We could also move the cycle commit back.
   CompileBranchDelaySlot();
-  EndBlock(newpc, true);
+  if (superblock_branch)
+    ContinueSuperblock(newpc);
+  else
+    EndBlock(newpc, true);
 }
 
 void CPU::Recompiler::Recompiler::Compile_jr_const(CompileFlags cf)
@@ -1807,9 +1837,13 @@ void CPU::Recompiler::Recompiler::Compile_jr_const(CompileFlags cf)
 void CPU::Recompiler::Recompiler::Compile_jal()
 {
   const u32 newpc = (m_compiler_pc & UINT32_C(0xF0000000)) | (inst->j.target << 2);
+  const bool superblock_branch = iinfo->is_superblock_branch;
   SetConstantReg(Reg::ra, GetBranchReturnAddress({}));
   CompileBranchDelaySlot();
-  EndBlock(newpc, true);
+  if (superblock_branch)
+    ContinueSuperblock(newpc);
+  else
+    EndBlock(newpc, true);
 }
 
 void CPU::Recompiler::Recompiler::Compile_jalr_const(CompileFlags cf)
@@ -2379,10 +2413,21 @@ void CPU::Recompiler::BackpatchLoadStore(void* exception_pc, const CodeCache::Lo
 
 void CPU::Recompiler::Recompiler::InitSpeculativeRegs()
 {
-  for (u8 i = 0; i < static_cast<u8>(Reg::count); i++)
-    m_speculative_constants.regs[i] = g_state.regs.r[i];
+  if (m_speculative_snapshot)
+  {
+    for (u8 i = 0; i < static_cast<u8>(Reg::count); i++)
+      m_speculative_constants.regs[i] = m_speculative_snapshot->regs[i];
+
+    m_speculative_constants.cop0_sr = m_speculative_snapshot->cop0_sr;
+  }
+  else
+  {
+    for (u8 i = 0; i < static_cast<u8>(Reg::count); i++)
+      m_speculative_constants.regs[i] = g_state.regs.r[i];
+
+    m_speculative_constants.cop0_sr = g_state.cop0_regs.sr.bits;
+  }
 
-  m_speculative_constants.cop0_sr = g_state.cop0_regs.sr.bits;
   m_speculative_constants.memory.clear();
 }
 
@@ -2428,6 +2473,10 @@ CPU::Recompiler::Recompiler::SpecValue CPU::Recompiler::Recompiler::SpecReadMem(
   if (it != m_speculative_constants.memory.end())
     return it->second;
 
+  // RAM/scratchpad are being modified by the CPU thread while we compile in the background.
+  if (m_speculative_snapshot)
+    return std::nullopt;
+
   u32 value;
   if ((address & SCRATCHPAD_ADDR_MASK) == SCRATCHPAD_ADDR)
   {
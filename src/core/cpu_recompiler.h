@@ -99,7 +99,10 @@ public:
   Recompiler();
   virtual ~Recompiler();
 
-  const void* CompileBlock(CodeCache::Block* block, u32* host_code_size, u32* host_far_code_size);
+  /// When compiling from a copy of the block, target_block is the block the generated code refers to.
+  const void* CompileBlock(CodeCache::Block* block, u32* host_code_size, u32* host_far_code_size,
+                           const CodeCache::SpeculativeRegisterSnapshot* snapshot = nullptr,
+                           CodeCache::Block* target_block = nullptr);
 
   static void BackpatchLoadStore(void* exception_pc, const CodeCache::LoadstoreBackpatchInfo& info);
 
@@ -269,6 +272,7 @@ protected:
   bool TrySwapDelaySlot(Reg rs = Reg::zero, Reg rt = Reg::zero, Reg rd = Reg::zero);
   void SetCompilerPC(u32 newpc);
   void TruncateBlock();
+  void ContinueSuperblock(u32 newpc);
 
   const TickCount* GetFetchMemoryAccessTimePtr() const;
 
@@ -279,6 +283,8 @@ protected:
   virtual void BeginBlock();
   virtual void GenerateBlockProtectCheck(const u8* ram_ptr, const u8* shadow_ptr, u32 size) = 0;
   virtual void GenerateICacheCheckAndUpdate() = 0;
+  virtual void GenerateExecutionCounterCheck(u32* counter) = 0;
+  virtual void GenerateSuperblockEventCheck(u32 newpc) = 0;
   virtual void GenerateCall(const void* func, s32 arg1reg = -1, s32 arg2reg = -1, s32 arg3reg = -1) = 0;
   virtual void EndBlock(const std::optional<u32>& newpc, bool do_event_test) = 0;
   virtual void EndBlockWithException(Exception excode) = 0;
@@ -472,6 +478,7 @@ protected:
   static std::pair<u32*, GTERegisterAccessAction> GetGTERegisterPointer(u32 index, bool writing);
 
   CodeCache::Block* m_block = nullptr;
+  CodeCache::Block* m_target_block = nullptr;
   u32 m_compiler_pc = 0;
   TickCount m_cycles = 0;
   TickCount m_gte_done_cycle = 0;
@@ -554,6 +561,9 @@ protected:
 
   SpeculativeConstants m_speculative_constants;
 
+  // Set when compiling off the CPU thread, guest memory can't be read speculatively then.
+  const CodeCache::SpeculativeRegisterSnapshot* m_speculative_snapshot = nullptr;
+
   void SpecExec_b();
   void SpecExec_jal();
   void SpecExec_jalr();
@@ -601,4 +611,7 @@ protected:
 };
 
 extern Recompiler* g_compiler;
+
+// Separate instance for the background compile thread, so it can compile while the CPU thread does.
+extern Recompiler* g_background_compiler;
 } // namespace CPU
@@ -15,6 +15,7 @@
 #include "common/string_util.h"
 
 #include <limits>
+#include <mutex>
 
 #ifdef CPU_ARCH_ARM32
 
@@ -57,12 +58,17 @@ static std::unordered_map<const void*, u32> s_trampoline_targets;
 static u8* s_trampoline_start_ptr = nullptr;
 static u32 s_trampoline_used = 0;
 
+// Trampolines are shared between the CPU thread and the background compile thread.
+static std::mutex s_trampoline_mutex;
+
 namespace CPU {
 
 using namespace vixl::aarch32;
 
 static ARM32Recompiler s_instance;
 Recompiler* g_compiler = &s_instance;
+static ARM32Recompiler s_background_instance;
+Recompiler* g_background_compiler = &s_background_instance;
 
 } // namespace CPU
 
@@ -219,6 +225,7 @@ u32 CPU::CodeCache::EmitJump(void* code, const void* dst, bool flush_icache)
 
 u8* armGetJumpTrampoline(const void* target)
 {
+  const std::lock_guard lock(s_trampoline_mutex);
   auto it = s_trampoline_targets.find(target);
   if (it != s_trampoline_targets.end())
     return s_trampoline_start_ptr + it->second;
@@ -303,6 +310,12 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     armAsm->ldr(RARG1, PTR(&g_state.pc));
     armEmitCall(armAsm, reinterpret_cast<const void*>(&CompileOrRevalidateBlock), true);
+
+    // Block may have been interpreted while it is compiled in the background.
+    armAsm->ldr(RARG1, PTR(&g_state.pending_ticks));
+    armAsm->ldr(RARG2, PTR(&g_state.downcount));
+    armAsm->cmp(RARG1, RARG2);
+    armAsm->b(ge, &run_events_and_dispatch);
     armAsm->b(&dispatch);
   }
 
@@ -310,6 +323,12 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     armAsm->ldr(RARG1, PTR(&g_state.pc));
     armEmitCall(armAsm, reinterpret_cast<const void*>(&DiscardAndRecompileBlock), true);
+
+    // Block may have been interpreted while it is recompiled in the background.
+    armAsm->ldr(RARG1, PTR(&g_state.pending_ticks));
+    armAsm->ldr(RARG2, PTR(&g_state.downcount));
+    armAsm->cmp(RARG1, RARG2);
+    armAsm->b(ge, &run_events_and_dispatch);
     armAsm->b(&dispatch);
   }
 
@@ -597,6 +616,35 @@ bool foo(const void* a, const void* b)
   armAsm->bind(&block_unchanged);
 }
 
+void CPU::ARM32Recompiler::GenerateExecutionCounterCheck(u32* counter)
+{
+  armMoveAddressToReg(armAsm, RARG1, counter);
+  armAsm->ldr(RARG2, MemOperand(RARG1));
+  armAsm->subs(RARG2, RARG2, 1);
+  armAsm->str(RARG2, MemOperand(RARG1));
+
+  Label counter_nonzero;
+  armAsm->b(ne, &counter_nonzero);
+  armEmitJmp(armAsm, CodeCache::g_discard_and_recompile_block, false);
+  armAsm->bind(&counter_nonzero);
+}
+
+void CPU::ARM32Recompiler::GenerateSuperblockEventCheck(u32 newpc)
+{
+  // if ((pending_ticks + cycles) >= downcount) { end block at newpc; }
+  armAsm->ldr(RARG1, PTR(&g_state.pending_ticks));
+  armAsm->ldr(RARG2, PTR(&g_state.downcount));
+  if (m_cycles > 0)
+    armAsm->add(RARG1, RARG1, armCheckAddSubConstant(m_cycles));
+  armAsm->cmp(RARG1, RARG2);
+  SwitchToFarCode(true, ge);
+
+  BackupHostState();
+  EndBlock(newpc, true);
+  RestoreHostState();
+  SwitchToNearCode(false);
+}
+
 void CPU::ARM32Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -15,6 +15,7 @@
 #include "common/string_util.h"
 
 #include <limits>
+#include <mutex>
 
 #ifdef CPU_ARCH_ARM64
 
@@ -61,12 +62,17 @@ static std::unordered_map<const void*, u32> s_trampoline_targets;
 static u8* s_trampoline_start_ptr = nullptr;
 static u32 s_trampoline_used = 0;
 
+// Trampolines are shared between the CPU thread and the background compile thread.
+static std::mutex s_trampoline_mutex;
+
 namespace CPU {
 
 using namespace vixl::aarch64;
 
 static ARM64Recompiler s_instance;
 Recompiler* g_compiler = &s_instance;
+static ARM64Recompiler s_background_instance;
+Recompiler* g_background_compiler = &s_background_instance;
 
 } // namespace CPU
 
@@ -355,6 +361,7 @@ void armEmitFarLoad(vixl::aarch64::Assembler* armAsm, const vixl::aarch64::Regis
 
 u8* armGetJumpTrampoline(const void* target)
 {
+  const std::lock_guard lock(s_trampoline_mutex);
   auto it = s_trampoline_targets.find(target);
   if (it != s_trampoline_targets.end())
     return s_trampoline_start_ptr + it->second;
@@ -508,6 +515,12 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     armAsm->ldr(RWARG1, PTR(&g_state.pc));
     armEmitCall(armAsm, reinterpret_cast<const void*>(&CompileOrRevalidateBlock), true);
+
+    // Block may have been interpreted while it is compiled in the background.
+    armAsm->ldr(RWARG1, PTR(&g_state.pending_ticks));
+    armAsm->ldr(RWARG2, PTR(&g_state.downcount));
+    armAsm->cmp(RWARG1, RWARG2);
+    armAsm->b(&run_events_and_dispatch, ge);
     armAsm->b(&dispatch);
   }
 
@@ -516,6 +529,12 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     armAsm->ldr(RWARG1, PTR(&g_state.pc));
     armEmitCall(armAsm, reinterpret_cast<const void*>(&DiscardAndRecompileBlock), true);
+
+    // Block may have been interpreted while it is recompiled in the background.
+    armAsm->ldr(RWARG1, PTR(&g_state.pending_ticks));
+    armAsm->ldr(RWARG2, PTR(&g_state.downcount));
+    armAsm->cmp(RWARG1, RWARG2);
+    armAsm->b(&run_events_and_dispatch, ge);
     armAsm->b(&dispatch);
   }
 
@@ -784,6 +803,35 @@ void CPU::ARM64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, const u8
   armAsm->bind(&block_unchanged);
 }
 
+void CPU::ARM64Recompiler::GenerateExecutionCounterCheck(u32* counter)
+{
+  armMoveAddressToReg(armAsm, RXARG1, counter);
+  armAsm->ldr(RWARG2, MemOperand(RXARG1));
+  armAsm->subs(RWARG2, RWARG2, 1);
+  armAsm->str(RWARG2, MemOperand(RXARG1));
+
+  Label counter_nonzero;
+  armAsm->b(&counter_nonzero, ne);
+  armEmitJmp(armAsm, CodeCache::g_discard_and_recompile_block, false);
+  armAsm->bind(&counter_nonzero);
+}
+
+void CPU::ARM64Recompiler::GenerateSuperblockEventCheck(u32 newpc)
+{
+  // if ((pending_ticks + cycles) >= downcount) { end block at newpc; }
+  armAsm->ldr(RWARG1, PTR(&g_state.pending_ticks));
+  armAsm->ldr(RWARG2, PTR(&g_state.downcount));
+  if (m_cycles > 0)
+    armAsm->add(RWARG1, RWARG1, armCheckAddSubConstant(m_cycles));
+  armAsm->cmp(RWARG1, RWARG2);
+  SwitchToFarCode(true, ge);
+
+  BackupHostState();
+  EndBlock(newpc, true);
+  RestoreHostState();
+  SwitchToNearCode(false);
+}
+
 void CPU::ARM64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
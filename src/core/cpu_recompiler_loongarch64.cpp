@@ -57,6 +57,8 @@ using namespace CPU;
 
 LoongArch64Recompiler s_instance;
 Recompiler* g_compiler = &s_instance;
+LoongArch64Recompiler s_background_instance;
+Recompiler* g_background_compiler = &s_background_instance;
 
 } // namespace CPU
 
@@ -266,6 +268,11 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     la_ld_w(laAsm, RARG1, RSTATE, OFFS(&g_state.pc));
     laEmitCall(laAsm, reinterpret_cast<const void*>(&CompileOrRevalidateBlock));
+
+    // Block may have been interpreted while it is compiled in the background.
+    la_ld_w(laAsm, RARG1, RSTATE, OFFS(&g_state.pending_ticks));
+    la_ld_w(laAsm, RARG2, RSTATE, OFFS(&g_state.downcount));
+    la_bge(laAsm, RARG1, RARG2, la_label(laAsm, &run_events_and_dispatch));
     la_b(laAsm, la_label(laAsm, &dispatch));
   }
 
@@ -273,6 +280,11 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     la_ld_w(laAsm, RARG1, RSTATE, OFFS(&g_state.pc));
     laEmitCall(laAsm, reinterpret_cast<const void*>(&DiscardAndRecompileBlock));
+
+    // Block may have been interpreted while it is recompiled in the background.
+    la_ld_w(laAsm, RARG1, RSTATE, OFFS(&g_state.pending_ticks));
+    la_ld_w(laAsm, RARG2, RSTATE, OFFS(&g_state.downcount));
+    la_bge(laAsm, RARG1, RARG2, la_label(laAsm, &run_events_and_dispatch));
     la_b(laAsm, la_label(laAsm, &dispatch));
   }
 
@@ -553,6 +565,35 @@ void CPU::LoongArch64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, co
   la_label_free(laAsm, &block_unchanged);
 }
 
+void CPU::LoongArch64Recompiler::GenerateExecutionCounterCheck(u32* counter)
+{
+  laEmitMov64(laAsm, RARG1, static_cast<u64>(reinterpret_cast<uintptr_t>(counter)));
+  la_ld_w(laAsm, RARG2, RARG1, 0);
+  la_addi_w(laAsm, RARG2, RARG2, -1);
+  la_st_w(laAsm, RARG2, RARG1, 0);
+
+  lagoon_label_t counter_nonzero = {};
+  la_bnez(laAsm, RARG2, la_label(laAsm, &counter_nonzero));
+  laEmitJmp(laAsm, CodeCache::g_discard_and_recompile_block);
+  la_bind(laAsm, &counter_nonzero);
+  la_label_free(laAsm, &counter_nonzero);
+}
+
+void CPU::LoongArch64Recompiler::GenerateSuperblockEventCheck(u32 newpc)
+{
+  // if ((pending_ticks + cycles) >= downcount) { end block at newpc; }
+  la_ld_w(laAsm, RARG1, RSTATE, OFFS(&g_state.pending_ticks));
+  la_ld_w(laAsm, RARG2, RSTATE, OFFS(&g_state.downcount));
+  if (m_cycles > 0)
+    SafeADDIW(RARG1, RARG1, m_cycles);
+  SwitchToFarCode(true, LaBranchCondition::GE, RARG1, RARG2);
+
+  BackupHostState();
+  EndBlock(newpc, true);
+  RestoreHostState();
+  SwitchToNearCode(false);
+}
+
 void CPU::LoongArch64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -65,6 +65,8 @@ using namespace biscuit;
 
 RISCV64Recompiler s_instance;
 Recompiler* g_compiler = &s_instance;
+RISCV64Recompiler s_background_instance;
+Recompiler* g_background_compiler = &s_background_instance;
 
 } // namespace CPU
 
@@ -297,6 +299,11 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     rvAsm->LW(RARG1, PTR(&g_state.pc));
     rvEmitCall(rvAsm, reinterpret_cast<const void*>(&CompileOrRevalidateBlock));
+
+    // Block may have been interpreted while it is compiled in the background.
+    rvAsm->LW(RARG1, PTR(&g_state.pending_ticks));
+    rvAsm->LW(RARG2, PTR(&g_state.downcount));
+    rvAsm->BGE(RARG1, RARG2, &run_events_and_dispatch);
     rvAsm->J(&dispatch);
   }
 
@@ -304,6 +311,11 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     rvAsm->LW(RARG1, PTR(&g_state.pc));
     rvEmitCall(rvAsm, reinterpret_cast<const void*>(&DiscardAndRecompileBlock));
+
+    // Block may have been interpreted while it is recompiled in the background.
+    rvAsm->LW(RARG1, PTR(&g_state.pending_ticks));
+    rvAsm->LW(RARG2, PTR(&g_state.downcount));
+    rvAsm->BGE(RARG1, RARG2, &run_events_and_dispatch);
     rvAsm->J(&dispatch);
   }
 
@@ -557,6 +569,34 @@ void CPU::RISCV64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, const
   rvAsm->Bind(&block_unchanged);
 }
 
+void CPU::RISCV64Recompiler::GenerateExecutionCounterCheck(u32* counter)
+{
+  rvEmitMov64(rvAsm, RARG1, RSCRATCH, static_cast<u64>(reinterpret_cast<uintptr_t>(counter)));
+  rvAsm->LW(RARG2, 0, RARG1);
+  rvAsm->ADDIW(RARG2, RARG2, -1);
+  rvAsm->SW(RARG2, 0, RARG1);
+
+  Label counter_nonzero;
+  rvAsm->BNEZ(RARG2, &counter_nonzero);
+  rvEmitJmp(rvAsm, CodeCache::g_discard_and_recompile_block);
+  rvAsm->Bind(&counter_nonzero);
+}
+
+void CPU::RISCV64Recompiler::GenerateSuperblockEventCheck(u32 newpc)
+{
+  // if ((pending_ticks + cycles) >= downcount) { end block at newpc; }
+  rvAsm->LW(RARG1, PTR(&g_state.pending_ticks));
+  rvAsm->LW(RARG2, PTR(&g_state.downcount));
+  if (m_cycles > 0)
+    SafeADDIW(RARG1, RARG1, m_cycles);
+  SwitchToFarCode(true, &Assembler::BLT, RARG1, RARG2);
+
+  BackupHostState();
+  EndBlock(newpc, true);
+  RestoreHostState();
+  SwitchToNearCode(false);
+}
+
 void CPU::RISCV64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -34,6 +34,8 @@ protected:
              u32 far_code_space) override;
   void GenerateBlockProtectCheck(const u8* ram_ptr, const u8* shadow_ptr, u32 size) override;
   void GenerateICacheCheckAndUpdate() override;
+  void GenerateExecutionCounterCheck(u32* counter) override;
+  void GenerateSuperblockEventCheck(u32 newpc) override;
   void GenerateCall(const void* func, s32 arg1reg = -1, s32 arg2reg = -1, s32 arg3reg = -1) override;
   void EndBlock(const std::optional<u32>& newpc, bool do_event_test) override;
   void EndBlockWithException(Exception excode) override;
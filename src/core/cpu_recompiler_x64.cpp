@@ -85,6 +85,8 @@ using namespace Xbyak;
 
 static X64Recompiler s_instance;
 Recompiler* g_compiler = &s_instance;
+static X64Recompiler s_background_instance;
+Recompiler* g_background_compiler = &s_background_instance;
 
 } // namespace CPU
 
@@ -169,6 +171,11 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     cg->mov(RWARG1, cg->dword[PTR(&g_state.pc)]);
     cg->call(&CompileOrRevalidateBlock);
+
+    // Block may have been interpreted while it is compiled in the background.
+    cg->mov(RWARG1, cg->dword[PTR(&g_state.pending_ticks)]);
+    cg->cmp(RWARG1, cg->dword[PTR(&g_state.downcount)]);
+    cg->jge(run_events_and_dispatch);
     cg->jmp(dispatch);
   }
 
@@ -177,6 +184,11 @@ u32 CPU::CodeCache::EmitASMFunctions(void* code, u32 code_size)
   {
     cg->mov(RWARG1, cg->dword[PTR(&g_state.pc)]);
     cg->call(&DiscardAndRecompileBlock);
+
+    // Block may have been interpreted while it is recompiled in the background.
+    cg->mov(RWARG1, cg->dword[PTR(&g_state.pending_ticks)]);
+    cg->cmp(RWARG1, cg->dword[PTR(&g_state.downcount)]);
+    cg->jge(run_events_and_dispatch);
     cg->jmp(dispatch);
   }
 
@@ -523,6 +535,28 @@ void CPU::X64Recompiler::GenerateBlockProtectCheck(const u8* ram_ptr, const u8*
   DebugAssert(size == 0);
 }
 
+void CPU::X64Recompiler::GenerateExecutionCounterCheck(u32* counter)
+{
+  cg->mov(RXARG1, static_cast<size_t>(reinterpret_cast<uintptr_t>(counter)));
+  cg->sub(cg->dword[RXARG1], 1);
+  cg->jz(CodeCache::g_discard_and_recompile_block);
+}
+
+void CPU::X64Recompiler::GenerateSuperblockEventCheck(u32 newpc)
+{
+  // if ((pending_ticks + cycles) >= downcount) { end block at newpc; }
+  cg->mov(RWARG1, cg->dword[PTR(&g_state.pending_ticks)]);
+  if (m_cycles > 0)
+    cg->add(RWARG1, m_cycles);
+  cg->cmp(RWARG1, cg->dword[PTR(&g_state.downcount)]);
+  SwitchToFarCode(true, &CodeGenerator::jge);
+
+  BackupHostState();
+  EndBlock(newpc, true);
+  RestoreHostState();
+  SwitchToNearCode(false);
+}
+
 void CPU::X64Recompiler::GenerateICacheCheckAndUpdate()
 {
   if (!m_block->HasFlag(CodeCache::BlockFlags::IsUsingICache))
@@ -3037,6 +3037,16 @@ void FullscreenUI::DrawEmulationSettingsPage()
                               "usage. Especially useful when upscaling."),
                     "GPU", "UseSoftwareRendererForMemoryStates", false, rewind_enabled);
 
+  DrawToggleSetting(bsi, FSUI_ICONVSTR(ICON_FA_MEMORY, "Store Only Changes Between Rewind States"),
+                    FSUI_VSTR("Only the most recent rewind state is kept in full, older states only store the memory "
+                              "that changed. Greatly reduces RAM usage."),
+                    "Main", "RewindDeltaStates", false, rewind_enabled && !runahead_enabled);
+
+  DrawToggleSetting(bsi, FSUI_ICONVSTR(ICON_FA_COMPRESS, "Compress Rewind States"),
+                    FSUI_VSTR("Compresses rewind states on a background thread, reducing RAM usage at the cost of "
+                              "additional CPU usage."),
+                    "Main", "RewindCompressStates", false, rewind_enabled && !runahead_enabled);
+
   DrawFloatRangeSetting(
     bsi, FSUI_ICONVSTR(ICON_FA_FLOPPY_DISK, "Rewind Save Frequency"),
     FSUI_VSTR("How often a rewind state will be created. Higher frequencies have greater system requirements."), "Main",
@@ -3061,6 +3071,10 @@ void FullscreenUI::DrawEmulationSettingsPage()
     FSUI_VSTR("Activates runahead when analog input changes, which significantly increases system requirements."),
     "Main", "RunaheadForAnalogInput", false, runahead_enabled);
 
+  DrawToggleSetting(bsi, FSUI_ICONVSTR(ICON_FA_FORWARD_FAST, "Only Replay From Controller Reads"),
+                    FSUI_VSTR("Skips replaying frames which ran before the game read the controllers."), "Main",
+                    "RunaheadPartialReplay", false, runahead_enabled);
+
   TinyString rewind_summary;
   if (runahead_enabled)
   {
@@ -5376,6 +5390,18 @@ void FullscreenUI::DrawAdvancedSettingsPage()
     bsi, FSUI_VSTR("Enable Recompiler Block Linking"),
     FSUI_VSTR("Performance enhancement - jumps directly between blocks instead of returning to the dispatcher."), "CPU",
     "RecompilerBlockLinking", true);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Background Compilation"),
+                    FSUI_VSTR("Compiles new blocks on a worker thread, interpreting them until the code is ready."),
+                    "CPU", "RecompilerBackgroundCompile", false);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Block Cache"),
+                    FSUI_VSTR("Remembers which blocks each game compiles, and compiles them ahead of time next boot."),
+                    "CPU", "RecompilerBlockCache", false);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Superblocks"),
+                    FSUI_VSTR("Recompiles frequently executed blocks together with the blocks they jump to."), "CPU",
+                    "RecompilerSuperblocks", false);
+  DrawToggleSetting(bsi, FSUI_VSTR("Enable Recompiler Sub-Page Invalidation"),
+                    FSUI_VSTR("Only throws out blocks overlapping a write, instead of every block in the page."), "CPU",
+                    "RecompilerSubPageInvalidation", false);
   DrawEnumSetting(bsi, FSUI_VSTR("Recompiler Fast Memory Access"),
                   FSUI_VSTR("Avoids calls to C++ code, significantly speeding up the recompiler."), "CPU",
                   "FastmemMode", Settings::DEFAULT_CPU_FASTMEM_MODE, &Settings::ParseCPUFastmemMode,
@@ -5388,6 +5414,21 @@ void FullscreenUI::DrawAdvancedSettingsPage()
     FSUI_VSTR("Reduces hitches in emulation by reading/decompressing CD data asynchronously on a worker thread."),
     "CDROM", "ReadaheadSectors", Settings::DEFAULT_CDROM_READAHEAD_SECTORS, 0, 32, FSUI_CSTR("%d sectors"));
 
+  DrawIntRangeSetting(bsi, FSUI_VSTR("Decompression Cache"),
+                      FSUI_VSTR("Number of decompressed blocks of compressed images (e.g. CHD) kept in memory."),
+                      "CDROM", "DecompressionCacheBlocks", Settings::DEFAULT_CDROM_DECOMPRESSION_CACHE_BLOCKS, 1, 64,
+                      FSUI_CSTR("%d blocks"));
+
+  DrawIntRangeSetting(
+    bsi, FSUI_VSTR("Decompression Prefetch"),
+    FSUI_VSTR("Decompresses the blocks following the current read position of compressed images on a worker thread."),
+    "CDROM", "DecompressionPrefetchBlocks", Settings::DEFAULT_CDROM_DECOMPRESSION_PREFETCH_BLOCKS, 0, 16,
+    FSUI_CSTR("%d blocks"));
+
+  DrawToggleSetting(bsi, FSUI_VSTR("Memory Map Images"),
+                    FSUI_VSTR("Reads uncompressed images through a memory mapping. Unstable storage can crash."),
+                    "CDROM", "MemoryMapImages", false);
+
   DrawIntRangeSetting(bsi, FSUI_VSTR("Maximum Seek Speedup Cycles"),
                       FSUI_VSTR("Sets the minimum delay for the 'Maximum' seek speedup level."), "CDROM",
                       "MaxSeekSpeedupCycles", Settings::DEFAULT_CDROM_MAX_SEEK_SPEEDUP_CYCLES, 1, 1000000,
@@ -5403,6 +5444,14 @@ void FullscreenUI::DrawAdvancedSettingsPage()
     FSUI_VSTR("Tries to detect FMVs and disable read speedup during games that don't use XA streaming audio."), "CDROM",
     "DisableSpeedupOnMDEC", false);
 
+  DrawToggleSetting(bsi, FSUI_VSTR("Asynchronous MDEC Decoding"),
+                    FSUI_VSTR("Decodes FMV frames on a worker thread. Output timing is unchanged."), "Hacks",
+                    "MDECAsyncDecode", false);
+
+  DrawToggleSetting(bsi, FSUI_VSTR("Predict SPU RAM IRQ"),
+                    FSUI_VSTR("Generates audio in larger batches while the SPU RAM IRQ is enabled."), "Hacks",
+                    "SPUPredictRAMIRQ", false);
+
   DrawToggleSetting(bsi, FSUI_VSTR("Enable Region Check"),
                     FSUI_VSTR("Simulates the region check present in original, unmodified consoles."), "CDROM",
                     "RegionCheck", false);
@@ -47,7 +47,6 @@ enum : u32
 
 static const Entry* GetEntryForId(std::string_view code);
 
-static void EnsureLoaded();
 static void Load();
 static bool LoadFromCache();
 static bool SaveToCache();
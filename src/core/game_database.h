@@ -201,6 +201,9 @@ struct DiscSetEntry
   std::optional<size_t> GetDiscIndex(std::string_view serial) const;
 };
 
+/// Loads the database if it has not been already, rebuilding the cache file if it is out of date.
+void EnsureLoaded();
+
 const Entry* GetEntryForDisc(CDImage* image);
 const Entry* GetEntryForGameDetails(const std::string& id, u64 hash);
 const Entry* GetEntryForSerial(std::string_view serial);
@@ -30,6 +30,7 @@
 #include "common/progress_callback.h"
 #include "common/string_pool.h"
 #include "common/string_util.h"
+#include "common/task_queue.h"
 #include "common/thirdparty/SmallVector.h"
 #include "common/time_helpers.h"
 #include "common/timer.h"
@@ -41,6 +42,7 @@
 #include <bit>
 #include <ctime>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -57,7 +59,13 @@ namespace {
 enum : u32
 {
   GAME_LIST_CACHE_SIGNATURE = 0x45434C48,
-  GAME_LIST_CACHE_VERSION = 39,
+  GAME_LIST_CACHE_VERSION = 40,
+
+  // Changed files are appended to the cache, it's compacted once the superseded records outnumber the live ones.
+  MIN_STALE_CACHE_RECORDS = 256,
+
+  MAX_SCAN_THREADS = 16,
+  SCAN_FILES_PER_THREAD = 4,
 
   PLAYED_TIME_SERIAL_LENGTH = 32,
   PLAYED_TIME_LAST_TIME_LENGTH = 20,  // uint64
@@ -86,9 +94,29 @@ struct MemcardTimestampCacheEntry
 };
 #pragma pack(pop)
 
+struct CacheEntry
+{
+  Entry entry;
+  s64 scanned_file_size;
+};
+
+struct ScanFileInfo
+{
+  std::string path;
+  std::string path_in_cache;
+  std::time_t timestamp;
+  s64 size;
+};
+
+struct ScanResult
+{
+  Entry entry;
+  bool populated;
+};
+
 } // namespace
 
-using CacheMap = UnorderedStringMap<Entry>;
+using CacheMap = UnorderedStringMap<CacheEntry>;
 using PlayedTimeMap = UnorderedStringMap<PlayedTimeEntry>;
 
 static_assert(std::is_same_v<decltype(Entry::hash), GameHash>);
@@ -106,26 +134,33 @@ static void SetCustomSerialOnEntry(Entry* entry, std::string serial, bool update
 static bool RescanCustomAttributesForPath(const std::string& path, const INISettingsInterface& custom_attributes_ini);
 static void NotifyHostOfEntryChange(const Entry* entry);
 static void PopulateEntryAchievements(Entry* entry, const Achievements::ProgressDatabase& achievements_progress);
-static bool GetGameListEntryFromCache(const std::string& path, Entry* entry,
+static bool GetGameListEntryFromCache(const ScanFileInfo& file, Entry* entry,
                                       const INISettingsInterface& custom_attributes_ini,
                                       const Achievements::ProgressDatabase& achievements_progress);
 static Entry* GetMutableEntryForPath(std::string_view path);
 static void ScanDirectory(const std::string& path, bool recursive, bool only_cache,
                           const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
                           const INISettingsInterface& custom_attributes_ini,
-                          const Achievements::ProgressDatabase& achievements_progress, BinaryFileWriter& cache_writer,
+                          const Achievements::ProgressDatabase& achievements_progress,
+                          UnorderedStringSet& seen_paths, std::vector<ScanFileInfo>& files_to_scan,
                           ProgressCallback* progress);
-static bool AddFileFromCache(const std::string& path, const std::string& path_in_cache, std::time_t timestamp,
-                             const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini,
+static bool AddFileFromCache(const ScanFileInfo& file, const PlayedTimeMap& played_time_map,
+                             const INISettingsInterface& custom_attributes_ini,
                              const Achievements::ProgressDatabase& achievements_progress);
-static void ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                     const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini,
-                     const Achievements::ProgressDatabase& achievements_progress, const std::string& path_for_cache,
-                     BinaryFileWriter& cache_writer);
+static void ScanFiles(std::vector<ScanFileInfo>& files, const PlayedTimeMap& played_time_map,
+                      const INISettingsInterface& custom_attributes_ini,
+                      const Achievements::ProgressDatabase& achievements_progress, BinaryFileWriter& cache_writer,
+                      ProgressCallback* progress);
+static void AddScannedFile(ScanFileInfo& file, ScanResult& result, const PlayedTimeMap& played_time_map,
+                           const INISettingsInterface& custom_attributes_ini,
+                           const Achievements::ProgressDatabase& achievements_progress,
+                           BinaryFileWriter& cache_writer);
 
 static bool LoadOrInitializeCache(std::FILE* fp, bool invalidate_cache);
-static bool LoadEntriesFromCache(BinaryFileReader& reader);
-static bool WriteEntryToCache(const Entry* entry, const std::string& entry_path, BinaryFileWriter& writer);
+static bool LoadEntriesFromCache(BinaryFileReader& reader, size_t* stale_records);
+static bool WriteEntryToCache(const Entry* entry, const std::string& entry_path, s64 scanned_file_size,
+                              BinaryFileWriter& writer);
+static bool RewriteCache(std::FILE* fp);
 static void CreateDiscSetEntries(const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
                                  const INISettingsInterface& custom_attributes_ini);
 static void RefreshDiscSetEntries();
@@ -443,17 +478,25 @@ bool GameList::PopulateEntryFromPath(const std::string& path, Entry* entry)
   return GetDiscListEntry(path, entry);
 }
 
-bool GameList::GetGameListEntryFromCache(const std::string& path, Entry* entry,
+bool GameList::GetGameListEntryFromCache(const ScanFileInfo& file, Entry* entry,
                                          const INISettingsInterface& custom_attributes_ini,
                                          const Achievements::ProgressDatabase& achievements_progress)
 {
+  const std::string& path = file.path_in_cache.empty() ? file.path : file.path_in_cache;
   auto iter = s_state.cache_map.find(path);
   if (iter == s_state.cache_map.end())
     return false;
 
-  *entry = std::move(iter->second);
-  entry->dbentry = GameDatabase::GetEntryForSerial(entry->serial);
+  // the entry gets replaced by a rescan if the file has changed
+  const bool unchanged =
+    (iter->second.entry.last_modified_time == file.timestamp && iter->second.scanned_file_size == file.size);
+  if (unchanged)
+    *entry = std::move(iter->second.entry);
   s_state.cache_map.erase(iter);
+  if (!unchanged)
+    return false;
+
+  entry->dbentry = GameDatabase::GetEntryForSerial(entry->serial);
   ApplyCustomAttributes(path, entry, custom_attributes_ini);
   if (entry->IsDisc())
     PopulateEntryAchievements(entry, achievements_progress);
@@ -461,7 +504,7 @@ bool GameList::GetGameListEntryFromCache(const std::string& path, Entry* entry,
   return true;
 }
 
-bool GameList::LoadEntriesFromCache(BinaryFileReader& reader)
+bool GameList::LoadEntriesFromCache(BinaryFileReader& reader, size_t* stale_records)
 {
   u32 file_signature, file_version;
   if (!reader.ReadU32(&file_signature) || !reader.ReadU32(&file_version) ||
@@ -475,6 +518,7 @@ bool GameList::LoadEntriesFromCache(BinaryFileReader& reader)
   {
     std::string path;
     Entry ge;
+    s64 scanned_file_size;
 
     u8 type;
     u8 region;
@@ -482,7 +526,8 @@ bool GameList::LoadEntriesFromCache(BinaryFileReader& reader)
     if (!reader.ReadU8(&type) || !reader.ReadU8(&region) || !reader.ReadSizePrefixedString(&path) ||
         !reader.ReadSizePrefixedString(&ge.serial) || !reader.ReadSizePrefixedString(&ge.title) ||
         !reader.ReadU64(&ge.hash) || !reader.ReadS64(&ge.file_size) || !reader.ReadU64(&ge.uncompressed_size) ||
-        !reader.ReadU64(reinterpret_cast<u64*>(&ge.last_modified_time)) || !reader.ReadS8(&ge.disc_set_index) ||
+        !reader.ReadU64(reinterpret_cast<u64*>(&ge.last_modified_time)) || !reader.ReadS64(&scanned_file_size) ||
+        !reader.ReadS8(&ge.disc_set_index) ||
         !reader.Read(ge.achievements_hash.data(), ge.achievements_hash.size()) ||
         region >= static_cast<u8>(DiscRegion::Count) || type > static_cast<u8>(EntryType::MaxCount))
     {
@@ -494,17 +539,24 @@ bool GameList::LoadEntriesFromCache(BinaryFileReader& reader)
     ge.region = static_cast<DiscRegion>(region);
     ge.type = static_cast<EntryType>(type);
 
+    // later records are from rescans, and supersede the earlier ones
     auto iter = s_state.cache_map.find(ge.path);
     if (iter != s_state.cache_map.end())
-      iter->second = std::move(ge);
+    {
+      iter->second = CacheEntry{std::move(ge), scanned_file_size};
+      (*stale_records)++;
+    }
     else
-      s_state.cache_map.emplace(std::move(path), std::move(ge));
+    {
+      s_state.cache_map.emplace(std::move(path), CacheEntry{std::move(ge), scanned_file_size});
+    }
   }
 
   return true;
 }
 
-bool GameList::WriteEntryToCache(const Entry* entry, const std::string& entry_path, BinaryFileWriter& writer)
+bool GameList::WriteEntryToCache(const Entry* entry, const std::string& entry_path, s64 scanned_file_size,
+                                 BinaryFileWriter& writer)
 {
   writer.WriteU8(static_cast<u8>(entry->type));
   writer.WriteU8(static_cast<u8>(entry->region));
@@ -515,6 +567,7 @@ bool GameList::WriteEntryToCache(const Entry* entry, const std::string& entry_pa
   writer.WriteS64(entry->file_size);
   writer.WriteU64(entry->uncompressed_size);
   writer.WriteU64(entry->last_modified_time);
+  writer.WriteS64(scanned_file_size);
   writer.WriteS8(entry->disc_set_index);
   writer.Write(entry->achievements_hash.data(), entry->achievements_hash.size());
   return writer.IsGood();
@@ -523,8 +576,16 @@ bool GameList::WriteEntryToCache(const Entry* entry, const std::string& entry_pa
 bool GameList::LoadOrInitializeCache(std::FILE* fp, bool invalidate_cache)
 {
   BinaryFileReader reader(fp);
-  if (!invalidate_cache && !reader.IsAtEnd() && LoadEntriesFromCache(reader))
+  size_t stale_records = 0;
+  if (!invalidate_cache && !reader.IsAtEnd() && LoadEntriesFromCache(reader, &stale_records))
   {
+    if (stale_records >= MIN_STALE_CACHE_RECORDS && stale_records > s_state.cache_map.size())
+    {
+      INFO_LOG("Compacting game list cache, {} of {} records are stale.", stale_records,
+               stale_records + s_state.cache_map.size());
+      return RewriteCache(fp);
+    }
+
     // Prepare for writing.
     return (FileSystem::FSeek64(fp, 0, SEEK_END) == 0);
   }
@@ -534,7 +595,12 @@ bool GameList::LoadOrInitializeCache(std::FILE* fp, bool invalidate_cache)
   if (!fp)
     return false;
 
-  // Truncate file, and re-write header.
+  return RewriteCache(fp);
+}
+
+bool GameList::RewriteCache(std::FILE* fp)
+{
+  // Truncate file, and re-write header and any entries which are still live.
   Error error;
   if (!FileSystem::FSeek64(fp, 0, SEEK_SET, &error) || !FileSystem::FTruncate64(fp, 0, &error))
   {
@@ -545,9 +611,11 @@ bool GameList::LoadOrInitializeCache(std::FILE* fp, bool invalidate_cache)
   BinaryFileWriter writer(fp);
   writer.WriteU32(GAME_LIST_CACHE_SIGNATURE);
   writer.WriteU32((GAME_LIST_CACHE_VERSION));
+  for (const auto& [path, cache_entry] : s_state.cache_map)
+    WriteEntryToCache(&cache_entry.entry, path, cache_entry.scanned_file_size, writer);
   if (!writer.Flush(&error))
   {
-    ERROR_LOG("Failed to write game list cache header: {}", error.GetDescription());
+    ERROR_LOG("Failed to write game list cache: {}", error.GetDescription());
     return false;
   }
 
@@ -564,7 +632,8 @@ void GameList::ScanDirectory(const std::string& path, bool recursive, bool only_
                              const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
                              const INISettingsInterface& custom_attributes_ini,
                              const Achievements::ProgressDatabase& achievements_progress,
-                             BinaryFileWriter& cache_writer, ProgressCallback* progress)
+                             UnorderedStringSet& seen_paths, std::vector<ScanFileInfo>& files_to_scan,
+                             ProgressCallback* progress)
 {
   VERBOSE_LOG("Scanning {}{}", path, recursive ? " (recursively)" : "");
 
@@ -606,37 +675,38 @@ void GameList::ScanDirectory(const std::string& path, bool recursive, bool only_
       ffd.FileName = Path::Combine(EmuFolders::DataRoot, path_in_cache);
     }
 
+    // skip files which are reachable through more than one directory
+#ifdef _WIN32
+    // Use case-insensitive compare on Windows, since it's the same file.
+    std::string seen_path = ffd.FileName;
+    std::transform(seen_path.begin(), seen_path.end(), seen_path.begin(), StringUtil::ToLower);
+    if (!seen_paths.insert(std::move(seen_path)).second)
+      continue;
+#else
+    if (!seen_paths.insert(ffd.FileName).second)
+      continue;
+#endif
+
+    ScanFileInfo file{std::move(ffd.FileName), std::move(path_in_cache), ffd.ModificationTime, ffd.Size};
+
     std::unique_lock lock(s_state.mutex);
-    if (GetEntryForPath(ffd.FileName) ||
-        AddFileFromCache(ffd.FileName, path_in_cache, ffd.ModificationTime, played_time_map, custom_attributes_ini,
-                         achievements_progress) ||
-        only_cache)
-    {
+    if (AddFileFromCache(file, played_time_map, custom_attributes_ini, achievements_progress) || only_cache)
       continue;
-    }
 
-    progress->SetStatusText(SmallString::from_format(TRANSLATE_FS("GameList", "Scanning '{}'..."),
-                                                     FileSystem::GetDisplayNameFromPath(ffd.FileName)));
-    ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini,
-             achievements_progress, path_in_cache, cache_writer);
-    progress->SetProgressValue(files_scanned);
+    files_to_scan.push_back(std::move(file));
   }
 
   progress->SetProgressValue(files_scanned);
   progress->PopState();
 }
 
-bool GameList::AddFileFromCache(const std::string& path, const std::string& path_in_cache, std::time_t timestamp,
-                                const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini,
+bool GameList::AddFileFromCache(const ScanFileInfo& file, const PlayedTimeMap& played_time_map,
+                                const INISettingsInterface& custom_attributes_ini,
                                 const Achievements::ProgressDatabase& achievements_progress)
 {
   Entry entry;
-  if (!GetGameListEntryFromCache(path_in_cache.empty() ? path : path_in_cache, &entry, custom_attributes_ini,
-                                 achievements_progress) ||
-      entry.last_modified_time != timestamp)
-  {
+  if (!GetGameListEntryFromCache(file, &entry, custom_attributes_ini, achievements_progress))
     return false;
-  }
 
   // don't add invalid entries to the list, but don't scan them either
   if (!entry.IsValid())
@@ -650,27 +720,75 @@ bool GameList::AddFileFromCache(const std::string& path, const std::string& path
   }
 
   // for relative paths, we need to restore the full path
-  if (!path_in_cache.empty())
-    entry.path = path;
+  if (!file.path_in_cache.empty())
+    entry.path = file.path;
 
   s_state.entries.push_back(std::move(entry));
   return true;
 }
 
-void GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                        const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini,
-                        const Achievements::ProgressDatabase& achievements_progress, const std::string& path_for_cache,
-                        BinaryFileWriter& cache_writer)
+void GameList::ScanFiles(std::vector<ScanFileInfo>& files, const PlayedTimeMap& played_time_map,
+                         const INISettingsInterface& custom_attributes_ini,
+                         const Achievements::ProgressDatabase& achievements_progress, BinaryFileWriter& cache_writer,
+                         ProgressCallback* progress)
 {
-  // don't block UI while scanning
-  lock.unlock();
+  if (files.empty())
+    return;
 
-  VERBOSE_LOG("Scanning '{}'...", path);
+  // Opening images is mostly spent waiting on the disk or network, so keep several in flight.
+  const u32 num_threads = std::clamp(std::thread::hardware_concurrency(), 1u, static_cast<u32>(MAX_SCAN_THREADS));
+  const size_t batch_size = num_threads * SCAN_FILES_PER_THREAD;
+  TaskQueue scan_queue;
+  scan_queue.SetWorkerCount(num_threads);
+  VERBOSE_LOG("Scanning {} files with {} threads", files.size(), num_threads);
 
-  Entry entry;
-  if (PopulateEntryFromPath(path, &entry))
+  progress->PushState();
+  progress->SetProgressRange(static_cast<u32>(files.size()));
+  progress->SetProgressValue(0);
+
+  std::vector<ScanResult> results(batch_size);
+  for (size_t batch_start = 0; batch_start < files.size(); batch_start += batch_size)
   {
-    ApplyCustomAttributes(path_for_cache.empty() ? path : path_for_cache, &entry, custom_attributes_ini);
+    if (progress->IsCancelled())
+      break;
+
+    const size_t batch_count = std::min(batch_size, files.size() - batch_start);
+    for (size_t i = 0; i < batch_count; i++)
+    {
+      scan_queue.SubmitTask([&file = files[batch_start + i], &result = results[i]]() {
+        VERBOSE_LOG("Scanning '{}'...", file.path);
+        result.entry = {};
+        result.populated = PopulateEntryFromPath(file.path, &result.entry);
+      });
+    }
+    scan_queue.WaitForAll();
+
+    progress->SetStatusText(SmallString::from_format(
+      TRANSLATE_FS("GameList", "Scanning '{}'..."),
+      FileSystem::GetDisplayNameFromPath(files[batch_start + batch_count - 1].path)));
+
+    // the cache writer and entry list are only touched from this thread
+    for (size_t i = 0; i < batch_count; i++)
+    {
+      AddScannedFile(files[batch_start + i], results[i], played_time_map, custom_attributes_ini,
+                     achievements_progress, cache_writer);
+    }
+
+    progress->SetProgressValue(static_cast<u32>(batch_start + batch_count));
+  }
+
+  progress->PopState();
+}
+
+void GameList::AddScannedFile(ScanFileInfo& file, ScanResult& result, const PlayedTimeMap& played_time_map,
+                              const INISettingsInterface& custom_attributes_ini,
+                              const Achievements::ProgressDatabase& achievements_progress,
+                              BinaryFileWriter& cache_writer)
+{
+  Entry& entry = result.entry;
+  if (result.populated)
+  {
+    ApplyCustomAttributes(file.path_in_cache.empty() ? file.path : file.path_in_cache, &entry, custom_attributes_ini);
 
     if (entry.IsDisc())
       PopulateEntryAchievements(&entry, achievements_progress);
@@ -687,29 +805,24 @@ void GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
     MakeInvalidEntry(&entry);
   }
 
-  entry.path = std::move(path);
-  entry.last_modified_time = timestamp;
+  entry.path = std::move(file.path);
+  entry.last_modified_time = file.timestamp;
 
   // write the relative path to the cache if this is a relative scan
   if (cache_writer.IsOpen() &&
-      !WriteEntryToCache(&entry, path_for_cache.empty() ? entry.path : path_for_cache, cache_writer)) [[unlikely]]
+      !WriteEntryToCache(&entry, file.path_in_cache.empty() ? entry.path : file.path_in_cache, file.size,
+                         cache_writer)) [[unlikely]]
   {
     WARNING_LOG("Failed to write entry '{}' to cache", entry.path);
   }
 
-  lock.lock();
-
   // don't add invalid entries to the list
   if (!entry.IsValid())
     return;
 
-  // replace if present
-  auto it = std::find_if(s_state.entries.begin(), s_state.entries.end(),
-                         [&entry](const Entry& existing_entry) { return (existing_entry.path == entry.path); });
-  if (it != s_state.entries.end())
-    *it = std::move(entry);
-  else
-    s_state.entries.push_back(std::move(entry));
+  // paths are unique, ScanDirectory() skips duplicates
+  std::unique_lock lock(s_state.mutex);
+  s_state.entries.push_back(std::move(entry));
 }
 
 bool GameList::RescanCustomAttributesForPath(const std::string& path, const INISettingsInterface& custom_attributes_ini)
@@ -1151,6 +1264,10 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
     progress->SetProgressRange(static_cast<u32>(dirs.size() + recursive_dirs.size()));
     progress->SetProgressValue(0);
 
+    // Unchanged files are added from the cache while enumerating, the rest are opened in parallel afterwards.
+    UnorderedStringSet seen_paths;
+    std::vector<ScanFileInfo> files_to_scan;
+
     // we manually count it here, because otherwise pop state updates it itself
     int directory_counter = 0;
     for (const std::string& dir : dirs)
@@ -1159,7 +1276,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
         break;
 
       ScanDirectory(dir, false, only_cache, excluded_paths, played_time, custom_attributes_ini, achievements_progress,
-                    cache_writer, progress);
+                    seen_paths, files_to_scan, progress);
       progress->SetProgressValue(++directory_counter);
     }
     for (const std::string& dir : recursive_dirs)
@@ -1168,9 +1285,12 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
         break;
 
       ScanDirectory(dir, true, only_cache, excluded_paths, played_time, custom_attributes_ini, achievements_progress,
-                    cache_writer, progress);
+                    seen_paths, files_to_scan, progress);
       progress->SetProgressValue(++directory_counter);
     }
+
+    if (!progress->IsCancelled())
+      ScanFiles(files_to_scan, played_time, custom_attributes_ini, achievements_progress, cache_writer, progress);
   }
 
   // don't need unused cache entries
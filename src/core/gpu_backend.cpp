@@ -127,6 +127,11 @@ void GPUBackend::UpdatePostProcessingSettings(bool force_reload)
 {
 }
 
+void GPUBackend::UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit)
+{
+  GPU_SW_Rasterizer::UpdateCLUT(reg, clut_is_8bit);
+}
+
 VideoThreadCommand* GPUBackend::NewClearVRAMCommand()
 {
   return static_cast<VideoThreadCommand*>(
@@ -488,7 +493,7 @@ void GPUBackend::HandleCommand(const VideoThreadCommand* cmd)
     case VideoThreadCommandType::UpdateCLUT:
     {
       const GPUBackendUpdateCLUTCommand* ccmd = static_cast<const GPUBackendUpdateCLUTCommand*>(cmd);
-      GPU_SW_Rasterizer::UpdateCLUT(ccmd->reg, ccmd->clut_is_8bit);
+      UpdateCLUT(ccmd->reg, ccmd->clut_is_8bit);
     }
     break;
 
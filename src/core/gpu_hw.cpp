@@ -2599,7 +2599,7 @@ void GPU_HW::DrawLine(const GPUBackendDrawLineCommand* cmd)
       GPU_SW_Rasterizer::GetDrawLineFunction(cmd->shading_enable, cmd->transparency_enable);
 
     for (u32 i = 0; i < num_vertices; i += 2)
-      DrawFunction(cmd, &cmd->vertices[i], &cmd->vertices[i + 1]);
+      DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area, &cmd->vertices[i], &cmd->vertices[i + 1]);
   }
 }
 
@@ -2663,7 +2663,7 @@ void GPU_HW::DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd)
         {.x = end.native_x, .y = end.native_y, .color = end.color},
       };
 
-      DrawFunction(cmd, &vertices[0], &vertices[1]);
+      DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area, &vertices[0], &vertices[1]);
     }
   }
 }
@@ -2894,7 +2894,7 @@ void GPU_HW::DrawSprite(const GPUBackendDrawRectangleCommand* cmd)
       GPU_SW_Rasterizer::GetModulationMode(cmd->texture_enable, cmd->raw_texture_enable,
                                            g_gpu_settings.gpu_modulation_crop),
       cmd->transparency_enable);
-    DrawFunction(cmd);
+    DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area);
   }
 }
 
@@ -2928,9 +2928,9 @@ void GPU_HW::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
       GPU_SW_Rasterizer::GetModulationMode(cmd->texture_enable, cmd->raw_texture_enable,
                                            g_gpu_settings.gpu_modulation_crop),
       cmd->transparency_enable);
-    DrawFunction(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
+    DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
     if (cmd->num_vertices > 3)
-      DrawFunction(cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
+      DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
   }
 }
 
@@ -2983,9 +2983,9 @@ void GPU_HW::DrawPrecisePolygon(const GPUBackendDrawPrecisePolygonCommand* cmd)
         .x = src.native_x, .y = src.native_y, .color = src.color, .texcoord = src.texcoord};
     }
 
-    DrawFunction(cmd, &sw_vertices[0], &sw_vertices[1], &sw_vertices[2]);
+    DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area, &sw_vertices[0], &sw_vertices[1], &sw_vertices[2]);
     if (cmd->num_vertices > 3)
-      DrawFunction(cmd, &sw_vertices[2], &sw_vertices[1], &sw_vertices[3]);
+      DrawFunction(cmd, GPU_SW_Rasterizer::g_drawing_area, &sw_vertices[2], &sw_vertices[1], &sw_vertices[3]);
   }
 }
 
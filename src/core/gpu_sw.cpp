@@ -24,7 +24,11 @@ LOG_CHANNEL(GPU);
 
 GPU_SW::GPU_SW() = default;
 
-GPU_SW::~GPU_SW() = default;
+GPU_SW::~GPU_SW()
+{
+  // Backend may be switched, make sure VRAM is up to date.
+  FlushBinnedDraws();
+}
 
 u32 GPU_SW::GetResolutionScale() const
 {
@@ -55,17 +59,57 @@ bool GPU_SW::Initialize(bool upload_vram, Error* error)
   if (!upload_vram)
     std::memset(g_vram, 0, sizeof(g_vram));
 
+  UpdateBinningThreadCount();
+  return true;
+}
+
+bool GPU_SW::UpdateSettings(const GPUSettings& old_settings, Error* error)
+{
+  // Draws could depend on the old settings, e.g. modulation crop.
+  FlushBinnedDraws();
+
+  if (!GPUBackend::UpdateSettings(old_settings, error))
+    return false;
+
+  if (g_gpu_settings.gpu_sw_threads != old_settings.gpu_sw_threads)
+    UpdateBinningThreadCount();
+
   return true;
 }
 
+void GPU_SW::UpdateBinningThreadCount()
+{
+  FlushBinnedDraws();
+
+  // The video thread rasterizes tiles as well while it waits, so it counts towards the total.
+  const u32 thread_count = g_gpu_settings.gpu_sw_threads;
+  m_binning_enabled = (thread_count > 1);
+  m_tile_task_queue.SetWorkerCount(m_binning_enabled ? (thread_count - 1) : 0);
+
+  if (m_binning_enabled)
+  {
+    INFO_LOG("Using binned software rasterizer with {} threads.", thread_count);
+    m_binned_commands.reserve(MAX_BINNED_COMMAND_BYTES);
+  }
+  else
+  {
+    m_binned_commands = {};
+    m_binned_draws = {};
+    for (std::vector<u32>& bin : m_tile_bins)
+      bin = {};
+  }
+}
+
 void GPU_SW::ClearVRAM()
 {
+  FlushBinnedDraws();
   std::memset(g_vram, 0, sizeof(g_vram));
   std::memset(g_gpu_clut, 0, sizeof(g_gpu_clut));
 }
 
 void GPU_SW::LoadState(const GPUBackendLoadStateCommand* cmd)
 {
+  FlushBinnedDraws();
   std::memcpy(g_vram, cmd->vram_data, sizeof(g_vram));
   std::memcpy(g_gpu_clut, cmd->clut_data, sizeof(g_gpu_clut));
 }
@@ -78,6 +122,7 @@ bool GPU_SW::AllocateMemorySaveState(System::MemorySaveState& mss, Error* error)
 
 void GPU_SW::DoMemoryState(StateWrapper& sw, System::MemorySaveState& mss)
 {
+  FlushBinnedDraws();
   sw.DoBytes(g_vram, sizeof(g_vram));
   sw.DoBytes(g_gpu_clut, sizeof(g_gpu_clut));
   DebugAssert(!sw.HasError());
@@ -85,24 +130,28 @@ void GPU_SW::DoMemoryState(StateWrapper& sw, System::MemorySaveState& mss)
 
 void GPU_SW::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
+  FlushBinnedDraws();
 }
 
 void GPU_SW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, bool interlaced_rendering, u8 active_line_lsb)
 {
+  FlushBinnedDraws();
   GPU_SW_Rasterizer::FillVRAM(x, y, width, height, color, interlaced_rendering, active_line_lsb);
 }
 
 void GPU_SW::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask, bool check_mask)
 {
+  FlushBinnedDraws();
   GPU_SW_Rasterizer::WriteVRAM(x, y, width, height, data, set_mask, check_mask);
 }
 
 void GPU_SW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height, bool set_mask, bool check_mask)
 {
+  FlushBinnedDraws();
   GPU_SW_Rasterizer::CopyVRAM(src_x, src_y, dst_x, dst_y, width, height, set_mask, check_mask);
 }
 
-void GPU_SW::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
+void GPU_SW::DrawPolygonImpl(const GPUBackendDrawPolygonCommand* cmd, const GPUDrawingArea& drawing_area)
 {
   const GPU_SW_Rasterizer::DrawTriangleFunction DrawFunction = GPU_SW_Rasterizer::GetDrawTriangleFunction(
     cmd->shading_enable,
@@ -110,12 +159,12 @@ void GPU_SW::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
                                          g_gpu_settings.gpu_modulation_crop),
     cmd->transparency_enable);
 
-  DrawFunction(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
+  DrawFunction(cmd, drawing_area, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
   if (cmd->num_vertices > 3)
-    DrawFunction(cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
+    DrawFunction(cmd, drawing_area, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
 }
 
-void GPU_SW::DrawPrecisePolygon(const GPUBackendDrawPrecisePolygonCommand* cmd)
+void GPU_SW::DrawPrecisePolygonImpl(const GPUBackendDrawPrecisePolygonCommand* cmd, const GPUDrawingArea& drawing_area)
 {
   const GPU_SW_Rasterizer::DrawTriangleFunction DrawFunction = GPU_SW_Rasterizer::GetDrawTriangleFunction(
     cmd->shading_enable,
@@ -133,43 +182,31 @@ void GPU_SW::DrawPrecisePolygon(const GPUBackendDrawPrecisePolygonCommand* cmd)
       .x = src.native_x, .y = src.native_y, .color = src.color, .texcoord = src.texcoord};
   }
 
-  DrawFunction(cmd, &vertices[0], &vertices[1], &vertices[2]);
+  DrawFunction(cmd, drawing_area, &vertices[0], &vertices[1], &vertices[2]);
   if (cmd->num_vertices > 3)
-    DrawFunction(cmd, &vertices[2], &vertices[1], &vertices[3]);
+    DrawFunction(cmd, drawing_area, &vertices[2], &vertices[1], &vertices[3]);
 }
 
-void GPU_SW::DrawSprite(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW::DrawSpriteImpl(const GPUBackendDrawRectangleCommand* cmd, const GPUDrawingArea& drawing_area)
 {
-  // Sprites coordinates are truncated in the GPU class, so it's safe to cull them here.
-  // Probably wrong, but if we ever change it, this should be removed.
-  const GSVector2i pos = GSVector2i::load<true>(&cmd->x);
-  const GSVector2i size = GSVector2i::load<true>(&cmd->width).u16to32();
-  const GSVector4i rect = GSVector4i::xyxy(pos, pos.add32(size));
-  const GSVector4i clamped_rect = m_clamped_drawing_area.rintersect(rect);
-  if (clamped_rect.rempty())
-  {
-    DEBUG_LOG("Culling off-screen sprite {}", rect);
-    return;
-  }
-
   const GPU_SW_Rasterizer::DrawRectangleFunction DrawFunction = GPU_SW_Rasterizer::GetDrawRectangleFunction(
     GPU_SW_Rasterizer::GetModulationMode(cmd->texture_enable, cmd->raw_texture_enable,
                                          g_gpu_settings.gpu_modulation_crop),
     cmd->transparency_enable);
 
-  DrawFunction(cmd);
+  DrawFunction(cmd, drawing_area);
 }
 
-void GPU_SW::DrawLine(const GPUBackendDrawLineCommand* cmd)
+void GPU_SW::DrawLineImpl(const GPUBackendDrawLineCommand* cmd, const GPUDrawingArea& drawing_area)
 {
   const GPU_SW_Rasterizer::DrawLineFunction DrawFunction =
     GPU_SW_Rasterizer::GetDrawLineFunction(cmd->shading_enable, cmd->transparency_enable);
 
   for (u16 i = 0; i < cmd->num_vertices; i += 2)
-    DrawFunction(cmd, &cmd->vertices[i], &cmd->vertices[i + 1]);
+    DrawFunction(cmd, drawing_area, &cmd->vertices[i], &cmd->vertices[i + 1]);
 }
 
-void GPU_SW::DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd)
+void GPU_SW::DrawPreciseLineImpl(const GPUBackendDrawPreciseLineCommand* cmd, const GPUDrawingArea& drawing_area)
 {
   const GPU_SW_Rasterizer::DrawLineFunction DrawFunction =
     GPU_SW_Rasterizer::GetDrawLineFunction(cmd->shading_enable, cmd->transparency_enable);
@@ -185,13 +222,241 @@ void GPU_SW::DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd)
       {.x = end.native_x, .y = end.native_y, .color = end.color},
     };
 
-    DrawFunction(cmd, &vertices[0], &vertices[1]);
+    DrawFunction(cmd, drawing_area, &vertices[0], &vertices[1]);
+  }
+}
+
+void GPU_SW::ExecuteDrawCommand(const GPUBackendDrawCommand* cmd, const GPUDrawingArea& drawing_area)
+{
+  switch (cmd->type)
+  {
+    case VideoThreadCommandType::DrawPolygon:
+      DrawPolygonImpl(static_cast<const GPUBackendDrawPolygonCommand*>(cmd), drawing_area);
+      break;
+
+    case VideoThreadCommandType::DrawPrecisePolygon:
+      DrawPrecisePolygonImpl(static_cast<const GPUBackendDrawPrecisePolygonCommand*>(cmd), drawing_area);
+      break;
+
+    case VideoThreadCommandType::DrawRectangle:
+      DrawSpriteImpl(static_cast<const GPUBackendDrawRectangleCommand*>(cmd), drawing_area);
+      break;
+
+    case VideoThreadCommandType::DrawLine:
+      DrawLineImpl(static_cast<const GPUBackendDrawLineCommand*>(cmd), drawing_area);
+      break;
+
+    case VideoThreadCommandType::DrawPreciseLine:
+      DrawPreciseLineImpl(static_cast<const GPUBackendDrawPreciseLineCommand*>(cmd), drawing_area);
+      break;
+
+    default:
+      UnreachableCode();
+  }
+}
+
+template<typename VertexType, s32 VertexType::*x_field, s32 VertexType::*y_field>
+ALWAYS_INLINE static GSVector4i GetVertexBounds(const VertexType* vertices, u32 num_vertices)
+{
+  GSVector4i bounds = GSVector4i(vertices[0].*x_field, vertices[0].*y_field, vertices[0].*x_field,
+                                 vertices[0].*y_field);
+  for (u32 i = 1; i < num_vertices; i++)
+  {
+    const s32 x = vertices[i].*x_field;
+    const s32 y = vertices[i].*y_field;
+    bounds = bounds.runion(GSVector4i(x, y, x, y));
+  }
+
+  // Bounds are only used to pick tiles, so pad them out to cover any rounding in the rasterizer.
+  return bounds.add32(GSVector4i::cxpr(-1, -1, 2, 2));
+}
+
+void GPU_SW::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
+{
+  if (!IsBinningEnabled())
+  {
+    DrawPolygonImpl(cmd, GPU_SW_Rasterizer::g_drawing_area);
+    return;
+  }
+
+  using Vertex = GPUBackendDrawPolygonCommand::Vertex;
+  BinDrawCommand(cmd, GetVertexBounds<Vertex, &Vertex::x, &Vertex::y>(cmd->vertices, cmd->num_vertices));
+}
+
+void GPU_SW::DrawPrecisePolygon(const GPUBackendDrawPrecisePolygonCommand* cmd)
+{
+  if (!IsBinningEnabled())
+  {
+    DrawPrecisePolygonImpl(cmd, GPU_SW_Rasterizer::g_drawing_area);
+    return;
+  }
+
+  using Vertex = GPUBackendDrawPrecisePolygonCommand::Vertex;
+  BinDrawCommand(cmd,
+                 GetVertexBounds<Vertex, &Vertex::native_x, &Vertex::native_y>(cmd->vertices, cmd->num_vertices));
+}
+
+void GPU_SW::DrawSprite(const GPUBackendDrawRectangleCommand* cmd)
+{
+  // Sprites coordinates are truncated in the GPU class, so it's safe to cull them here.
+  // Probably wrong, but if we ever change it, this should be removed.
+  const GSVector2i pos = GSVector2i::load<true>(&cmd->x);
+  const GSVector2i size = GSVector2i::load<true>(&cmd->width).u16to32();
+  const GSVector4i rect = GSVector4i::xyxy(pos, pos.add32(size));
+  const GSVector4i clamped_rect = m_clamped_drawing_area.rintersect(rect);
+  if (clamped_rect.rempty())
+  {
+    DEBUG_LOG("Culling off-screen sprite {}", rect);
+    return;
+  }
+
+  if (!IsBinningEnabled())
+  {
+    DrawSpriteImpl(cmd, GPU_SW_Rasterizer::g_drawing_area);
+    return;
+  }
+
+  BinDrawCommand(cmd, clamped_rect);
+}
+
+void GPU_SW::DrawLine(const GPUBackendDrawLineCommand* cmd)
+{
+  if (!IsBinningEnabled())
+  {
+    DrawLineImpl(cmd, GPU_SW_Rasterizer::g_drawing_area);
+    return;
+  }
+
+  using Vertex = GPUBackendDrawLineCommand::Vertex;
+  BinDrawCommand(cmd, GetVertexBounds<Vertex, &Vertex::x, &Vertex::y>(cmd->vertices, cmd->num_vertices));
+}
+
+void GPU_SW::DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd)
+{
+  if (!IsBinningEnabled())
+  {
+    DrawPreciseLineImpl(cmd, GPU_SW_Rasterizer::g_drawing_area);
+    return;
+  }
+
+  using Vertex = GPUBackendDrawPreciseLineCommand::Vertex;
+  BinDrawCommand(cmd,
+                 GetVertexBounds<Vertex, &Vertex::native_x, &Vertex::native_y>(cmd->vertices, cmd->num_vertices));
+}
+
+GSVector4i GPU_SW::GetTexturePageRect(const GPUBackendDrawCommand* cmd)
+{
+  static constexpr std::array<u32, 4> page_widths = {{64, 128, 256, 256}};
+
+  const u32 left = cmd->draw_mode.GetTexturePageBaseX();
+  const u32 top = cmd->draw_mode.GetTexturePageBaseY();
+  const u32 width = page_widths[static_cast<u8>(cmd->draw_mode.texture_mode.GetValue())];
+
+  // Sampling wraps around horizontally, just assume the whole width in that case.
+  return ((left + width) <= VRAM_WIDTH) ? GSVector4i(left, top, left + width, top + TEXTURE_PAGE_HEIGHT) :
+                                          GSVector4i(0, top, VRAM_WIDTH, top + TEXTURE_PAGE_HEIGHT);
+}
+
+void GPU_SW::BinDrawCommand(const GPUBackendDrawCommand* cmd, const GSVector4i bounds)
+{
+  const GSVector4i draw_rect = m_clamped_drawing_area.rintersect(bounds);
+  if (draw_rect.rempty())
+    return;
+
+  // Tiles are rasterized independently, so any draw that samples from VRAM written by another pending draw, or
+  // writes to VRAM that a pending draw samples from, has to wait for the current batch to complete.
+  const GSVector4i texture_rect = cmd->texture_enable ? GetTexturePageRect(cmd) : GSVector4i::zero();
+  if (texture_rect.rintersects(m_binned_dirty_rect) || draw_rect.rintersects(m_binned_texture_rect) ||
+      (m_binned_commands.size() + cmd->size) > MAX_BINNED_COMMAND_BYTES)
+  {
+    FlushBinnedDraws();
+  }
+
+  // Primitives sampling from their own output depend on the serial rasterization order, and have to be drawn
+  // after any pending draws that they overlap.
+  if (texture_rect.rintersects(draw_rect))
+  {
+    FlushBinnedDraws();
+    ExecuteDrawCommand(cmd, GPU_SW_Rasterizer::g_drawing_area);
+    return;
+  }
+
+  const u32 offset = static_cast<u32>(m_binned_commands.size());
+  m_binned_commands.resize(offset + Common::AlignUpPow2(cmd->size, BINNED_COMMAND_ALIGNMENT));
+  std::memcpy(&m_binned_commands[offset], cmd, cmd->size);
+
+  const u32 draw_index = static_cast<u32>(m_binned_draws.size());
+  m_binned_draws.push_back(BinnedDraw{.offset = offset, .drawing_area = GPU_SW_Rasterizer::g_drawing_area});
+
+  const u32 start_tile_x = static_cast<u32>(draw_rect.left) / TILE_WIDTH;
+  const u32 start_tile_y = static_cast<u32>(draw_rect.top) / TILE_HEIGHT;
+  const u32 end_tile_x = static_cast<u32>(draw_rect.right - 1) / TILE_WIDTH;
+  const u32 end_tile_y = static_cast<u32>(draw_rect.bottom - 1) / TILE_HEIGHT;
+  for (u32 tile_y = start_tile_y; tile_y <= end_tile_y; tile_y++)
+  {
+    for (u32 tile_x = start_tile_x; tile_x <= end_tile_x; tile_x++)
+      m_tile_bins[tile_y * NUM_TILES_X + tile_x].push_back(draw_index);
+  }
+
+  m_binned_dirty_rect = m_binned_dirty_rect.rempty() ? draw_rect : m_binned_dirty_rect.runion(draw_rect);
+  if (cmd->texture_enable)
+  {
+    m_binned_texture_rect =
+      m_binned_texture_rect.rempty() ? texture_rect : m_binned_texture_rect.runion(texture_rect);
+  }
+}
+
+void GPU_SW::FlushBinnedDraws()
+{
+  if (m_binned_draws.empty())
+    return;
+
+  for (u32 i = 0; i < NUM_TILES; i++)
+  {
+    if (!m_tile_bins[i].empty())
+      m_tile_task_queue.SubmitTask([this, i]() { DrawTile(i); });
+  }
+
+  m_tile_task_queue.WaitForAll();
+
+  for (std::vector<u32>& bin : m_tile_bins)
+    bin.clear();
+  m_binned_commands.clear();
+  m_binned_draws.clear();
+  m_binned_dirty_rect = GSVector4i::zero();
+  m_binned_texture_rect = GSVector4i::zero();
+}
+
+void GPU_SW::DrawTile(u32 tile_index)
+{
+  const u32 tile_left = (tile_index % NUM_TILES_X) * TILE_WIDTH;
+  const u32 tile_top = (tile_index / NUM_TILES_X) * TILE_HEIGHT;
+  const u32 tile_right = tile_left + TILE_WIDTH - 1;
+  const u32 tile_bottom = tile_top + TILE_HEIGHT - 1;
+
+  for (const u32 draw_index : m_tile_bins[tile_index])
+  {
+    const BinnedDraw& draw = m_binned_draws[draw_index];
+    const GPUDrawingArea tile_drawing_area = {.left = std::max(draw.drawing_area.left, tile_left),
+                                              .top = std::max(draw.drawing_area.top, tile_top),
+                                              .right = std::min(draw.drawing_area.right, tile_right),
+                                              .bottom = std::min(draw.drawing_area.bottom, tile_bottom)};
+    ExecuteDrawCommand(reinterpret_cast<const GPUBackendDrawCommand*>(&m_binned_commands[draw.offset]),
+                       tile_drawing_area);
   }
 }
 
 void GPU_SW::DrawingAreaChanged()
 {
   // GPU_SW_Rasterizer::g_drawing_area set by base class.
+  // Binned draws capture the drawing area when they are queued, so no flush is needed here.
+}
+
+void GPU_SW::UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit)
+{
+  // Pending draws use the current CLUT, and the new CLUT may come from VRAM that they write to.
+  FlushBinnedDraws();
+  GPUBackend::UpdateCLUT(reg, clut_is_8bit);
 }
 
 void GPU_SW::ClearCache()
@@ -204,6 +469,7 @@ void GPU_SW::OnBufferSwapped()
 
 void GPU_SW::FlushRender()
 {
+  FlushBinnedDraws();
 }
 
 void GPU_SW::RestoreDeviceContext()
@@ -390,6 +656,8 @@ bool GPU_SW::CopyOut(u32 src_x, u32 src_y, u32 skip_x, u32 width, u32 height, u3
 
 void GPU_SW::UpdateDisplay(const GPUBackendUpdateDisplayCommand* cmd)
 {
+  FlushBinnedDraws();
+
   if (!g_gpu_settings.gpu_show_vram)
   {
     const u32 field = BoolToUInt32(cmd->interlaced_display_field);
@@ -9,8 +9,11 @@
 #include "util/gpu_device.h"
 
 #include "common/heap_array.h"
+#include "common/task_queue.h"
 
+#include <array>
 #include <memory>
+#include <vector>
 
 // TODO: Move to cpp
 // TODO: Rename to GPUSWBackend, preserved to avoid conflicts.
@@ -21,6 +24,7 @@ public:
   ~GPU_SW() override;
 
   bool Initialize(bool upload_vram, Error* error) override;
+  bool UpdateSettings(const GPUSettings& old_settings, Error* error) override;
 
   void RestoreDeviceContext() override;
   void FlushRender() override;
@@ -39,6 +43,7 @@ public:
   void DrawPreciseLine(const GPUBackendDrawPreciseLineCommand* cmd) override;
   void DrawSprite(const GPUBackendDrawRectangleCommand* cmd) override;
   void DrawingAreaChanged() override;
+  void UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit) override;
   void ClearCache() override;
   void OnBufferSwapped() override;
 
@@ -54,6 +59,44 @@ public:
 private:
   static constexpr GPUTextureFormat FORMAT_FOR_24BIT = GPUTextureFormat::RGBA8; // RGBA8 always supported.
 
+  // Binned rendering splits VRAM into tiles, which are rasterized in parallel.
+  static constexpr u32 TILE_WIDTH = 64;
+  static constexpr u32 TILE_HEIGHT = 32;
+  static constexpr u32 NUM_TILES_X = VRAM_WIDTH / TILE_WIDTH;
+  static constexpr u32 NUM_TILES_Y = VRAM_HEIGHT / TILE_HEIGHT;
+  static constexpr u32 NUM_TILES = NUM_TILES_X * NUM_TILES_Y;
+  static constexpr u32 MAX_BINNED_COMMAND_BYTES = 2 * 1024 * 1024;
+  static constexpr u32 BINNED_COMMAND_ALIGNMENT = 16;
+
+  struct BinnedDraw
+  {
+    u32 offset;
+    GPUDrawingArea drawing_area;
+  };
+
+  static void DrawPolygonImpl(const GPUBackendDrawPolygonCommand* cmd, const GPUDrawingArea& drawing_area);
+  static void DrawPrecisePolygonImpl(const GPUBackendDrawPrecisePolygonCommand* cmd,
+                                     const GPUDrawingArea& drawing_area);
+  static void DrawLineImpl(const GPUBackendDrawLineCommand* cmd, const GPUDrawingArea& drawing_area);
+  static void DrawPreciseLineImpl(const GPUBackendDrawPreciseLineCommand* cmd, const GPUDrawingArea& drawing_area);
+  static void DrawSpriteImpl(const GPUBackendDrawRectangleCommand* cmd, const GPUDrawingArea& drawing_area);
+  static void ExecuteDrawCommand(const GPUBackendDrawCommand* cmd, const GPUDrawingArea& drawing_area);
+
+  ALWAYS_INLINE bool IsBinningEnabled() const { return m_binning_enabled; }
+
+  void UpdateBinningThreadCount();
+
+  /// Returns the VRAM region that a textured draw can sample from.
+  static GSVector4i GetTexturePageRect(const GPUBackendDrawCommand* cmd);
+
+  /// Queues the command for each tile that it overlaps. Flushes pending draws first on hazards.
+  void BinDrawCommand(const GPUBackendDrawCommand* cmd, const GSVector4i bounds);
+
+  /// Rasterizes all binned draws and waits for the workers to complete.
+  void FlushBinnedDraws();
+
+  void DrawTile(u32 tile_index);
+
   template<GPUTextureFormat display_format>
   bool CopyOut15Bit(u32 src_x, u32 src_y, u32 width, u32 height, u32 line_skip);
 
@@ -66,4 +109,12 @@ private:
   FixedHeapArray<u8, GPU_MAX_DISPLAY_WIDTH * GPU_MAX_DISPLAY_HEIGHT * sizeof(u32)> m_upload_buffer;
   GPUTextureFormat m_16bit_display_format = GPUTextureFormat::Unknown;
   std::unique_ptr<GPUTexture> m_upload_texture;
+
+  bool m_binning_enabled = false;
+  TaskQueue m_tile_task_queue;
+  std::vector<u8> m_binned_commands;
+  std::vector<BinnedDraw> m_binned_draws;
+  std::array<std::vector<u32>, NUM_TILES> m_tile_bins;
+  GSVector4i m_binned_dirty_rect = GSVector4i::zero();
+  GSVector4i m_binned_texture_rect = GSVector4i::zero();
 };
@@ -32,15 +32,17 @@ extern GPUDrawingArea g_drawing_area;
 
 extern void UpdateCLUT(GPUTexturePaletteReg reg, bool clut_is_8bit);
 
-using DrawRectangleFunction = void (*)(const GPUBackendDrawRectangleCommand* cmd);
+using DrawRectangleFunction = void (*)(const GPUBackendDrawRectangleCommand* cmd, const GPUDrawingArea& drawing_area);
 typedef const DrawRectangleFunction DrawRectangleFunctionTable[4][2];
 
-using DrawTriangleFunction = void (*)(const GPUBackendDrawCommand* cmd, const GPUBackendDrawPolygonCommand::Vertex* v0,
+using DrawTriangleFunction = void (*)(const GPUBackendDrawCommand* cmd, const GPUDrawingArea& drawing_area,
+                                      const GPUBackendDrawPolygonCommand::Vertex* v0,
                                       const GPUBackendDrawPolygonCommand::Vertex* v1,
                                       const GPUBackendDrawPolygonCommand::Vertex* v2);
 typedef const DrawTriangleFunction DrawTriangleFunctionTable[2][4][2];
 
-using DrawLineFunction = void (*)(const GPUBackendDrawCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
+using DrawLineFunction = void (*)(const GPUBackendDrawCommand* cmd, const GPUDrawingArea& drawing_area,
+                                  const GPUBackendDrawLineCommand::Vertex* p0,
                                   const GPUBackendDrawLineCommand::Vertex* p1);
 typedef const DrawLineFunction DrawLineFunctionTable[2][2];
 
@@ -242,7 +242,7 @@ template<TextureModulationMode modulation_mode, bool transparency_enable>
 #ifndef USE_VECTOR
 
 template<TextureModulationMode modulation_mode, bool transparency_enable>
-static void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+static void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const GPUDrawingArea& drawing_area)
 {
   const s32 origin_x = cmd->x;
   const s32 origin_y = cmd->y;
@@ -252,7 +252,7 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y < static_cast<s32>(g_drawing_area.top) || y > static_cast<s32>(g_drawing_area.bottom) ||
+    if (y < static_cast<s32>(drawing_area.top) || y > static_cast<s32>(drawing_area.bottom) ||
         (cmd->interlaced_rendering &&
          cmd->active_line_lsb == ConvertToBoolUnchecked(Truncate8(static_cast<u32>(y)) & 1u)))
     {
@@ -265,7 +265,7 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
     for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
     {
       const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(g_drawing_area.left) || x > static_cast<s32>(g_drawing_area.right))
+      if (x < static_cast<s32>(drawing_area.left) || x > static_cast<s32>(drawing_area.right))
         continue;
 
       const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
@@ -500,10 +500,10 @@ struct PixelVectors
   NO_UNIQUE_ADDRESS typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> texture_base_x;
   NO_UNIQUE_ADDRESS typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> texture_base_y;
 
-  PixelVectors(const GPUBackendDrawCommand* cmd)
+  PixelVectors(const GPUBackendDrawCommand* cmd, const GPUDrawingArea& drawing_area)
   {
-    clip_left = GSVectorNi(g_drawing_area.left);
-    clip_right = GSVectorNi(g_drawing_area.right);
+    clip_left = GSVectorNi(drawing_area.left);
+    clip_right = GSVectorNi(drawing_area.right);
 
     mask_and = GSVectorNi(cmd->GetMaskAND());
     mask_or = GSVectorNi(cmd->GetMaskOR());
@@ -736,7 +736,7 @@ ShadePixel(const PixelVectors<modulation_mode != TextureModulationMode::Disabled
 }
 
 template<TextureModulationMode modulation_mode, bool transparency_enable>
-static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
+static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd, const GPUDrawingArea& drawing_area)
 {
   static constexpr bool texture_enable = (modulation_mode != TextureModulationMode::Disabled);
 
@@ -752,7 +752,7 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
   const GSVectorNi texcoord_x = GSVectorNi(cmd->texcoord & 0xFF).add32(SPAN_OFFSET_VEC);
   GSVectorNi texcoord_y = GSVectorNi(cmd->texcoord >> 8);
 
-  const PixelVectors<texture_enable> pv(cmd);
+  const PixelVectors<texture_enable> pv(cmd, drawing_area);
   const u32 width = cmd->width;
   const GPUTransparencyMode transparency_mode = cmd->draw_mode.transparency_mode;
   const bool mask_bit_test = cmd->check_mask_before_draw;
@@ -764,7 +764,7 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y >= static_cast<s32>(g_drawing_area.top) && y <= static_cast<s32>(g_drawing_area.bottom) &&
+    if (y >= static_cast<s32>(drawing_area.top) && y <= static_cast<s32>(drawing_area.bottom) &&
         (!cmd->interlaced_rendering ||
          cmd->active_line_lsb != ConvertToBoolUnchecked(Truncate8(static_cast<u32>(y)) & 1u)))
     {
@@ -804,7 +804,7 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
   }
 
 #ifdef CHECK_VECTOR
-  CHECK_VRAM(GPU_SW_Rasterizer::DrawRectangleFunctions[u8(modulation_mode)][transparency_enable](cmd));
+  CHECK_VRAM(GPU_SW_Rasterizer::DrawRectangleFunctions[u8(modulation_mode)][transparency_enable](cmd, drawing_area));
 #endif
 }
 
@@ -812,7 +812,8 @@ static void DrawRectangle(const GPUBackendDrawRectangleCommand* RESTRICT cmd)
 
 // TODO: Vectorize line draw.
 template<bool shading_enable, bool transparency_enable>
-static void DrawLine(const GPUBackendDrawCommand* RESTRICT cmd, const GPUBackendDrawLineCommand::Vertex* RESTRICT p0,
+static void DrawLine(const GPUBackendDrawCommand* RESTRICT cmd, const GPUDrawingArea& drawing_area,
+                     const GPUBackendDrawLineCommand::Vertex* RESTRICT p0,
                      const GPUBackendDrawLineCommand::Vertex* RESTRICT p1)
 {
   static constexpr u32 XY_SHIFT = 32;
@@ -868,8 +869,8 @@ static void DrawLine(const GPUBackendDrawCommand* RESTRICT cmd, const GPUBackend
 
     if ((!cmd->interlaced_rendering ||
          cmd->active_line_lsb != ConvertToBoolUnchecked(Truncate8(static_cast<u32>(y)) & 1u)) &&
-        x >= static_cast<s32>(g_drawing_area.left) && x <= static_cast<s32>(g_drawing_area.right) &&
-        y >= static_cast<s32>(g_drawing_area.top) && y <= static_cast<s32>(g_drawing_area.bottom))
+        x >= static_cast<s32>(drawing_area.left) && x <= static_cast<s32>(drawing_area.right) &&
+        y >= static_cast<s32>(drawing_area.top) && y <= static_cast<s32>(drawing_area.bottom))
     {
       const u8 r = shading_enable ? unfp_rgb(curr) : p0->r;
       const u8 g = shading_enable ? unfp_rgb(curg) : p0->g;
@@ -1018,8 +1019,9 @@ struct TrianglePart
 #ifndef USE_VECTOR
 
 template<bool shading_enable, TextureModulationMode modulation_mode, bool transparency_enable>
-static void DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_start, s32 x_bound, UVStepper uv,
-                     const UVSteps& RESTRICT uvstep, RGBStepper rgb, const RGBSteps& RESTRICT rgbstep)
+static void DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, const GPUDrawingArea& drawing_area, s32 y, s32 x_start,
+                     s32 x_bound, UVStepper uv, const UVSteps& RESTRICT uvstep, RGBStepper rgb,
+                     const RGBSteps& RESTRICT rgbstep)
 {
   static constexpr bool texture_enable = (modulation_mode != TextureModulationMode::Disabled);
 
@@ -1027,16 +1029,16 @@ static void DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_sta
   s32 current_x = TruncateGPUVertexPosition(x_start);
 
   // Skip pixels outside of the scissor rectangle.
-  if (current_x < static_cast<s32>(g_drawing_area.left))
+  if (current_x < static_cast<s32>(drawing_area.left))
   {
-    const s32 delta = static_cast<s32>(g_drawing_area.left) - current_x;
+    const s32 delta = static_cast<s32>(drawing_area.left) - current_x;
     x_start += delta;
     current_x += delta;
     width -= delta;
   }
 
-  if ((current_x + width) > (static_cast<s32>(g_drawing_area.right) + 1))
-    width = static_cast<s32>(g_drawing_area.right) + 1 - current_x;
+  if ((current_x + width) > (static_cast<s32>(drawing_area.right) + 1))
+    width = static_cast<s32>(drawing_area.right) + 1 - current_x;
 
   if (width <= 0)
     return;
@@ -1061,6 +1063,7 @@ static void DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_sta
 
 template<bool shading_enable, TextureModulationMode modulation_mode, bool transparency_enable>
 ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand* RESTRICT cmd,
+                                                   const GPUDrawingArea& drawing_area,
                                                    const TrianglePart& RESTRICT tp, const UVStepper& RESTRICT uv,
                                                    const UVSteps& RESTRICT uvstep, const RGBStepper& RESTRICT rgb,
                                                    const RGBSteps& RESTRICT rgbstep)
@@ -1095,7 +1098,7 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       right_x -= right_x_step;
 
       const s32 y = TruncateGPUVertexPosition(current_y);
-      if (y < static_cast<s32>(g_drawing_area.top))
+      if (y < static_cast<s32>(drawing_area.top))
         break;
 
       // Opposite direction means we need to subtract when stepping instead of adding.
@@ -1104,15 +1107,15 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       if constexpr (shading_enable)
         lrgb.StepY<true>(rgbstep);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom) ||
+      if (y > static_cast<s32>(drawing_area.bottom) ||
           (cmd->interlaced_rendering &&
            cmd->active_line_lsb == ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
       {
         continue;
       }
 
-      DrawSpan<shading_enable, modulation_mode, transparency_enable>(cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x),
-                                                                     unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
+      DrawSpan<shading_enable, modulation_mode, transparency_enable>(
+        cmd, drawing_area, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
     } while (current_y > end_y);
   }
   else
@@ -1132,16 +1135,16 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
     {
       const s32 y = TruncateGPUVertexPosition(current_y);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom))
+      if (y > static_cast<s32>(drawing_area.bottom))
       {
         break;
       }
-      if (y >= static_cast<s32>(g_drawing_area.top) &&
+      if (y >= static_cast<s32>(drawing_area.top) &&
           (!cmd->interlaced_rendering ||
            cmd->active_line_lsb != ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
       {
-        DrawSpan<shading_enable, modulation_mode, transparency_enable>(cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x),
-                                                                       unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
+        DrawSpan<shading_enable, modulation_mode, transparency_enable>(
+          cmd, drawing_area, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep);
       }
 
       current_y++;
@@ -1175,8 +1178,9 @@ struct TriangleVectors : PixelVectors<texture_enable>
   typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> dudx_0123;
   typename std::conditional_t<texture_enable, GSVectorNi, UnusedField> dvdx_0123;
 
-  TriangleVectors(const GPUBackendDrawCommand* cmd, const UVSteps& uvstep, const RGBSteps& rgbstep)
-    : PixelVectors<texture_enable>(cmd)
+  TriangleVectors(const GPUBackendDrawCommand* cmd, const GPUDrawingArea& drawing_area, const UVSteps& uvstep,
+                  const RGBSteps& rgbstep)
+    : PixelVectors<texture_enable>(cmd, drawing_area)
   {
     if constexpr (shading_enable)
     {
@@ -1202,8 +1206,8 @@ struct TriangleVectors : PixelVectors<texture_enable>
 
 template<bool shading_enable, TextureModulationMode modulation_mode, bool transparency_enable>
 ALWAYS_INLINE_RELEASE static void
-DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_start, s32 x_bound, UVStepper uv,
-         const UVSteps& RESTRICT uvstep, RGBStepper rgb, const RGBSteps& RESTRICT rgbstep,
+DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, const GPUDrawingArea& drawing_area, s32 y, s32 x_start,
+         s32 x_bound, UVStepper uv, const UVSteps& RESTRICT uvstep, RGBStepper rgb, const RGBSteps& RESTRICT rgbstep,
          const TriangleVectors<shading_enable, modulation_mode != TextureModulationMode::Disabled>& RESTRICT tv)
 {
   static constexpr bool texture_enable = (modulation_mode != TextureModulationMode::Disabled);
@@ -1212,16 +1216,16 @@ DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_start, s32 x_bo
   s32 current_x = TruncateGPUVertexPosition(x_start);
 
   // Skip pixels outside of the scissor rectangle.
-  if (current_x < static_cast<s32>(g_drawing_area.left))
+  if (current_x < static_cast<s32>(drawing_area.left))
   {
-    const s32 delta = static_cast<s32>(g_drawing_area.left) - current_x;
+    const s32 delta = static_cast<s32>(drawing_area.left) - current_x;
     x_start += delta;
     current_x += delta;
     width -= delta;
   }
 
-  if ((current_x + width) > (static_cast<s32>(g_drawing_area.right) + 1))
-    width = static_cast<s32>(g_drawing_area.right) + 1 - current_x;
+  if ((current_x + width) > (static_cast<s32>(drawing_area.right) + 1))
+    width = static_cast<s32>(drawing_area.right) + 1 - current_x;
 
   if (width <= 0)
     return;
@@ -1313,6 +1317,7 @@ DrawSpan(const GPUBackendDrawCommand* RESTRICT cmd, s32 y, s32 x_start, s32 x_bo
 
 template<bool shading_enable, TextureModulationMode modulation_mode, bool transparency_enable>
 ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand* RESTRICT cmd,
+                                                   const GPUDrawingArea& drawing_area,
                                                    const TrianglePart& RESTRICT tp, const UVStepper& RESTRICT uv,
                                                    const UVSteps& RESTRICT uvstep, const RGBStepper& RESTRICT rgb,
                                                    const RGBSteps& RESTRICT rgbstep)
@@ -1340,7 +1345,7 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
     if constexpr (shading_enable)
       lrgb.StepY(rgbstep, current_y);
 
-    const TriangleVectors<shading_enable, texture_enable> tv(cmd, uvstep, rgbstep);
+    const TriangleVectors<shading_enable, texture_enable> tv(cmd, drawing_area, uvstep, rgbstep);
 
     do
     {
@@ -1349,7 +1354,7 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       right_x -= right_x_step;
 
       const s32 y = TruncateGPUVertexPosition(current_y);
-      if (y < static_cast<s32>(g_drawing_area.top))
+      if (y < static_cast<s32>(drawing_area.top))
         break;
 
       // Opposite direction means we need to subtract when stepping instead of adding.
@@ -1358,15 +1363,15 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
       if constexpr (shading_enable)
         lrgb.StepY<true>(rgbstep);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom) ||
+      if (y > static_cast<s32>(drawing_area.bottom) ||
           (cmd->interlaced_rendering &&
            cmd->active_line_lsb == ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
       {
         continue;
       }
 
-      DrawSpan<shading_enable, modulation_mode, transparency_enable>(cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x),
-                                                                     unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
+      DrawSpan<shading_enable, modulation_mode, transparency_enable>(
+        cmd, drawing_area, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
     } while (current_y > end_y);
   }
   else
@@ -1382,22 +1387,23 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
     if constexpr (shading_enable)
       lrgb.StepY(rgbstep, current_y);
 
-    const TriangleVectors<shading_enable, texture_enable> tv(cmd, uvstep, rgbstep);
+    const TriangleVectors<shading_enable, texture_enable> tv(cmd, drawing_area, uvstep, rgbstep);
 
     do
     {
       const s32 y = TruncateGPUVertexPosition(current_y);
 
-      if (y > static_cast<s32>(g_drawing_area.bottom))
+      if (y > static_cast<s32>(drawing_area.bottom))
       {
         break;
       }
-      if (y >= static_cast<s32>(g_drawing_area.top) &&
+      if (y >= static_cast<s32>(drawing_area.top) &&
           (!cmd->interlaced_rendering ||
            cmd->active_line_lsb != ConvertToBoolUnchecked(static_cast<u32>(current_y) & 1u)))
       {
-        DrawSpan<shading_enable, modulation_mode, transparency_enable>(
-          cmd, y & VRAM_HEIGHT_MASK, unfp_xy(left_x), unfp_xy(right_x), luv, uvstep, lrgb, rgbstep, tv);
+        DrawSpan<shading_enable, modulation_mode, transparency_enable>(cmd, drawing_area, y & VRAM_HEIGHT_MASK,
+                                                                       unfp_xy(left_x), unfp_xy(right_x), luv, uvstep,
+                                                                       lrgb, rgbstep, tv);
       }
 
       current_y++;
@@ -1415,7 +1421,7 @@ ALWAYS_INLINE_RELEASE static void DrawTrianglePart(const GPUBackendDrawCommand*
 #endif // USE_VECTOR
 
 template<bool shading_enable, TextureModulationMode modulation_mode, bool transparency_enable>
-static void DrawTriangle(const GPUBackendDrawCommand* RESTRICT cmd,
+static void DrawTriangle(const GPUBackendDrawCommand* RESTRICT cmd, const GPUDrawingArea& drawing_area,
                          const GPUBackendDrawPolygonCommand::Vertex* RESTRICT v0,
                          const GPUBackendDrawPolygonCommand::Vertex* RESTRICT v1,
                          const GPUBackendDrawPolygonCommand::Vertex* RESTRICT v2)
@@ -1556,12 +1562,13 @@ static void DrawTriangle(const GPUBackendDrawCommand* RESTRICT cmd,
 
   for (u32 i = 0; i < 2; i++)
   {
-    DrawTrianglePart<shading_enable, modulation_mode, transparency_enable>(cmd, triparts[i], uv, uvstep, rgb, rgbstep);
+    DrawTrianglePart<shading_enable, modulation_mode, transparency_enable>(cmd, drawing_area, triparts[i], uv, uvstep,
+                                                                           rgb, rgbstep);
   }
 
 #ifdef CHECK_VECTOR
   CHECK_VRAM(GPU_SW_Rasterizer::DrawTriangleFunctions[shading_enable][u8(modulation_mode)][transparency_enable](
-    cmd, orig_v0, orig_v1, orig_v2));
+    cmd, drawing_area, orig_v0, orig_v1, orig_v2));
 #endif
 }
 
@@ -1822,9 +1829,11 @@ static void WriteVRAMImpl(u32 x, u32 y, u32 width, u32 height, const void* RESTR
       for (; col < width;)
       {
         // TODO: Handle unaligned reads...
+        // Masked pixels still consume a source pixel, same as the vector path above.
         u16* RESTRICT pixel_ptr = &dst_row_ptr[(x + col++) % VRAM_WIDTH];
+        const u16 src_pixel = *(src_ptr++);
         if (((*pixel_ptr) & mask_and) == 0)
-          *pixel_ptr = *(src_ptr++) | mask_or;
+          *pixel_ptr = src_pixel | mask_or;
       }
     }
   }
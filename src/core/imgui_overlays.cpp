@@ -521,6 +521,12 @@ void ImGuiManager::DrawPerformanceOverlay(const GPUBackend* gpu, float& position
         position_y += spacing;
       }
 
+      if (System::FormatMemorySaveStateStats(text))
+      {
+        DrawPerformanceStat(dl, position_y, fixed_font, fixed_font_size, FIXED_BOLD_WEIGHT, 0, rbound, text);
+        position_y += spacing;
+      }
+
 #ifndef __ANDROID__
       if (MediaCapture* cap = System::GetMediaCapture())
       {
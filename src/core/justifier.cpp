@@ -207,6 +207,12 @@ bool Justifier::Transfer(const u8 data_in, u8* data_out)
   }
 }
 
+bool Justifier::IsInputOnlyReadByTransfers() const
+{
+  // The IRQ is scheduled from the aim position.
+  return false;
+}
+
 void Justifier::UpdatePosition()
 {
   if (m_shoot_offscreen > 0)
@@ -48,6 +48,8 @@ public:
   void ResetTransferState() override;
   bool Transfer(const u8 data_in, u8* data_out) override;
 
+  bool IsInputOnlyReadByTransfers() const override;
+
 private:
   bool IsTriggerPressed() const;
   void UpdatePosition();
@@ -5,6 +5,7 @@
 #include "cdrom.h"
 #include "cpu_core.h"
 #include "dma.h"
+#include "mdec_dsp.h"
 #include "system.h"
 #include "timing_event.h"
 
@@ -15,6 +16,7 @@
 #include "common/fifo_queue.h"
 #include "common/gsvector.h"
 #include "common/log.h"
+#include "common/task_queue.h"
 
 #include "imgui.h"
 
@@ -110,8 +112,13 @@ static void HandleSetQuantTableCommand();
 static void HandleSetScaleCommand();
 
 static void SetScaleMatrix(const u16* values);
+static void UpdateIDCTMatrix();
 static bool DecodeMonoMacroblock();
 static bool DecodeColoredMacroblock();
+static void TransformBlocks(u32 last_block);
+static void StartTransform(bool colored, u32 first_block);
+static void TransformMacroblock(bool colored, u32 first_block, bool signed_output);
+static void WaitForTransform();
 static void ScheduleBlockCopyOut(TickCount ticks);
 static void CopyOutBlock(void* param, TickCount ticks, TickCount ticks_late);
 
@@ -123,9 +130,9 @@ static void YUVToRGB_Old(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const
 static bool DecodeRLE_New(s16* blk, const u8* qt);
 static void IDCT_New(s16* blk);
 static void YUVToRGB_New(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                         const std::array<s16, 64>& Yblk);
+                         const std::array<s16, 64>& Yblk, bool signed_output);
 
-static void YUVToMono(const std::array<s16, 64>& Yblk);
+static void YUVToMono(const std::array<s16, 64>& Yblk, bool signed_output);
 
 namespace {
 struct MDECState
@@ -146,15 +153,27 @@ struct MDECState
 
   alignas(VECTOR_ALIGNMENT) std::array<s16, 64> scale_table{};
 
+  // Scale table with the columns interleaved in pairs, for computing a whole row of the IDCT at once.
+  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> idct_matrix{};
+
   // blocks, for colour: 0 - Crblk, 1 - Cbblk, 2-5 - Y 1-4
   alignas(VECTOR_ALIGNMENT) std::array<std::array<s16, 64>, NUM_BLOCKS> blocks;
   u32 current_block = 0;        // block (0-5)
   u32 current_coefficient = 64; // k (in block)
   u16 current_q_scale = 0;
 
+  // Blocks before this one have already been through the IDCT. With the new routines, the IDCT is deferred until the
+  // whole macroblock has been decoded, so that it can be done together with the conversion to RGB.
+  u32 blocks_transformed = 0;
+
   alignas(VECTOR_ALIGNMENT) std::array<u32, 256> block_rgb{};
   TimingEvent block_copy_out_event{"MDEC Block Copy Out", 1, 1, &MDEC::CopyOutBlock, nullptr};
 
+  // With async decoding, the IDCT and colour conversion of a macroblock run on the worker while it is waiting to be
+  // copied out. The worker owns blocks and block_rgb until the transform completes.
+  TaskQueue transform_queue;
+  bool transform_pending = false;
+
 #if defined(_DEBUG) || defined(_DEVEL)
   u32 total_blocks_decoded = 0;
 #endif
@@ -170,14 +189,24 @@ void MDEC::Initialize()
   s_state.total_blocks_decoded = 0;
 #endif
   s_state.active_frame_count = 0;
+  s_state.transform_queue.SetWorkerCount(g_settings.mdec_async_decode ? 1 : 0);
   Reset();
 }
 
 void MDEC::Shutdown()
 {
+  WaitForTransform();
+  s_state.transform_queue.SetWorkerCount(0);
   s_state.block_copy_out_event.Deactivate();
 }
 
+void MDEC::SetAsyncDecode(bool enabled)
+{
+  DEV_LOG("{} asynchronous MDEC decoding.", enabled ? "Enabling" : "Disabling");
+  WaitForTransform();
+  s_state.transform_queue.SetWorkerCount(enabled ? 1 : 0);
+}
+
 void MDEC::Reset()
 {
   s_state.active_frame_count = 0;
@@ -187,6 +216,11 @@ void MDEC::Reset()
 
 bool MDEC::DoState(StateWrapper& sw)
 {
+  // Save states store the blocks after the IDCT, so finish any deferred work.
+  WaitForTransform();
+  if (!sw.IsReading())
+    TransformBlocks(s_state.current_block);
+
   sw.Do(&s_state.status.bits);
   sw.Do(&s_state.enable_dma_in);
   sw.Do(&s_state.enable_dma_out);
@@ -206,6 +240,8 @@ bool MDEC::DoState(StateWrapper& sw)
   else
   {
     sw.Do(&s_state.scale_table);
+    if (sw.IsReading())
+      UpdateIDCTMatrix();
   }
 
   sw.Do(&s_state.blocks);
@@ -213,6 +249,8 @@ bool MDEC::DoState(StateWrapper& sw)
   sw.Do(&s_state.current_coefficient);
   sw.Do(&s_state.current_q_scale);
   sw.Do(&s_state.block_rgb);
+  if (sw.IsReading())
+    s_state.blocks_transformed = s_state.current_block;
 
   bool block_copy_out_pending = HasPendingBlockCopyOut();
   sw.Do(&block_copy_out_pending);
@@ -329,6 +367,7 @@ bool MDEC::HasPendingBlockCopyOut()
 
 void MDEC::SoftReset()
 {
+  WaitForTransform();
   s_state.status.bits = 0;
   s_state.enable_dma_in = false;
   s_state.enable_dma_out = false;
@@ -339,6 +378,7 @@ void MDEC::SoftReset()
   s_state.current_block = 0;
   s_state.current_coefficient = 64;
   s_state.current_q_scale = 0;
+  s_state.blocks_transformed = 0;
   s_state.block_copy_out_event.Deactivate();
   UpdateStatus();
 }
@@ -348,6 +388,7 @@ void MDEC::ResetDecoder()
   s_state.current_block = 0;
   s_state.current_coefficient = 64;
   s_state.current_q_scale = 0;
+  s_state.blocks_transformed = 0;
 }
 
 void MDEC::UpdateStatus()
@@ -565,15 +606,16 @@ bool MDEC::DecodeMonoMacroblock()
   {
     if (!DecodeRLE_New(s_state.blocks[0].data(), s_state.iq_y.data()))
       return false;
-
-    IDCT_New(s_state.blocks[0].data());
   }
 
   DEBUG_LOG("Decoded mono macroblock, {} words remaining", s_state.remaining_halfwords / 2);
   ResetDecoder();
   s_state.state = State::WritingMacroblock;
 
-  YUVToMono(s_state.blocks[0]);
+  if (g_settings.mdec_use_old_routines) [[unlikely]]
+    YUVToMono(s_state.blocks[0], s_state.status.data_output_signed);
+  else
+    StartTransform(false, 0);
 
   ScheduleBlockCopyOut(TICKS_PER_BLOCK * 6);
 
@@ -593,7 +635,7 @@ bool MDEC::DecodeColoredMacroblock()
                          (s_state.current_block >= 2) ? s_state.iq_y.data() : s_state.iq_uv.data()))
         return false;
 
-      IDCT_Old(s_state.blocks[s_state.current_block].data());
+      TransformBlocks(s_state.current_block + 1);
     }
 
     if (!s_state.data_out_fifo.IsEmpty())
@@ -616,8 +658,6 @@ bool MDEC::DecodeColoredMacroblock()
       if (!DecodeRLE_New(s_state.blocks[s_state.current_block].data(),
                          (s_state.current_block >= 2) ? s_state.iq_y.data() : s_state.iq_uv.data()))
         return false;
-
-      IDCT_New(s_state.blocks[s_state.current_block].data());
     }
 
     if (!s_state.data_out_fifo.IsEmpty())
@@ -625,13 +665,11 @@ bool MDEC::DecodeColoredMacroblock()
 
     // done decoding
     DEBUG_LOG("Decoded colored macroblock, {} words remaining", s_state.remaining_halfwords / 2);
+    const u32 first_block = s_state.blocks_transformed;
     ResetDecoder();
     s_state.state = State::WritingMacroblock;
 
-    YUVToRGB_New(0, 0, s_state.blocks[0], s_state.blocks[1], s_state.blocks[2]);
-    YUVToRGB_New(8, 0, s_state.blocks[0], s_state.blocks[1], s_state.blocks[3]);
-    YUVToRGB_New(0, 8, s_state.blocks[0], s_state.blocks[1], s_state.blocks[4]);
-    YUVToRGB_New(8, 8, s_state.blocks[0], s_state.blocks[1], s_state.blocks[5]);
+    StartTransform(true, first_block);
   }
 
 #if defined(_DEBUG) || defined(_DEVEL)
@@ -642,6 +680,59 @@ bool MDEC::DecodeColoredMacroblock()
   return true;
 }
 
+void MDEC::TransformBlocks(u32 last_block)
+{
+  for (; s_state.blocks_transformed < last_block; s_state.blocks_transformed++)
+  {
+    if (g_settings.mdec_use_old_routines) [[unlikely]]
+      IDCT_Old(s_state.blocks[s_state.blocks_transformed].data());
+    else
+      IDCT_New(s_state.blocks[s_state.blocks_transformed].data());
+  }
+}
+
+void MDEC::StartTransform(bool colored, u32 first_block)
+{
+  // The output format can change while the macroblock is waiting to be copied out, so capture it now.
+  const bool signed_output = s_state.status.data_output_signed;
+  if (!g_settings.mdec_async_decode)
+  {
+    TransformMacroblock(colored, first_block, signed_output);
+    return;
+  }
+
+  s_state.transform_pending = true;
+  s_state.transform_queue.SubmitTask(
+    [colored, first_block, signed_output]() { TransformMacroblock(colored, first_block, signed_output); });
+}
+
+void MDEC::TransformMacroblock(bool colored, u32 first_block, bool signed_output)
+{
+  if (!colored)
+  {
+    IDCT_New(s_state.blocks[0].data());
+    YUVToMono(s_state.blocks[0], signed_output);
+    return;
+  }
+
+  for (u32 i = first_block; i < NUM_BLOCKS; i++)
+    IDCT_New(s_state.blocks[i].data());
+
+  YUVToRGB_New(0, 0, s_state.blocks[0], s_state.blocks[1], s_state.blocks[2], signed_output);
+  YUVToRGB_New(8, 0, s_state.blocks[0], s_state.blocks[1], s_state.blocks[3], signed_output);
+  YUVToRGB_New(0, 8, s_state.blocks[0], s_state.blocks[1], s_state.blocks[4], signed_output);
+  YUVToRGB_New(8, 8, s_state.blocks[0], s_state.blocks[1], s_state.blocks[5], signed_output);
+}
+
+void MDEC::WaitForTransform()
+{
+  if (!s_state.transform_pending)
+    return;
+
+  s_state.transform_queue.WaitForAll();
+  s_state.transform_pending = false;
+}
+
 void MDEC::ScheduleBlockCopyOut(TickCount ticks)
 {
   DebugAssert(!HasPendingBlockCopyOut());
@@ -654,6 +745,7 @@ void MDEC::CopyOutBlock(void* param, TickCount ticks, TickCount ticks_late)
 {
   Assert(s_state.state == State::WritingMacroblock);
   s_state.block_copy_out_event.Deactivate();
+  WaitForTransform();
 
   switch (s_state.status.data_output_depth)
   {
@@ -1049,36 +1141,15 @@ bool MDEC::DecodeRLE_New(s16* blk, const u8* qt)
   return false;
 }
 
-static s16 IDCTRow(const s16* blk, const s16* idct_matrix)
-{
-  // IDCT matrix is -32768..32767, block is -16384..16383. 4 adds can happen without overflow.
-  GSVector4i sum = GSVector4i::load<false>(blk).madd_s16(GSVector4i::load<true>(idct_matrix)).addp_s32();
-  return static_cast<s16>(((static_cast<s64>(sum.extract32<0>()) + static_cast<s64>(sum.extract32<1>())) + 0x20000) >>
-                          18);
-}
-
 void MDEC::IDCT_New(s16* blk)
 {
-  alignas(VECTOR_ALIGNMENT) std::array<s16, 64> temp;
-  for (u32 x = 0; x < 8; x++)
-  {
-    for (u32 y = 0; y < 8; y++)
-      temp[y * 8 + x] = IDCTRow(&blk[x * 8], &s_state.scale_table[y * 8]);
-  }
-  for (u32 x = 0; x < 8; x++)
-  {
-    for (u32 y = 0; y < 8; y++)
-    {
-      const s32 sum = IDCTRow(&temp[x * 8], &s_state.scale_table[y * 8]);
-      blk[x * 8 + y] = static_cast<s16>(std::clamp(SignExtendN<9, s32>(sum), -128, 127));
-    }
-  }
+  DSP::IDCT(blk, s_state.idct_matrix.data());
 }
 
 void MDEC::YUVToRGB_New(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                        const std::array<s16, 64>& Yblk)
+                        const std::array<s16, 64>& Yblk, bool signed_output)
 {
-  const GSVector4i addval = s_state.status.data_output_signed ? GSVector4i::cxpr(0) : GSVector4i::cxpr(0x80808080);
+  const GSVector4i addval = signed_output ? GSVector4i::cxpr(0) : GSVector4i::cxpr(0x80808080);
   for (u32 y = 0; y < 8; y++)
   {
     const GSVector4i Cr = GSVector4i::loadl<false>(&Crblk[(xx / 2) + ((y + yy) / 2) * 8]).s16to32();
@@ -1113,9 +1184,9 @@ void MDEC::YUVToRGB_New(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const
   }
 }
 
-void MDEC::YUVToMono(const std::array<s16, 64>& Yblk)
+void MDEC::YUVToMono(const std::array<s16, 64>& Yblk, bool signed_output)
 {
-  const s32 addval = s_state.status.data_output_signed ? 0 : 0x80;
+  const s32 addval = signed_output ? 0 : 0x80;
   for (u32 i = 0; i < 64; i++)
     s_state.block_rgb[i] = static_cast<u32>(std::clamp(SignExtendN<9, s32>(Yblk[i]), -128, 127) + addval);
 }
@@ -1156,6 +1227,13 @@ void MDEC::SetScaleMatrix(const u16* values)
     for (u32 x = 0; x < 8; x++)
       s_state.scale_table[y * 8 + x] = values[x * 8 + y];
   }
+
+  UpdateIDCTMatrix();
+}
+
+void MDEC::UpdateIDCTMatrix()
+{
+  DSP::ComputeIDCTMatrix(s_state.scale_table, &s_state.idct_matrix);
 }
 
 void MDEC::DrawDebugStateWindow(float scale)
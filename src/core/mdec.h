@@ -14,6 +14,9 @@ void Shutdown();
 void Reset();
 bool DoState(StateWrapper& sw);
 
+/// Moves the IDCT and colour conversion to a worker thread. Output is still copied out at the same emulated time.
+void SetAsyncDecode(bool enabled);
+
 bool IsActive();
 bool IsDecodingMacroblock();
 void EndFrame();
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "common/gsvector.h"
+#include "common/types.h"
+
+#include <array>
+
+// Block transforms of the MDEC that don't touch its state, so they can be tested on their own.
+namespace MDEC::DSP {
+
+// Interleaves the columns of the scale table in pairs, for computing a whole row of the IDCT at once.
+inline void ComputeIDCTMatrix(const std::array<s16, 64>& scale_table, std::array<s16, 64>* idct_matrix)
+{
+  // Layout is [pair][y][2], so that a multiply-add of a broadcast pair of inputs produces four outputs.
+  for (u32 pair = 0; pair < 4; pair++)
+  {
+    for (u32 y = 0; y < 8; y++)
+    {
+      (*idct_matrix)[pair * 16 + y * 2 + 0] = scale_table[y * 8 + pair * 2 + 0];
+      (*idct_matrix)[pair * 16 + y * 2 + 1] = scale_table[y * 8 + pair * 2 + 1];
+    }
+  }
+}
+
+ALWAYS_INLINE GSVector4i IDCTRow(const GSVector4i& row, const s16* idct_matrix)
+{
+  // Computes sum(row[k] * scale[y][k]) for all eight y at once. IDCT matrix is -32768..32767, block is
+  // -16384..16383, so each half of the sum can be done in 32 bits, the same as the pairwise-add version.
+  const GSVector4i m0 = GSVector4i::load<true>(&idct_matrix[0]);
+  const GSVector4i m1 = GSVector4i::load<true>(&idct_matrix[8]);
+  const GSVector4i m2 = GSVector4i::load<true>(&idct_matrix[16]);
+  const GSVector4i m3 = GSVector4i::load<true>(&idct_matrix[24]);
+  const GSVector4i m4 = GSVector4i::load<true>(&idct_matrix[32]);
+  const GSVector4i m5 = GSVector4i::load<true>(&idct_matrix[40]);
+  const GSVector4i m6 = GSVector4i::load<true>(&idct_matrix[48]);
+  const GSVector4i m7 = GSVector4i::load<true>(&idct_matrix[56]);
+  const GSVector4i p0 = row.xxxx();
+  const GSVector4i p1 = row.yyyy();
+  const GSVector4i p2 = row.zzzz();
+  const GSVector4i p3 = row.wwww();
+  const GSVector4i lo_a = p0.madd_s16(m0).add32(p1.madd_s16(m2));
+  const GSVector4i hi_a = p0.madd_s16(m1).add32(p1.madd_s16(m3));
+  const GSVector4i lo_b = p2.madd_s16(m4).add32(p3.madd_s16(m6));
+  const GSVector4i hi_b = p2.madd_s16(m5).add32(p3.madd_s16(m7));
+
+  // (s64(a) + s64(b) + 0x20000) >> 18, split so that it doesn't need 64-bit lanes.
+  static constexpr auto combine = [](const GSVector4i& a, const GSVector4i& b) {
+    const GSVector4i low_bits = GSVector4i::cxpr(0x3FFFF);
+    const GSVector4i carry =
+      (a & low_bits).add32(b & low_bits).add32(GSVector4i::cxpr(0x20000)).srl32<18>();
+    return a.sra32<18>().add32(b.sra32<18>()).add32(carry);
+  };
+  return combine(lo_a, lo_b).ps32(combine(hi_a, hi_b));
+}
+
+// Transforms a row-major block in place. idct_matrix comes from ComputeIDCTMatrix(), and must be aligned.
+inline void IDCT(s16* blk, const s16* idct_matrix)
+{
+  // First pass produces the columns of the intermediate block, transpose them back to rows for the second pass.
+  GSVector4i c0 = IDCTRow(GSVector4i::load<true>(&blk[0 * 8]), idct_matrix);
+  GSVector4i c1 = IDCTRow(GSVector4i::load<true>(&blk[1 * 8]), idct_matrix);
+  GSVector4i c2 = IDCTRow(GSVector4i::load<true>(&blk[2 * 8]), idct_matrix);
+  GSVector4i c3 = IDCTRow(GSVector4i::load<true>(&blk[3 * 8]), idct_matrix);
+  GSVector4i c4 = IDCTRow(GSVector4i::load<true>(&blk[4 * 8]), idct_matrix);
+  GSVector4i c5 = IDCTRow(GSVector4i::load<true>(&blk[5 * 8]), idct_matrix);
+  GSVector4i c6 = IDCTRow(GSVector4i::load<true>(&blk[6 * 8]), idct_matrix);
+  GSVector4i c7 = IDCTRow(GSVector4i::load<true>(&blk[7 * 8]), idct_matrix);
+
+  const GSVector4i a0 = c0.upl16(c1);
+  const GSVector4i a1 = c0.uph16(c1);
+  const GSVector4i a2 = c2.upl16(c3);
+  const GSVector4i a3 = c2.uph16(c3);
+  const GSVector4i a4 = c4.upl16(c5);
+  const GSVector4i a5 = c4.uph16(c5);
+  const GSVector4i a6 = c6.upl16(c7);
+  const GSVector4i a7 = c6.uph16(c7);
+  const GSVector4i b0 = a0.upl32(a2);
+  const GSVector4i b1 = a0.uph32(a2);
+  const GSVector4i b2 = a1.upl32(a3);
+  const GSVector4i b3 = a1.uph32(a3);
+  const GSVector4i b4 = a4.upl32(a6);
+  const GSVector4i b5 = a4.uph32(a6);
+  const GSVector4i b6 = a5.upl32(a7);
+  const GSVector4i b7 = a5.uph32(a7);
+  const GSVector4i rows[8] = {b0.upl64(b4), b0.uph64(b4), b1.upl64(b5), b1.uph64(b5),
+                              b2.upl64(b6), b2.uph64(b6), b3.upl64(b7), b3.uph64(b7)};
+
+  for (u32 x = 0; x < 8; x++)
+  {
+    // clamp(sext9(sum), -128, 127)
+    const GSVector4i sum = IDCTRow(rows[x], idct_matrix);
+    GSVector4i::store<true>(&blk[x * 8], sum.sll16<7>()
+                                           .sra16<7>()
+                                           .max_s16(GSVector4i::cxpr16(-128))
+                                           .min_s16(GSVector4i::cxpr16(127)));
+  }
+}
+
+} // namespace MDEC::DSP
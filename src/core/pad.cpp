@@ -141,6 +141,9 @@ struct PadState
 
   u32 last_memory_card_transfer_frame = 0;
   DynamicHeapArray<u8> memory_card_backup;
+
+  // Not saved, runahead uses it to tell whether anything read the controllers since a memory state was saved.
+  u64 controller_transfer_count = 0;
   std::unique_ptr<MemoryCard> dummy_card;
 };
 } // namespace
@@ -674,6 +677,22 @@ bool Pad::IsTransmitting()
   return s_state.state != State::Idle;
 }
 
+u64 Pad::GetControllerTransferCount()
+{
+  return s_state.controller_transfer_count;
+}
+
+bool Pad::IsInputOnlyReadByTransfers()
+{
+  for (const std::unique_ptr<Controller>& controller : s_state.controllers)
+  {
+    if (controller && !controller->IsInputOnlyReadByTransfers())
+      return false;
+  }
+
+  return true;
+}
+
 bool Pad::CanTransfer()
 {
   return s_state.transmit_buffer_full && s_state.JOY_CTRL.SELECT && s_state.JOY_CTRL.TXEN;
@@ -759,6 +778,10 @@ void Pad::DoTransfer(TickCount ticks_late)
   u8 data_in = 0xFF;
   bool ack = false;
 
+  // the first byte of a memory card access goes to the controller too
+  if (s_state.active_device != ActiveDevice::MemoryCard)
+    s_state.controller_transfer_count++;
+
   switch (s_state.active_device)
   {
     case ActiveDevice::None:
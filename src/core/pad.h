@@ -34,4 +34,10 @@ void WriteRegister(u32 offset, u32 value);
 
 bool IsTransmitting();
 
+/// Number of transfers which may have read a controller. Not saved in states, and only goes up.
+u64 GetControllerTransferCount();
+
+/// Returns false if any connected controller's input can affect the console outside of transfers.
+bool IsInputOnlyReadByTransfers();
+
 } // namespace Pad
@@ -281,8 +281,11 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   rewind_enable = si.GetBoolValue("Main", "RewindEnable", false);
   rewind_save_frequency = si.GetFloatValue("Main", "RewindFrequency", 10.0f);
   rewind_save_slots = static_cast<u16>(std::min(si.GetUIntValue("Main", "RewindSaveSlots", 10u), 65535u));
+  rewind_delta_states = si.GetBoolValue("Main", "RewindDeltaStates", false);
+  rewind_compress_states = si.GetBoolValue("Main", "RewindCompressStates", false);
   runahead_frames = static_cast<u8>(std::min(si.GetUIntValue("Main", "RunaheadFrameCount", 0u), 255u));
   runahead_for_analog_input = si.GetBoolValue("Main", "RunaheadForAnalogInput", false);
+  runahead_partial_replay = si.GetBoolValue("Main", "RunaheadPartialReplay", false);
 
   cpu_execution_mode = ParseCPUExecutionMode(si.GetStringViewValue("CPU", "ExecutionMode",
                                                                    GetCPUExecutionModeName(DEFAULT_CPU_EXECUTION_MODE)))
@@ -294,6 +297,10 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   cpu_recompiler_memory_exceptions = si.GetBoolValue("CPU", "RecompilerMemoryExceptions", false);
   cpu_recompiler_block_linking = si.GetBoolValue("CPU", "RecompilerBlockLinking", true);
   cpu_recompiler_icache = si.GetBoolValue("CPU", "RecompilerICache", false);
+  cpu_recompiler_background_compile = si.GetBoolValue("CPU", "RecompilerBackgroundCompile", false);
+  cpu_recompiler_block_cache = si.GetBoolValue("CPU", "RecompilerBlockCache", false);
+  cpu_recompiler_superblocks = si.GetBoolValue("CPU", "RecompilerSuperblocks", false);
+  cpu_recompiler_subpage_invalidation = si.GetBoolValue("CPU", "RecompilerSubPageInvalidation", false);
   cpu_fastmem_mode =
     ParseCPUFastmemMode(si.GetStringViewValue("CPU", "FastmemMode", GetCPUFastmemModeName(DEFAULT_CPU_FASTMEM_MODE)))
       .value_or(DEFAULT_CPU_FASTMEM_MODE);
@@ -319,6 +326,7 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   gpu_per_sample_shading = si.GetBoolValue("GPU", "PerSampleShading", false);
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
   gpu_max_queued_frames = static_cast<u8>(si.GetUIntValue("GPU", "MaxQueuedFrames", DEFAULT_GPU_MAX_QUEUED_FRAMES));
+  gpu_sw_threads = static_cast<u8>(std::min<u32>(si.GetUIntValue("GPU", "SoftwareRendererThreads", 0u), 64u));
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
   gpu_use_software_renderer_for_memory_states = si.GetBoolValue("GPU", "UseSoftwareRendererForMemoryStates", false);
   gpu_scaled_interlacing = si.GetBoolValue("GPU", "ScaledInterlacing", true);
@@ -452,6 +460,10 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
 
   cdrom_readahead_sectors =
     static_cast<u8>(si.GetIntValue("CDROM", "ReadaheadSectors", DEFAULT_CDROM_READAHEAD_SECTORS));
+  cdrom_decompression_cache_blocks = static_cast<u8>(std::clamp<u32>(
+    si.GetUIntValue("CDROM", "DecompressionCacheBlocks", DEFAULT_CDROM_DECOMPRESSION_CACHE_BLOCKS), 1, 64));
+  cdrom_decompression_prefetch_blocks = static_cast<u8>(std::min<u32>(
+    si.GetUIntValue("CDROM", "DecompressionPrefetchBlocks", DEFAULT_CDROM_DECOMPRESSION_PREFETCH_BLOCKS), 16));
   cdrom_mechacon_version =
     ParseCDROMMechVersionName(
       si.GetStringViewValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(DEFAULT_CDROM_MECHACON_VERSION)))
@@ -461,6 +473,7 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   cdrom_load_image_to_ram = si.GetBoolValue("CDROM", "LoadImageToRAM", false);
   cdrom_load_image_patches = si.GetBoolValue("CDROM", "LoadImagePatches", false);
   cdrom_ignore_host_subcode = si.GetBoolValue("CDROM", "IgnoreHostSubcode", false);
+  cdrom_memory_map_images = si.GetBoolValue("CDROM", "MemoryMapImages", false);
   cdrom_mute_cd_audio = si.GetBoolValue("CDROM", "MuteCDAudio", false);
   cdrom_auto_disc_change = si.GetBoolValue("CDROM", "AutoDiscChange", false);
   cdrom_read_speedup = si.GetSaturatedIntValue<u8>("CDROM", "ReadSpeedup", 1);
@@ -484,6 +497,8 @@ void Settings::Load(const SettingsInterface& si, const SettingsInterface& contro
   audio_output_muted = si.GetBoolValue("Audio", "OutputMuted", false);
 
   mdec_use_old_routines = si.GetBoolValue("Hacks", "UseOldMDECRoutines", false);
+  mdec_async_decode = si.GetBoolValue("Hacks", "MDECAsyncDecode", false);
+  spu_predict_ram_irq = si.GetBoolValue("Hacks", "SPUPredictRAMIRQ", false);
   export_shared_memory = si.GetBoolValue("Hacks", "ExportSharedMemory", false);
 
   dma_max_slice_ticks = si.GetIntValue("Hacks", "DMAMaxSliceTicks", DEFAULT_DMA_MAX_SLICE_TICKS);
@@ -676,8 +691,11 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("Main", "RewindEnable", rewind_enable);
   si.SetFloatValue("Main", "RewindFrequency", rewind_save_frequency);
   si.SetUIntValue("Main", "RewindSaveSlots", rewind_save_slots);
+  si.SetBoolValue("Main", "RewindDeltaStates", rewind_delta_states);
+  si.SetBoolValue("Main", "RewindCompressStates", rewind_compress_states);
   si.SetUIntValue("Main", "RunaheadFrameCount", runahead_frames);
   si.SetBoolValue("Main", "RunaheadForAnalogInput", runahead_for_analog_input);
+  si.SetBoolValue("Main", "RunaheadPartialReplay", runahead_partial_replay);
 
   si.SetStringValue("CPU", "ExecutionMode", GetCPUExecutionModeName(cpu_execution_mode));
   si.SetBoolValue("CPU", "OverclockEnable", cpu_overclock_enable);
@@ -686,6 +704,10 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("CPU", "RecompilerMemoryExceptions", cpu_recompiler_memory_exceptions);
   si.SetBoolValue("CPU", "RecompilerBlockLinking", cpu_recompiler_block_linking);
   si.SetBoolValue("CPU", "RecompilerICache", cpu_recompiler_icache);
+  si.SetBoolValue("CPU", "RecompilerBackgroundCompile", cpu_recompiler_background_compile);
+  si.SetBoolValue("CPU", "RecompilerBlockCache", cpu_recompiler_block_cache);
+  si.SetBoolValue("CPU", "RecompilerSuperblocks", cpu_recompiler_superblocks);
+  si.SetBoolValue("CPU", "RecompilerSubPageInvalidation", cpu_recompiler_subpage_invalidation);
   si.SetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(cpu_fastmem_mode));
 
   si.SetStringValue("GPU", "Renderer", GetRendererName(gpu_renderer));
@@ -711,6 +733,7 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
 
   si.SetBoolValue("GPU", "PerSampleShading", gpu_per_sample_shading);
   si.SetUIntValue("GPU", "MaxQueuedFrames", gpu_max_queued_frames);
+  si.SetUIntValue("GPU", "SoftwareRendererThreads", gpu_sw_threads);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
   si.SetBoolValue("GPU", "UseSoftwareRendererForReadbacks", gpu_use_software_renderer_for_readbacks);
   si.SetBoolValue("GPU", "UseSoftwareRendererForMemoryStates", gpu_use_software_renderer_for_memory_states);
@@ -806,12 +829,15 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("Display", "AutoResizeWindow", display_auto_resize_window);
 
   si.SetIntValue("CDROM", "ReadaheadSectors", cdrom_readahead_sectors);
+  si.SetIntValue("CDROM", "DecompressionCacheBlocks", cdrom_decompression_cache_blocks);
+  si.SetIntValue("CDROM", "DecompressionPrefetchBlocks", cdrom_decompression_prefetch_blocks);
   si.SetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(cdrom_mechacon_version));
   si.SetBoolValue("CDROM", "RegionCheck", cdrom_region_check);
   si.SetBoolValue("CDROM", "SubQSkew", cdrom_subq_skew);
   si.SetBoolValue("CDROM", "LoadImageToRAM", cdrom_load_image_to_ram);
   si.SetBoolValue("CDROM", "LoadImagePatches", cdrom_load_image_patches);
   si.SetBoolValue("CDROM", "IgnoreHostSubcode", cdrom_ignore_host_subcode);
+  si.SetBoolValue("CDROM", "MemoryMapImages", cdrom_memory_map_images);
   si.SetBoolValue("CDROM", "MuteCDAudio", cdrom_mute_cd_audio);
   si.SetBoolValue("CDROM", "AutoDiscChange", cdrom_auto_disc_change);
   si.SetUIntValue("CDROM", "ReadSpeedup", cdrom_read_speedup);
@@ -829,6 +855,8 @@ void Settings::Save(SettingsInterface& si, bool ignore_base) const
   si.SetBoolValue("Audio", "OutputMuted", audio_output_muted);
 
   si.SetBoolValue("Hacks", "UseOldMDECRoutines", mdec_use_old_routines);
+  si.SetBoolValue("Hacks", "MDECAsyncDecode", mdec_async_decode);
+  si.SetBoolValue("Hacks", "SPUPredictRAMIRQ", spu_predict_ram_irq);
   si.SetBoolValue("Hacks", "ExportSharedMemory", export_shared_memory);
 
   if (!ignore_base)
@@ -1147,6 +1175,7 @@ void Settings::ApplySettingRestrictions()
     bios_patch_fast_boot = false;
     runahead_frames = 0;
     runahead_for_analog_input = false;
+    runahead_partial_replay = false;
     rewind_enable = false;
     pio_device_type = PIODeviceType::None;
     pcdrv_enable = false;
@@ -54,6 +54,7 @@ struct GPUSettings
   DisplayScreenshotFormat display_screenshot_format = DEFAULT_DISPLAY_SCREENSHOT_FORMAT;
   u8 display_screenshot_quality = DEFAULT_DISPLAY_SCREENSHOT_QUALITY;
   u8 gpu_max_queued_frames = DEFAULT_GPU_MAX_QUEUED_FRAMES;
+  u8 gpu_sw_threads = 0;
   s16 display_active_start_offset = 0;
   s16 display_active_end_offset = 0;
   s8 display_line_start_offset = 0;
@@ -294,11 +295,18 @@ struct Settings : public GPUSettings
   bool cpu_recompiler_memory_exceptions : 1 = false;
   bool cpu_recompiler_block_linking : 1 = true;
   bool cpu_recompiler_icache : 1 = false;
+  bool cpu_recompiler_background_compile : 1 = false;
+  bool cpu_recompiler_block_cache : 1 = false;
+  bool cpu_recompiler_superblocks : 1 = false;
+  bool cpu_recompiler_subpage_invalidation : 1 = false;
   bool cpu_enable_8mb_ram : 1 = false;
 
   bool mdec_use_old_routines : 1 = false;
+  bool mdec_async_decode : 1 = false;
   bool mdec_disable_cdrom_speedup : 1 = false;
 
+  bool spu_predict_ram_irq : 1 = false;
+
   bool pcdrv_enable : 1 = false;
   bool pcdrv_enable_writes : 1 = false;
 
@@ -315,6 +323,7 @@ struct Settings : public GPUSettings
   bool cdrom_load_image_to_ram : 1 = false;
   bool cdrom_load_image_patches : 1 = false;
   bool cdrom_ignore_host_subcode : 1 = false;
+  bool cdrom_memory_map_images : 1 = false;
   bool cdrom_mute_cd_audio : 1 = false;
   bool cdrom_auto_disc_change : 1 = false;
 
@@ -323,7 +332,10 @@ struct Settings : public GPUSettings
   bool bios_fast_forward_boot : 1 = false;
 
   bool rewind_enable : 1 = false;
+  bool rewind_delta_states : 1 = false;
+  bool rewind_compress_states : 1 = false;
   bool runahead_for_analog_input : 1 = false;
+  bool runahead_partial_replay : 1 = false;
 
   bool apply_compatibility_settings : 1 = true;
   bool apply_game_settings : 1 = true;
@@ -335,6 +347,8 @@ struct Settings : public GPUSettings
   SaveStateCompressionMode save_state_compression = DEFAULT_SAVE_STATE_COMPRESSION_MODE;
 
   u8 cdrom_readahead_sectors = DEFAULT_CDROM_READAHEAD_SECTORS;
+  u8 cdrom_decompression_cache_blocks = DEFAULT_CDROM_DECOMPRESSION_CACHE_BLOCKS;
+  u8 cdrom_decompression_prefetch_blocks = DEFAULT_CDROM_DECOMPRESSION_PREFETCH_BLOCKS;
   CDROMMechaconVersion cdrom_mechacon_version = DEFAULT_CDROM_MECHACON_VERSION;
 
   u8 cdrom_read_speedup = 1;
@@ -627,6 +641,8 @@ struct Settings : public GPUSettings
 #endif
 
   static constexpr u8 DEFAULT_CDROM_READAHEAD_SECTORS = 8;
+  static constexpr u8 DEFAULT_CDROM_DECOMPRESSION_CACHE_BLOCKS = 16;
+  static constexpr u8 DEFAULT_CDROM_DECOMPRESSION_PREFETCH_BLOCKS = 0;
   static constexpr u32 DEFAULT_CDROM_MAX_SEEK_SPEEDUP_CYCLES = 30000;
   static constexpr u32 DEFAULT_CDROM_MAX_READ_SPEEDUP_CYCLES = 30000;
   static constexpr CDROMMechaconVersion DEFAULT_CDROM_MECHACON_VERSION = CDROMMechaconVersion::VC1A;
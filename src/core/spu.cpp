@@ -3,6 +3,7 @@
 
 #include "spu.h"
 #include "cdrom.h"
+#include "spu_dsp.h"
 #include "dma.h"
 #include "imgui_overlays.h"
 #include "interrupt_controller.h"
@@ -40,23 +41,22 @@ LOG_CHANNEL(SPU);
 #define SPU_ENABLE_VU_METER 1
 #endif
 
-ALWAYS_INLINE static constexpr s32 Clamp16(s32 value)
-{
-  return (value < -0x8000) ? -0x8000 : (value > 0x7FFF) ? 0x7FFF : value;
-}
-
 ALWAYS_INLINE static constexpr s32 ApplyVolume(s32 sample, s16 volume)
 {
   return (sample * s32(volume)) >> 15;
 }
 
 namespace SPU {
+
+using DSP::Clamp16;
+using DSP::NUM_REVERB_REGS;
+using DSP::NUM_VOICES;
+
 namespace {
 
 enum : u32
 {
   SPU_BASE = 0x1F801C00,
-  NUM_VOICES = 24,
   NUM_VOICE_REGISTERS = 8,
   VOICE_ADDRESS_SHIFT = 3,
   NUM_SAMPLES_PER_ADPCM_BLOCK = 28,
@@ -64,7 +64,6 @@ enum : u32
   SYSCLK_TICKS_PER_SPU_TICK = static_cast<u32>(System::MASTER_CLOCK) / static_cast<u32>(SAMPLE_RATE), // 0x300
   CAPTURE_BUFFER_SIZE_PER_CHANNEL = 0x400,
   MINIMUM_TICKS_BETWEEN_KEY_ON_OFF = 2,
-  NUM_REVERB_REGS = 32,
   FIFO_SIZE_IN_HALFWORDS = 32
 };
 enum : TickCount
@@ -277,7 +276,6 @@ struct Voice
   void ForceOff();
 
   void DecodeBlock(const ADPCMBlock& block);
-  s32 Interpolate() const;
 
   // Switches to the specified phase, filling in target.
   void UpdateADSREnvelope();
@@ -285,43 +283,6 @@ struct Voice
   // Updates the ADSR volume/phase.
   void TickADSR();
 };
-
-struct ReverbRegisters
-{
-  s16 vLOUT;
-  s16 vROUT;
-  u16 mBASE;
-
-  union
-  {
-    struct
-    {
-      u16 FB_SRC_A;
-      u16 FB_SRC_B;
-      s16 IIR_ALPHA;
-      s16 ACC_COEF_A;
-      s16 ACC_COEF_B;
-      s16 ACC_COEF_C;
-      s16 ACC_COEF_D;
-      s16 IIR_COEF;
-      s16 FB_ALPHA;
-      s16 FB_X;
-      u16 IIR_DEST_A[2];
-      u16 ACC_SRC_A[2];
-      u16 ACC_SRC_B[2];
-      u16 IIR_SRC_A[2];
-      u16 IIR_DEST_B[2];
-      u16 ACC_SRC_C[2];
-      u16 ACC_SRC_D[2];
-      u16 IIR_SRC_B[2];
-      u16 MIX_DEST_A[2];
-      u16 MIX_DEST_B[2];
-      s16 IN_COEF[2];
-    };
-
-    u16 rev[NUM_REVERB_REGS];
-  };
-};
 } // namespace
 
 template<bool COMPATIBILITY>
@@ -341,23 +302,25 @@ static bool IsRAMIRQTriggerable();
 static bool CheckRAMIRQ(u32 address);
 static void TriggerRAMIRQ();
 static void CheckForLateRAMIRQs();
+static u32 GetFramesUntilRAMIRQ(u32 max_frames);
+static void UpdateRAMIRQPrediction();
 
 static void WriteToCaptureBuffer(u32 index, s16 value);
 static void IncrementCaptureBufferPosition();
 
 static void ReadADPCMBlock(u16 address, ADPCMBlock* block);
-static std::tuple<s32, s32> SampleVoice(u32 voice_index);
+static void SampleVoices(s32* left_sum, s32* right_sum, s32* reverb_in_left, s32* reverb_in_right);
+static void AdvanceVoice(u32 voice_index, s32 left, s32 right);
 
 static void UpdateNoise();
 
-static u32 ReverbMemoryAddress(u32 address);
-static s16 ReverbRead(u32 address, s32 offset = 0);
-static void ReverbWrite(u32 address, s16 data);
+static void UpdateReverbOffsets();
 static void ProcessReverb(s32 left_in, s32 right_in, s32* left_out, s32* right_out);
 
 static void InternalGeneratePendingSamples();
 static void Execute(void* param, TickCount ticks, TickCount ticks_late);
 static void UpdateEventInterval();
+static void UpdatePredictedEventInterval(u32 max_slice_frames);
 
 static void ExecuteFIFOWriteToRAM(TickCount& ticks);
 static void ExecuteFIFOReadFromRAM(TickCount& ticks);
@@ -410,7 +373,8 @@ struct ALIGN_TO_CACHE_LINE SPUState
   u32 reverb_on_register = 0;
   u32 reverb_base_address = 0;
   u32 reverb_current_address = 0;
-  ReverbRegisters reverb_registers{};
+  DSP::ReverbRegisters reverb_registers{};
+  DSP::ReverbOffsets reverb_offsets{};
   std::array<std::array<s16, 128>, 2> reverb_downsample_buffer;
   std::array<std::array<s16, 64>, 2> reverb_upsample_buffer;
   s32 reverb_resample_buffer_position = 0;
@@ -575,6 +539,7 @@ void SPU::Reset()
   s_state.reverb_registers = {};
   s_state.reverb_registers.mBASE = 0;
   s_state.reverb_base_address = s_state.reverb_current_address = ZeroExtend32(s_state.reverb_registers.mBASE) << 2;
+  UpdateReverbOffsets();
   s_state.reverb_downsample_buffer = {};
   s_state.reverb_upsample_buffer = {};
   s_state.reverb_resample_buffer_position = 0;
@@ -719,6 +684,7 @@ bool SPU::DoCompatibleState(StateWrapper& sw)
 
   if (sw.IsReading())
   {
+    UpdateReverbOffsets();
     UpdateEventInterval();
     UpdateTransferEvent();
   }
@@ -901,6 +867,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
       DEBUG_LOG("SPU key on low <- 0x{:04X}", value);
       GeneratePendingSamples();
       s_state.key_on_register = (s_state.key_on_register & 0xFFFF0000) | ZeroExtend32(value);
+      UpdateRAMIRQPrediction();
     }
     break;
 
@@ -909,6 +876,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
       DEBUG_LOG("SPU key on high <- 0x{:04X}", value);
       GeneratePendingSamples();
       s_state.key_on_register = (s_state.key_on_register & 0x0000FFFF) | (ZeroExtend32(value) << 16);
+      UpdateRAMIRQPrediction();
     }
     break;
 
@@ -985,6 +953,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
       s_state.reverb_registers.mBASE = value;
       s_state.reverb_base_address = ZeroExtend32(value << 2) & 0x3FFFFu;
       s_state.reverb_current_address = s_state.reverb_base_address;
+      UpdateReverbOffsets();
     }
     break;
 
@@ -997,6 +966,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
       if (IsRAMIRQTriggerable())
         CheckForLateRAMIRQs();
 
+      UpdateRAMIRQPrediction();
       return;
     }
 
@@ -1155,6 +1125,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
         DEBUG_LOG("SPU reverb register {} <- 0x{:04X}", reg, value);
         GeneratePendingSamples();
         s_state.reverb_registers.rev[reg] = value;
+        UpdateReverbOffsets();
         return;
       }
 
@@ -1265,6 +1236,7 @@ void SPU::WriteVoiceRegister(u32 offset, u16 value)
       DEBUG_LOG("SPU voice {} ADPCM repeat address <- 0x{:04X}", voice_index, value);
       voice.regs.adpcm_repeat_address = value;
       voice.ignore_loop_address |= ignore_loop_address;
+      UpdateRAMIRQPrediction();
 
       if (!ignore_loop_address)
       {
@@ -1347,6 +1319,59 @@ void SPU::CheckForLateRAMIRQs()
   }
 }
 
+u32 SPU::GetFramesUntilRAMIRQ(u32 max_frames)
+{
+  // Pending key ons restart voices after the next frame, so just step that frame and predict again afterwards.
+  if (s_state.key_on_register != 0)
+    return 1;
+
+  u32 frames = max_frames;
+
+  // Capture buffers are written once per frame, one halfword into each of the four channels.
+  const u32 irq_ram_address = ZeroExtend32(s_state.irq_address) * 8;
+  if (irq_ram_address < (CAPTURE_BUFFER_SIZE_PER_CHANNEL * 4))
+  {
+    const u32 distance = ((irq_ram_address % CAPTURE_BUFFER_SIZE_PER_CHANNEL) - s_state.capture_buffer_position) %
+                         CAPTURE_BUFFER_SIZE_PER_CHANNEL;
+    frames = std::min(frames, static_cast<u32>(distance / sizeof(s16)) + 1);
+  }
+
+  // Voices can only hit the IRQ address when reading a new block. The step is capped at 0x3FFF, so a voice can't
+  // leave a block before the counter has covered the remaining samples at that rate, and since the counter is at most
+  // 0x3FFF after moving to the next block, it then takes at least 7 frames to get through it. This holds regardless
+  // of the voice's pitch, so sample rate and pitch modulation writes don't need to update the prediction.
+  static constexpr u32 MAX_STEP = 0x3FFF;
+  static constexpr u32 BLOCK_END = NUM_SAMPLES_PER_ADPCM_BLOCK << 12;
+  static constexpr u32 MIN_FRAMES_PER_BLOCK = (BLOCK_END - MAX_STEP + (MAX_STEP - 1)) / MAX_STEP;
+  static_assert(MIN_FRAMES_PER_BLOCK == 7);
+  const auto block_triggers_irq = [](u16 address) {
+    const u32 ram_address = (ZeroExtend32(address) * 8) & RAM_MASK;
+    return (CheckRAMIRQ(ram_address) || CheckRAMIRQ((ram_address + 8) & RAM_MASK));
+  };
+  for (const Voice& voice : s_state.voices)
+  {
+    const u32 frames_until_block_end = ((BLOCK_END - voice.counter.bits) + (MAX_STEP - 1)) / MAX_STEP;
+    u32 voice_frames;
+    if (!voice.has_samples)
+    {
+      // Read next frame, the flags of the following block aren't known yet.
+      voice_frames = block_triggers_irq(voice.current_address) ? 1 : (frames_until_block_end + 1);
+    }
+    else
+    {
+      const u16 next_address = voice.current_block_flags.loop_end ? (voice.regs.adpcm_repeat_address & ~u16(1)) :
+                                                                    static_cast<u16>(voice.current_address + 2);
+      voice_frames = frames_until_block_end + 1;
+      if (!block_triggers_irq(next_address))
+        voice_frames += MIN_FRAMES_PER_BLOCK;
+    }
+
+    frames = std::min(frames, voice_frames);
+  }
+
+  return std::max(frames, 1u);
+}
+
 void SPU::WriteToCaptureBuffer(u32 index, s16 value)
 {
   const u32 ram_address = (index * CAPTURE_BUFFER_SIZE_PER_CHANNEL) | ZeroExtend16(s_state.capture_buffer_position);
@@ -1929,84 +1954,94 @@ void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
   current_block_flags.bits = block.flags.bits;
 }
 
-s32 SPU::Voice::Interpolate() const
-{
-  static constexpr std::array<s16, 0x200> gauss = {{
-    -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
-    -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, //
-    0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003, //
-    0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007, //
-    0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, //
-    0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018, // entry
-    0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025, // 000..07F
-    0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038, //
-    0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050, //
-    0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F, //
-    0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096, //
-    0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7, //
-    0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101, //
-    0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148, //
-    0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C, //
-    0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200, //
-    0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273, //
-    0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9, //
-    0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392, //
-    0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441, //
-    0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506, //
-    0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4, // entry
-    0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC, // 080..0FF
-    0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF, //
-    0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E, //
-    0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C, //
-    0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8, //
-    0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63, //
-    0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F, //
-    0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB, //
-    0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7, //
-    0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4, //
-    0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700, //
-    0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B, //
-    0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3, //
-    0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37, //
-    0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4, //
-    0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389, // entry
-    0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653, // 100..17F
-    0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E, //
-    0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18, //
-    0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D, //
-    0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209, //
-    0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509, //
-    0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807, //
-    0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00, //
-    0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D35, 0x3D92, 0x3DEF, //
-    0x3E4C, 0x3EA9, 0x3F05, 0x3F62, 0x3FBD, 0x4019, 0x4074, 0x40D0, //
-    0x412A, 0x4185, 0x41DF, 0x4239, 0x4292, 0x42EB, 0x4344, 0x439C, //
-    0x43F4, 0x444C, 0x44A3, 0x44FA, 0x4550, 0x45A6, 0x45FC, 0x4651, //
-    0x46A6, 0x46FA, 0x474E, 0x47A1, 0x47F4, 0x4846, 0x4898, 0x48E9, //
-    0x493A, 0x498A, 0x49D9, 0x4A29, 0x4A77, 0x4AC5, 0x4B13, 0x4B5F, //
-    0x4BAC, 0x4BF7, 0x4C42, 0x4C8D, 0x4CD7, 0x4D20, 0x4D68, 0x4DB0, //
-    0x4DF7, 0x4E3E, 0x4E84, 0x4EC9, 0x4F0E, 0x4F52, 0x4F95, 0x4FD7, // entry
-    0x5019, 0x505A, 0x509A, 0x50DA, 0x5118, 0x5156, 0x5194, 0x51D0, // 180..1FF
-    0x520C, 0x5247, 0x5281, 0x52BA, 0x52F3, 0x532A, 0x5361, 0x5397, //
-    0x53CC, 0x5401, 0x5434, 0x5467, 0x5499, 0x54CA, 0x54FA, 0x5529, //
-    0x5558, 0x5585, 0x55B2, 0x55DE, 0x5609, 0x5632, 0x565B, 0x5684, //
-    0x56AB, 0x56D1, 0x56F6, 0x571B, 0x573E, 0x5761, 0x5782, 0x57A3, //
-    0x57C3, 0x57E2, 0x57FF, 0x581C, 0x5838, 0x5853, 0x586D, 0x5886, //
-    0x589E, 0x58B5, 0x58CB, 0x58E0, 0x58F4, 0x5907, 0x5919, 0x592A, //
-    0x593A, 0x5949, 0x5958, 0x5965, 0x5971, 0x597C, 0x5986, 0x598F, //
-    0x5997, 0x599E, 0x59A4, 0x59A9, 0x59AD, 0x59B0, 0x59B2, 0x59B3  //
-  }};
-
-  const u8 i = counter.interpolation_index;
-  const u32 s = NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + ZeroExtend32(counter.sample_index.GetValue());
-
-  s32 out = s32(gauss[0x0FF - i]) * s32(current_block_samples[s - 3]);
-  out += s32(gauss[0x1FF - i]) * s32(current_block_samples[s - 2]);
-  out += s32(gauss[0x100 + i]) * s32(current_block_samples[s - 1]);
-  out += s32(gauss[0x000 + i]) * s32(current_block_samples[s - 0]);
-  return out >> 15;
-}
+// Gaussian interpolation coefficients.
+static constexpr std::array<s16, 0x200> s_gauss_table = {{
+  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
+  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, //
+  0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003, //
+  0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007, //
+  0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, //
+  0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018, // entry
+  0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025, // 000..07F
+  0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038, //
+  0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050, //
+  0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F, //
+  0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096, //
+  0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7, //
+  0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101, //
+  0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148, //
+  0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C, //
+  0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200, //
+  0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273, //
+  0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9, //
+  0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392, //
+  0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441, //
+  0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506, //
+  0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4, // entry
+  0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC, // 080..0FF
+  0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF, //
+  0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E, //
+  0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C, //
+  0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8, //
+  0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63, //
+  0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F, //
+  0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB, //
+  0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7, //
+  0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4, //
+  0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700, //
+  0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B, //
+  0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3, //
+  0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37, //
+  0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4, //
+  0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389, // entry
+  0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653, // 100..17F
+  0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E, //
+  0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18, //
+  0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D, //
+  0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209, //
+  0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509, //
+  0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807, //
+  0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00, //
+  0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D35, 0x3D92, 0x3DEF, //
+  0x3E4C, 0x3EA9, 0x3F05, 0x3F62, 0x3FBD, 0x4019, 0x4074, 0x40D0, //
+  0x412A, 0x4185, 0x41DF, 0x4239, 0x4292, 0x42EB, 0x4344, 0x439C, //
+  0x43F4, 0x444C, 0x44A3, 0x44FA, 0x4550, 0x45A6, 0x45FC, 0x4651, //
+  0x46A6, 0x46FA, 0x474E, 0x47A1, 0x47F4, 0x4846, 0x4898, 0x48E9, //
+  0x493A, 0x498A, 0x49D9, 0x4A29, 0x4A77, 0x4AC5, 0x4B13, 0x4B5F, //
+  0x4BAC, 0x4BF7, 0x4C42, 0x4C8D, 0x4CD7, 0x4D20, 0x4D68, 0x4DB0, //
+  0x4DF7, 0x4E3E, 0x4E84, 0x4EC9, 0x4F0E, 0x4F52, 0x4F95, 0x4FD7, // entry
+  0x5019, 0x505A, 0x509A, 0x50DA, 0x5118, 0x5156, 0x5194, 0x51D0, // 180..1FF
+  0x520C, 0x5247, 0x5281, 0x52BA, 0x52F3, 0x532A, 0x5361, 0x5397, //
+  0x53CC, 0x5401, 0x5434, 0x5467, 0x5499, 0x54CA, 0x54FA, 0x5529, //
+  0x5558, 0x5585, 0x55B2, 0x55DE, 0x5609, 0x5632, 0x565B, 0x5684, //
+  0x56AB, 0x56D1, 0x56F6, 0x571B, 0x573E, 0x5761, 0x5782, 0x57A3, //
+  0x57C3, 0x57E2, 0x57FF, 0x581C, 0x5838, 0x5853, 0x586D, 0x5886, //
+  0x589E, 0x58B5, 0x58CB, 0x58E0, 0x58F4, 0x5907, 0x5919, 0x592A, //
+  0x593A, 0x5949, 0x5958, 0x5965, 0x5971, 0x597C, 0x5986, 0x598F, //
+  0x5997, 0x599E, 0x59A4, 0x59A9, 0x59AD, 0x59B0, 0x59B2, 0x59B3  //
+}};
+
+// The four interpolation taps of a voice are loaded as two pairs of adjacent samples, which are multiplied and summed
+// with madd_s16(). These tables hold the coefficients for each pair, packed in the same order as the samples.
+static constexpr std::array<u32, 0x100> s_gauss_table_pair01 = []() {
+  std::array<u32, 0x100> ret = {};
+  for (u32 i = 0; i < 0x100; i++)
+  {
+    ret[i] = ZeroExtend32(static_cast<u16>(s_gauss_table[0x0FF - i])) |
+             (ZeroExtend32(static_cast<u16>(s_gauss_table[0x1FF - i])) << 16);
+  }
+  return ret;
+}();
+static constexpr std::array<u32, 0x100> s_gauss_table_pair23 = []() {
+  std::array<u32, 0x100> ret = {};
+  for (u32 i = 0; i < 0x100; i++)
+  {
+    ret[i] = ZeroExtend32(static_cast<u16>(s_gauss_table[0x100 + i])) |
+             (ZeroExtend32(static_cast<u16>(s_gauss_table[0x000 + i])) << 16);
+  }
+  return ret;
+}();
 
 void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
 {
@@ -2035,58 +2070,90 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
-ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+ALWAYS_INLINE_RELEASE void SPU::SampleVoices(s32* left_sum, s32* right_sum, s32* reverb_in_left,
+                                             s32* reverb_in_right)
 {
-  Voice& voice = s_state.voices[voice_index];
-  if (!voice.IsOn() && !s_state.SPUCNT.irq9_enable)
+  DSP::VoiceMixBatch batch;
+
+  // Gather the interpolation taps and volumes of each voice, decoding the next block if needed.
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
   {
-    voice.last_volume = 0;
+    Voice& voice = s_state.voices[voice_index];
+    if (!voice.IsOn() && !s_state.SPUCNT.irq9_enable)
+    {
+      batch.taps01[voice_index] = 0;
+      batch.taps23[voice_index] = 0;
+      batch.gauss01[voice_index] = 0;
+      batch.gauss23[voice_index] = 0;
+      batch.adsr_volume[voice_index] = 0;
+      batch.left_volume[voice_index] = 0;
+      batch.right_volume[voice_index] = 0;
+      batch.active_mask[voice_index] = 0;
+      batch.noise_mask[voice_index] = 0;
+      batch.reverb_mask[voice_index] = 0;
+      continue;
+    }
 
-#ifdef SPU_DUMP_ALL_VOICES
-    if (s_state.s_voice_dump_writers[voice_index])
+    if (!voice.has_samples)
     {
-      const s16 dump_samples[2] = {0, 0};
-      s_state.s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
+      ADPCMBlock block;
+      ReadADPCMBlock(voice.current_address, &block);
+      voice.DecodeBlock(block);
+      voice.has_samples = true;
+
+      if (voice.current_block_flags.loop_start && !voice.ignore_loop_address)
+      {
+        TRACE_LOG("Voice {} loop start @ 0x{:08X}", voice_index, voice.current_address);
+        voice.regs.adpcm_repeat_address = voice.current_address;
+      }
     }
-#endif
 
-    return {};
+    const u8 i = voice.counter.interpolation_index;
+    const u32 s = NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + ZeroExtend32(voice.counter.sample_index.GetValue());
+    std::memcpy(&batch.taps01[voice_index], &voice.current_block_samples[s - 3], sizeof(u32));
+    std::memcpy(&batch.taps23[voice_index], &voice.current_block_samples[s - 1], sizeof(u32));
+    batch.gauss01[voice_index] = s_gauss_table_pair01[i];
+    batch.gauss23[voice_index] = s_gauss_table_pair23[i];
+    batch.adsr_volume[voice_index] = voice.regs.adsr_volume;
+    batch.left_volume[voice_index] = voice.left_volume.current_level;
+    batch.right_volume[voice_index] = voice.right_volume.current_level;
+    batch.active_mask[voice_index] = -1;
+    batch.noise_mask[voice_index] = IsVoiceNoiseEnabled(voice_index) ? -1 : 0;
+    batch.reverb_mask[voice_index] = IsVoiceReverbEnabled(voice_index) ? -1 : 0;
   }
 
-  if (!voice.has_samples)
-  {
-    ADPCMBlock block;
-    ReadADPCMBlock(voice.current_address, &block);
-    voice.DecodeBlock(block);
-    voice.has_samples = true;
+  const DSP::VoiceMixSums sums = DSP::MixVoiceBatch(batch, GetVoiceNoiseLevel());
+  *left_sum = sums.left;
+  *right_sum = sums.right;
+  *reverb_in_left = sums.reverb_left;
+  *reverb_in_right = sums.reverb_right;
 
-    if (voice.current_block_flags.loop_start && !voice.ignore_loop_address)
-    {
-      TRACE_LOG("Voice {} loop start @ 0x{:08X}", voice_index, voice.current_address);
-      voice.regs.adpcm_repeat_address = voice.current_address;
-    }
-  }
+  // Pitch modulation uses the previous voice's volume from this sample, so these all have to be stored first.
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
+    s_state.voices[voice_index].last_volume = batch.volume[voice_index];
 
-  // skip interpolation when the volume is muted anyway
-  s32 volume;
-  if (voice.regs.adsr_volume != 0)
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
   {
-    // interpolate/sample and apply ADSR volume
-    s32 sample;
-    if (IsVoiceNoiseEnabled(voice_index))
-      sample = GetVoiceNoiseLevel();
+    if (batch.active_mask[voice_index])
+    {
+      AdvanceVoice(voice_index, batch.left[voice_index], batch.right[voice_index]);
+    }
     else
-      sample = voice.Interpolate();
-
-    volume = ApplyVolume(sample, voice.regs.adsr_volume);
-  }
-  else
-  {
-    volume = 0;
+    {
+#ifdef SPU_DUMP_ALL_VOICES
+      if (s_state.s_voice_dump_writers[voice_index])
+      {
+        const s16 dump_samples[2] = {0, 0};
+        s_state.s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
+      }
+#endif
+    }
   }
+}
 
-  voice.last_volume = volume;
-
+ALWAYS_INLINE_RELEASE void SPU::AdvanceVoice(u32 voice_index, s32 left, s32 right)
+{
+  Voice& voice = s_state.voices[voice_index];
   if (voice.adsr_phase != ADSRPhase::Off)
     voice.TickADSR();
 
@@ -2139,9 +2206,6 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
     }
   }
 
-  // apply per-channel volume
-  const s32 left = ApplyVolume(volume, voice.left_volume.current_level);
-  const s32 right = ApplyVolume(volume, voice.right_volume.current_level);
   voice.left_volume.Tick();
   voice.right_volume.Tick();
 
@@ -2157,8 +2221,6 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
     s_state.s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
   }
 #endif
-
-  return std::make_tuple(left, right);
 }
 
 void SPU::UpdateNoise()
@@ -2186,32 +2248,9 @@ void SPU::UpdateNoise()
   s_state.noise_level = (s_state.noise_level << 1) | noise_wave_add[(s_state.noise_level >> 10) & 63u];
 }
 
-u32 SPU::ReverbMemoryAddress(u32 address)
+void SPU::UpdateReverbOffsets()
 {
-  // Ensures address does not leave the reverb work area.
-  static constexpr u32 MASK = (RAM_SIZE - 1) / 2;
-  u32 offset = s_state.reverb_current_address + (address & MASK);
-  offset += s_state.reverb_base_address & ((s32)(offset << 13) >> 31);
-
-  // We address RAM in bytes. TODO: Change this to words.
-  return (offset & MASK) * 2u;
-}
-
-s16 SPU::ReverbRead(u32 address, s32 offset)
-{
-  // TODO: This should check interrupts.
-  const u32 real_address = ReverbMemoryAddress((address << 2) + offset);
-
-  s16 data;
-  std::memcpy(&data, &s_ram[real_address], sizeof(data));
-  return data;
-}
-
-void SPU::ReverbWrite(u32 address, s16 data)
-{
-  // TODO: This should check interrupts.
-  const u32 real_address = ReverbMemoryAddress(address << 2);
-  std::memcpy(&s_ram[real_address], &data, sizeof(data));
+  DSP::ComputeReverbOffsets(s_state.reverb_registers, s_state.reverb_base_address, &s_state.reverb_offsets);
 }
 
 void SPU::ProcessReverb(s32 left_in, s32 right_in, s32* left_out, s32* right_out)
@@ -2230,15 +2269,6 @@ void SPU::ProcessReverb(s32 left_in, s32 right_in, s32* left_out, s32* right_out
     -0x0001, 0x0002,  -0x000A, 0x0023,  -0x0067, 0x010A,  -0x0268, 0x0534,  -0x0B90, 0x2806,
     0x2806,  -0x0B90, 0x0534,  -0x0268, 0x010A,  -0x0067, 0x0023,  -0x000A, 0x0002,  -0x0001};
 
-  static constexpr auto iiasm = [](const s16 insamp) {
-    if (s_state.reverb_registers.IIR_ALPHA == -32768) [[unlikely]]
-      return (insamp == -32768) ? 0 : (insamp * -65536);
-    else
-      return insamp * (32768 - s_state.reverb_registers.IIR_ALPHA);
-  };
-
-  static constexpr auto neg = [](s32 samp) { return (samp == -32768) ? 0x7FFF : -samp; };
-
   s_state.last_reverb_input[0] = Truncate16(left_in);
   s_state.last_reverb_input[1] = Truncate16(right_in);
 
@@ -2272,61 +2302,15 @@ void SPU::ProcessReverb(s32 left_in, s32 right_in, s32* left_out, s32* right_out
       downsampled[channel] = Clamp16((acc.addv_s32() + (0x4000 * src[19])) >> 15);
     }
 
+    const DSP::ReverbWorkArea work_area = {s_ram.data(), s_state.reverb_base_address,
+                                           s_state.reverb_current_address};
+    const std::array<s16, 2> filtered =
+      DSP::ProcessReverbFilters(work_area, s_state.reverb_registers, s_state.reverb_offsets,
+                                s_state.SPUCNT.reverb_master_enable, downsampled);
     for (size_t channel = 0; channel < 2; channel++)
     {
-      if (s_state.SPUCNT.reverb_master_enable)
-      {
-        // Input from Mixer (Input volume multiplied with incoming data).
-        const s32 IIR_INPUT_A = Clamp16(
-          (((ReverbRead(s_state.reverb_registers.IIR_SRC_A[channel ^ 0]) * s_state.reverb_registers.IIR_COEF) >> 14) +
-           ((downsampled[channel] * s_state.reverb_registers.IN_COEF[channel]) >> 14)) >>
-          1);
-        const s32 IIR_INPUT_B = Clamp16(
-          (((ReverbRead(s_state.reverb_registers.IIR_SRC_B[channel ^ 1]) * s_state.reverb_registers.IIR_COEF) >> 14) +
-           ((downsampled[channel] * s_state.reverb_registers.IN_COEF[channel]) >> 14)) >>
-          1);
-
-        // Same Side Reflection (left-to-left and right-to-right).
-        const s32 IIR_A = Clamp16((((IIR_INPUT_A * s_state.reverb_registers.IIR_ALPHA) >> 14) +
-                                   (iiasm(ReverbRead(s_state.reverb_registers.IIR_DEST_A[channel], -1)) >> 14)) >>
-                                  1);
-
-        // Different Side Reflection (left-to-right and right-to-left).
-        const s32 IIR_B = Clamp16((((IIR_INPUT_B * s_state.reverb_registers.IIR_ALPHA) >> 14) +
-                                   (iiasm(ReverbRead(s_state.reverb_registers.IIR_DEST_B[channel], -1)) >> 14)) >>
-                                  1);
-
-        ReverbWrite(s_state.reverb_registers.IIR_DEST_A[channel], Truncate16(IIR_A));
-        ReverbWrite(s_state.reverb_registers.IIR_DEST_B[channel], Truncate16(IIR_B));
-      }
-
-      // Early Echo (Comb Filter, with input from buffer).
-      const s32 ACC =
-        ((ReverbRead(s_state.reverb_registers.ACC_SRC_A[channel]) * s_state.reverb_registers.ACC_COEF_A) >> 14) +
-        ((ReverbRead(s_state.reverb_registers.ACC_SRC_B[channel]) * s_state.reverb_registers.ACC_COEF_B) >> 14) +
-        ((ReverbRead(s_state.reverb_registers.ACC_SRC_C[channel]) * s_state.reverb_registers.ACC_COEF_C) >> 14) +
-        ((ReverbRead(s_state.reverb_registers.ACC_SRC_D[channel]) * s_state.reverb_registers.ACC_COEF_D) >> 14);
-
-      // Late Reverb APF1 (All Pass Filter 1, with input from COMB).
-      const s32 FB_A = ReverbRead(s_state.reverb_registers.MIX_DEST_A[channel] - s_state.reverb_registers.FB_SRC_A);
-      const s32 FB_B = ReverbRead(s_state.reverb_registers.MIX_DEST_B[channel] - s_state.reverb_registers.FB_SRC_B);
-      const s32 MDA = Clamp16((ACC + ((FB_A * neg(s_state.reverb_registers.FB_ALPHA)) >> 14)) >> 1);
-
-      // Late Reverb APF2 (All Pass Filter 2, with input from APF1).
-      const s32 MDB = Clamp16(FB_A + ((((MDA * s_state.reverb_registers.FB_ALPHA) >> 14) +
-                                       ((FB_B * neg(s_state.reverb_registers.FB_X)) >> 14)) >>
-                                      1));
-
-      // 22050hz sample output.
       s_state.reverb_upsample_buffer[channel][(s_state.reverb_resample_buffer_position >> 1) | 0x20] =
-        s_state.reverb_upsample_buffer[channel][s_state.reverb_resample_buffer_position >> 1] =
-          Truncate16(Clamp16(FB_B + ((MDB * s_state.reverb_registers.FB_X) >> 15)));
-
-      if (s_state.SPUCNT.reverb_master_enable)
-      {
-        ReverbWrite(s_state.reverb_registers.MIX_DEST_A[channel], Truncate16(MDA));
-        ReverbWrite(s_state.reverb_registers.MIX_DEST_B[channel], Truncate16(MDB));
-      }
+        s_state.reverb_upsample_buffer[channel][s_state.reverb_resample_buffer_position >> 1] = filtered[channel];
     }
 
     s_state.reverb_current_address = (s_state.reverb_current_address + 1) & 0x3FFFFu;
@@ -2414,26 +2398,8 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
     const u32 frames_in_this_batch = std::min(remaining_frames, output_frame_space);
     for (u32 i = 0; i < frames_in_this_batch; i++)
     {
-      s32 left_sum = 0;
-      s32 right_sum = 0;
-      s32 reverb_in_left = 0;
-      s32 reverb_in_right = 0;
-
-      u32 reverb_on_register = s_state.reverb_on_register;
-
-      for (u32 voice = 0; voice < NUM_VOICES; voice++)
-      {
-        const auto [left, right] = SampleVoice(voice);
-        left_sum += left;
-        right_sum += right;
-
-        if (reverb_on_register & 1u)
-        {
-          reverb_in_left += left;
-          reverb_in_right += right;
-        }
-        reverb_on_register >>= 1;
-      }
+      s32 left_sum, right_sum, reverb_in_left, reverb_in_right;
+      SampleVoices(&left_sum, &right_sum, &reverb_in_left, &reverb_in_right);
 
       if (!s_state.SPUCNT.mute_n)
       {
@@ -2538,6 +2504,9 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
       s_state.audio_stream.EndWrite(frames_in_this_batch);
     remaining_frames -= frames_in_this_batch;
   }
+
+  // Voices have moved on, so the next frame the IRQ can be hit has too.
+  UpdateRAMIRQPrediction();
 }
 
 void SPU::UpdateEventInterval()
@@ -2547,7 +2516,12 @@ void SPU::UpdateEventInterval()
   // the SPU state.
   const u32 max_slice_frames = s_state.audio_stream.GetBufferSize();
 
-  // TODO: Make this predict how long until the interrupt will be hit instead...
+  if (g_settings.spu_predict_ram_irq)
+  {
+    UpdatePredictedEventInterval(max_slice_frames);
+    return;
+  }
+
   const u32 interval = (s_state.SPUCNT.enable && s_state.SPUCNT.irq9_enable) ? 1 : max_slice_frames;
   const TickCount interval_ticks = static_cast<TickCount>(interval) * s_state.cpu_ticks_per_spu_tick;
   if (s_state.tick_event.IsActive() && s_state.tick_event.GetInterval() == interval_ticks)
@@ -2559,6 +2533,51 @@ void SPU::UpdateEventInterval()
   s_state.tick_event.Schedule(new_downcount);
 }
 
+void SPU::UpdatePredictedEventInterval(u32 max_slice_frames)
+{
+  // Sample generation only raises the IRQ from ADPCM block reads and capture buffer writes, so rather than stepping
+  // one frame at a time, run up to the earliest frame where either could hit the IRQ address.
+  const u32 interval = (s_state.SPUCNT.enable && IsRAMIRQTriggerable()) ? GetFramesUntilRAMIRQ(max_slice_frames) :
+                                                                          max_slice_frames;
+  const TickCount interval_ticks = static_cast<TickCount>(interval) * s_state.cpu_ticks_per_spu_tick;
+  if (s_state.tick_event.IsActive() && s_state.tick_event.GetInterval() == interval_ticks)
+    return;
+
+  // Ticks remaining before execution should be retained, just adjust the interval/downcount. This can be called
+  // between executions when registers are written, so count the ticks which haven't been executed yet as well.
+  const TickCount pending_ticks = s_state.tick_event.IsActive() ? s_state.tick_event.GetTicksSinceLastExecution() : 0;
+  TickCount new_downcount;
+  if (g_settings.cpu_overclock_active)
+  {
+    // Carry is in units of ticks * denominator, see Execute().
+    const s64 pending = (static_cast<s64>(pending_ticks) * g_settings.cpu_overclock_denominator) + s_state.ticks_carry;
+    const s64 needed = (static_cast<s64>(interval) * s_state.cpu_tick_divider) - pending;
+    new_downcount = static_cast<TickCount>((needed + g_settings.cpu_overclock_denominator - 1) /
+                                           static_cast<s64>(g_settings.cpu_overclock_denominator));
+  }
+  else
+  {
+    new_downcount = interval_ticks - s_state.ticks_carry - pending_ticks;
+  }
+
+  s_state.tick_event.SetInterval(interval_ticks);
+  s_state.tick_event.Schedule(std::max<TickCount>(new_downcount, 1));
+}
+
+void SPU::UpdateRAMIRQPrediction()
+{
+  // The interval only depends on SPUCNT otherwise, which updates it itself.
+  if (g_settings.spu_predict_ram_irq)
+    UpdatePredictedEventInterval(s_state.audio_stream.GetBufferSize());
+}
+
+void SPU::SetRAMIRQPrediction(bool enabled)
+{
+  DEV_LOG("{} SPU RAM IRQ prediction.", enabled ? "Enabling" : "Disabling");
+  GeneratePendingSamples();
+  UpdateEventInterval();
+}
+
 void SPU::DrawDebugStateWindow(float scale)
 {
   static const ImVec4 active_color{1.0f, 1.0f, 1.0f, 1.0f};
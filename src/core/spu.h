@@ -22,6 +22,7 @@ enum : u32
 
 void Initialize();
 void CPUClockChanged();
+void SetRAMIRQPrediction(bool enabled);
 void Shutdown();
 void Reset();
 bool DoState(StateWrapper& sw);
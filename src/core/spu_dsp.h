@@ -0,0 +1,397 @@
+// SPDX-FileCopyrightText: 2019-2025 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "spu.h"
+
+#include "common/bitutils.h"
+#include "common/gsvector.h"
+#include "common/types.h"
+
+#include <array>
+#include <cstring>
+
+// Sample processing stages of the SPU that don't touch its state, so they can be tested on their own.
+namespace SPU::DSP {
+
+inline constexpr u32 NUM_VOICES = 24;
+inline constexpr u32 NUM_REVERB_REGS = 32;
+
+ALWAYS_INLINE constexpr s32 Clamp16(s32 value)
+{
+  return (value < -0x8000) ? -0x8000 : (value > 0x7FFF) ? 0x7FFF : value;
+}
+
+// Per-voice inputs and outputs of the interpolation and volume stages, in structure-of-arrays form so that
+// four voices can be processed at once. Masks are all ones or all zeros.
+struct alignas(VECTOR_ALIGNMENT) VoiceMixBatch
+{
+  u32 taps01[NUM_VOICES];  // samples s-3 and s-2, as a pair of s16
+  u32 taps23[NUM_VOICES];  // samples s-1 and s
+  u32 gauss01[NUM_VOICES]; // coefficients for taps01
+  u32 gauss23[NUM_VOICES]; // coefficients for taps23
+  s32 adsr_volume[NUM_VOICES];
+  s32 left_volume[NUM_VOICES];
+  s32 right_volume[NUM_VOICES];
+  s32 active_mask[NUM_VOICES];
+  s32 noise_mask[NUM_VOICES];
+  s32 reverb_mask[NUM_VOICES];
+  s32 volume[NUM_VOICES];
+  s32 left[NUM_VOICES];
+  s32 right[NUM_VOICES];
+};
+static_assert((NUM_VOICES % 4) == 0);
+
+struct VoiceMixSums
+{
+  s32 left;
+  s32 right;
+  s32 reverb_left;
+  s32 reverb_right;
+};
+
+// Interpolates and applies the ADSR and per-channel volumes, filling in the volume and output of each voice. Muted
+// voices go through the same path, multiplying by a zero ADSR volume gives the same result as skipping the
+// interpolation.
+ALWAYS_INLINE VoiceMixSums MixVoiceBatch(VoiceMixBatch& batch, s32 noise_level)
+{
+  const GSVector4i vnoise_level = GSVector4i(noise_level);
+  GSVector4i left_acc = GSVector4i::zero();
+  GSVector4i right_acc = GSVector4i::zero();
+  GSVector4i reverb_left_acc = GSVector4i::zero();
+  GSVector4i reverb_right_acc = GSVector4i::zero();
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index += 4)
+  {
+    const GSVector4i interpolated =
+      GSVector4i::load<true>(&batch.taps01[voice_index])
+        .madd_s16(GSVector4i::load<true>(&batch.gauss01[voice_index]))
+        .add32(GSVector4i::load<true>(&batch.taps23[voice_index])
+                 .madd_s16(GSVector4i::load<true>(&batch.gauss23[voice_index])))
+        .sra32<15>();
+    const GSVector4i sample = interpolated.blend(vnoise_level, GSVector4i::load<true>(&batch.noise_mask[voice_index]));
+    const GSVector4i volume = sample.mul32l(GSVector4i::load<true>(&batch.adsr_volume[voice_index])).sra32<15>() &
+                              GSVector4i::load<true>(&batch.active_mask[voice_index]);
+    const GSVector4i left = volume.mul32l(GSVector4i::load<true>(&batch.left_volume[voice_index])).sra32<15>();
+    const GSVector4i right = volume.mul32l(GSVector4i::load<true>(&batch.right_volume[voice_index])).sra32<15>();
+    GSVector4i::store<true>(&batch.volume[voice_index], volume);
+    GSVector4i::store<true>(&batch.left[voice_index], left);
+    GSVector4i::store<true>(&batch.right[voice_index], right);
+
+    const GSVector4i reverb_mask = GSVector4i::load<true>(&batch.reverb_mask[voice_index]);
+    left_acc = left_acc.add32(left);
+    right_acc = right_acc.add32(right);
+    reverb_left_acc = reverb_left_acc.add32(left & reverb_mask);
+    reverb_right_acc = reverb_right_acc.add32(right & reverb_mask);
+  }
+
+  return VoiceMixSums{left_acc.addv_s32(), right_acc.addv_s32(), reverb_left_acc.addv_s32(),
+                      reverb_right_acc.addv_s32()};
+}
+
+struct ReverbRegisters
+{
+  s16 vLOUT;
+  s16 vROUT;
+  u16 mBASE;
+
+  union
+  {
+    struct
+    {
+      u16 FB_SRC_A;
+      u16 FB_SRC_B;
+      s16 IIR_ALPHA;
+      s16 ACC_COEF_A;
+      s16 ACC_COEF_B;
+      s16 ACC_COEF_C;
+      s16 ACC_COEF_D;
+      s16 IIR_COEF;
+      s16 FB_ALPHA;
+      s16 FB_X;
+      u16 IIR_DEST_A[2];
+      u16 ACC_SRC_A[2];
+      u16 ACC_SRC_B[2];
+      u16 IIR_SRC_A[2];
+      u16 IIR_DEST_B[2];
+      u16 ACC_SRC_C[2];
+      u16 ACC_SRC_D[2];
+      u16 IIR_SRC_B[2];
+      u16 MIX_DEST_A[2];
+      u16 MIX_DEST_B[2];
+      s16 IN_COEF[2];
+    };
+
+    u16 rev[NUM_REVERB_REGS];
+  };
+};
+
+// Addresses accessed by the reverb filters, relative to the current address. Lanes match ProcessReverbFilters().
+struct alignas(VECTOR_ALIGNMENT) ReverbOffsets
+{
+  s32 iir_src[4];
+  s32 iir_dest[4];
+  s32 iir_prev[4];
+  s32 acc_left[4];
+  s32 acc_right[4];
+  s32 fb[4];
+  s32 mix_dest[4];
+
+  // Set when a write could land on an address read in the same tick.
+  bool overlap;
+};
+
+// Reverb work area in SPU RAM, and the position within it for this tick.
+struct ReverbWorkArea
+{
+  u8* ram;
+  u32 base_address;
+  u32 current_address;
+};
+
+ALWAYS_INLINE u32 ReverbMemoryAddress(const ReverbWorkArea& wa, u32 address)
+{
+  // Ensures address does not leave the reverb work area.
+  static constexpr u32 MASK = (RAM_SIZE - 1) / 2;
+  u32 offset = wa.current_address + (address & MASK);
+  offset += wa.base_address & ((s32)(offset << 13) >> 31);
+
+  // We address RAM in bytes. TODO: Change this to words.
+  return (offset & MASK) * 2u;
+}
+
+ALWAYS_INLINE s16 ReverbRead(const ReverbWorkArea& wa, u32 address, s32 offset = 0)
+{
+  // TODO: This should check interrupts.
+  const u32 real_address = ReverbMemoryAddress(wa, (address << 2) + offset);
+
+  s16 data;
+  std::memcpy(&data, &wa.ram[real_address], sizeof(data));
+  return data;
+}
+
+ALWAYS_INLINE void ReverbWrite(const ReverbWorkArea& wa, u32 address, s16 data)
+{
+  // TODO: This should check interrupts.
+  const u32 real_address = ReverbMemoryAddress(wa, address << 2);
+  std::memcpy(&wa.ram[real_address], &data, sizeof(data));
+}
+
+inline void ComputeReverbOffsets(const ReverbRegisters& rr, u32 base_address, ReverbOffsets* ro)
+{
+  static constexpr u32 MASK = (RAM_SIZE - 1) / 2;
+
+  // Same as the address calculation in ReverbRead()/ReverbWrite(), without the current address.
+  const auto set = [](s32* offsets, s32 a, s32 b, s32 c, s32 d, s32 offset = 0) {
+    const s32 addresses[4] = {a, b, c, d};
+    for (u32 i = 0; i < 4; i++)
+      offsets[i] = static_cast<s32>(((static_cast<u32>(addresses[i]) << 2) + offset) & MASK);
+  };
+  set(ro->iir_src, rr.IIR_SRC_A[0], rr.IIR_SRC_A[1], rr.IIR_SRC_B[1], rr.IIR_SRC_B[0]);
+  set(ro->iir_dest, rr.IIR_DEST_A[0], rr.IIR_DEST_A[1], rr.IIR_DEST_B[0], rr.IIR_DEST_B[1]);
+  set(ro->iir_prev, rr.IIR_DEST_A[0], rr.IIR_DEST_A[1], rr.IIR_DEST_B[0], rr.IIR_DEST_B[1], -1);
+  set(ro->acc_left, rr.ACC_SRC_A[0], rr.ACC_SRC_B[0], rr.ACC_SRC_C[0], rr.ACC_SRC_D[0]);
+  set(ro->acc_right, rr.ACC_SRC_A[1], rr.ACC_SRC_B[1], rr.ACC_SRC_C[1], rr.ACC_SRC_D[1]);
+  set(ro->fb, rr.MIX_DEST_A[0] - rr.FB_SRC_A, rr.MIX_DEST_A[1] - rr.FB_SRC_A, rr.MIX_DEST_B[0] - rr.FB_SRC_B,
+      rr.MIX_DEST_B[1] - rr.FB_SRC_B);
+  set(ro->mix_dest, rr.MIX_DEST_A[0], rr.MIX_DEST_A[1], rr.MIX_DEST_B[0], rr.MIX_DEST_B[1]);
+
+  // Two offsets end up at the same address if they're equal, or if only one of them wraps around to the base address
+  // and they're the size of the work area apart. Not knowing the current address, assume the latter always happens.
+  const u32 base = base_address & MASK;
+  ro->overlap = false;
+  for (const s32* writes : {ro->iir_dest, ro->mix_dest})
+  {
+    for (const s32* reads : {ro->iir_src, ro->iir_prev, ro->acc_left, ro->acc_right, ro->fb})
+    {
+      for (u32 i = 0; i < 4; i++)
+      {
+        for (u32 j = 0; j < 4; j++)
+        {
+          const u32 distance = static_cast<u32>(reads[j] - writes[i]) & MASK;
+          ro->overlap |= (distance == 0 || distance == base || distance == ((0u - base) & MASK));
+        }
+      }
+    }
+  }
+}
+
+// Runs the reverb filters for one 22050hz tick, returning the output sample of each channel.
+inline std::array<s16, 2> ProcessReverbFiltersScalar(const ReverbWorkArea& wa, const ReverbRegisters& rr,
+                                                     bool master_enable, const std::array<s32, 2>& downsampled)
+{
+  const auto iiasm = [&rr](const s16 insamp) {
+    if (rr.IIR_ALPHA == -32768) [[unlikely]]
+      return (insamp == -32768) ? 0 : (insamp * -65536);
+    else
+      return insamp * (32768 - rr.IIR_ALPHA);
+  };
+
+  static constexpr auto neg = [](s32 samp) { return (samp == -32768) ? 0x7FFF : -samp; };
+
+  std::array<s16, 2> out;
+  for (size_t channel = 0; channel < 2; channel++)
+  {
+    if (master_enable)
+    {
+      // Input from Mixer (Input volume multiplied with incoming data).
+      const s32 IIR_INPUT_A = Clamp16((((ReverbRead(wa, rr.IIR_SRC_A[channel ^ 0]) * rr.IIR_COEF) >> 14) +
+                                       ((downsampled[channel] * rr.IN_COEF[channel]) >> 14)) >>
+                                      1);
+      const s32 IIR_INPUT_B = Clamp16((((ReverbRead(wa, rr.IIR_SRC_B[channel ^ 1]) * rr.IIR_COEF) >> 14) +
+                                       ((downsampled[channel] * rr.IN_COEF[channel]) >> 14)) >>
+                                      1);
+
+      // Same Side Reflection (left-to-left and right-to-right).
+      const s32 IIR_A = Clamp16(
+        (((IIR_INPUT_A * rr.IIR_ALPHA) >> 14) + (iiasm(ReverbRead(wa, rr.IIR_DEST_A[channel], -1)) >> 14)) >> 1);
+
+      // Different Side Reflection (left-to-right and right-to-left).
+      const s32 IIR_B = Clamp16(
+        (((IIR_INPUT_B * rr.IIR_ALPHA) >> 14) + (iiasm(ReverbRead(wa, rr.IIR_DEST_B[channel], -1)) >> 14)) >> 1);
+
+      ReverbWrite(wa, rr.IIR_DEST_A[channel], Truncate16(IIR_A));
+      ReverbWrite(wa, rr.IIR_DEST_B[channel], Truncate16(IIR_B));
+    }
+
+    // Early Echo (Comb Filter, with input from buffer).
+    const s32 ACC = ((ReverbRead(wa, rr.ACC_SRC_A[channel]) * rr.ACC_COEF_A) >> 14) +
+                    ((ReverbRead(wa, rr.ACC_SRC_B[channel]) * rr.ACC_COEF_B) >> 14) +
+                    ((ReverbRead(wa, rr.ACC_SRC_C[channel]) * rr.ACC_COEF_C) >> 14) +
+                    ((ReverbRead(wa, rr.ACC_SRC_D[channel]) * rr.ACC_COEF_D) >> 14);
+
+    // Late Reverb APF1 (All Pass Filter 1, with input from COMB).
+    const s32 FB_A = ReverbRead(wa, rr.MIX_DEST_A[channel] - rr.FB_SRC_A);
+    const s32 FB_B = ReverbRead(wa, rr.MIX_DEST_B[channel] - rr.FB_SRC_B);
+    const s32 MDA = Clamp16((ACC + ((FB_A * neg(rr.FB_ALPHA)) >> 14)) >> 1);
+
+    // Late Reverb APF2 (All Pass Filter 2, with input from APF1).
+    const s32 MDB = Clamp16(FB_A + ((((MDA * rr.FB_ALPHA) >> 14) + ((FB_B * neg(rr.FB_X)) >> 14)) >> 1));
+
+    // 22050hz sample output.
+    out[channel] = Truncate16(Clamp16(FB_B + ((MDB * rr.FB_X) >> 15)));
+
+    if (master_enable)
+    {
+      ReverbWrite(wa, rr.MIX_DEST_A[channel], Truncate16(MDA));
+      ReverbWrite(wa, rr.MIX_DEST_B[channel], Truncate16(MDB));
+    }
+  }
+
+  return out;
+}
+
+// Same as ProcessReverbFiltersScalar(), with both channels and both filter taps processed together.
+inline std::array<s16, 2> ProcessReverbFilters(const ReverbWorkArea& wa, const ReverbRegisters& rr,
+                                               const ReverbOffsets& ro, bool master_enable,
+                                               const std::array<s32, 2>& downsampled)
+{
+  // All reads happen before the writes here, but the scalar implementation interleaves them. If any write could land
+  // on an address read in the same tick, the order matters, so use that instead. This is mostly all-zero
+  // configurations, where every offset is the same.
+  if (master_enable && ro.overlap) [[unlikely]]
+    return ProcessReverbFiltersScalar(wa, rr, master_enable, downsampled);
+
+  static constexpr u32 MASK = (RAM_SIZE - 1) / 2;
+  const GSVector4i vmask = GSVector4i(static_cast<s32>(MASK));
+  const GSVector4i vcurrent = GSVector4i(static_cast<s32>(wa.current_address));
+  const GSVector4i vbase = GSVector4i(static_cast<s32>(wa.base_address));
+  const auto resolve = [&vmask, &vcurrent, &vbase](const s32* offsets) {
+    // Same as ReverbMemoryAddress().
+    GSVector4i offset = vcurrent.add32(GSVector4i::load<true>(offsets));
+    offset = offset.add32(vbase & offset.sll32<13>().sra32<31>());
+    return (offset & vmask).sll32<1>();
+  };
+  const auto gather = [ram = wa.ram](const GSVector4i& addresses) {
+    u16 values[4];
+    std::memcpy(&values[0], &ram[addresses.extract32<0>()], sizeof(u16));
+    std::memcpy(&values[1], &ram[addresses.extract32<1>()], sizeof(u16));
+    std::memcpy(&values[2], &ram[addresses.extract32<2>()], sizeof(u16));
+    std::memcpy(&values[3], &ram[addresses.extract32<3>()], sizeof(u16));
+    return GSVector4i::zero()
+      .insert16<0>(values[0])
+      .insert16<1>(values[1])
+      .insert16<2>(values[2])
+      .insert16<3>(values[3])
+      .s16to32();
+  };
+  const auto clamp16 = [](const GSVector4i& value) {
+    return value.max_s32(GSVector4i(-0x8000)).min_s32(GSVector4i(0x7FFF));
+  };
+
+  // Lanes: [left A, right A, left B, right B].
+  GSVector4i iir = GSVector4i::zero();
+  if (master_enable)
+  {
+    // Input from Mixer (Input volume multiplied with incoming data).
+    const GSVector4i input = GSVector4i(downsampled[0], downsampled[1], downsampled[0], downsampled[1])
+                               .mul32l(GSVector4i(rr.IN_COEF[0], rr.IN_COEF[1], rr.IN_COEF[0], rr.IN_COEF[1]))
+                               .sra32<14>();
+    const GSVector4i iir_input =
+      clamp16(gather(resolve(ro.iir_src)).mul32l(GSVector4i(rr.IIR_COEF)).sra32<14>().add32(input).sra32<1>());
+
+    // Same Side and Different Side Reflection.
+    const GSVector4i prev = gather(resolve(ro.iir_prev));
+    GSVector4i prev_scaled = prev.mul32l(GSVector4i((rr.IIR_ALPHA == -32768) ? -65536 : (32768 - rr.IIR_ALPHA)));
+    if (rr.IIR_ALPHA == -32768) [[unlikely]]
+      prev_scaled = prev_scaled.andnot(prev.eq32(GSVector4i(-32768)));
+    iir = clamp16(
+      iir_input.mul32l(GSVector4i(rr.IIR_ALPHA)).sra32<14>().add32(prev_scaled.sra32<14>()).sra32<1>());
+  }
+
+  // Early Echo (Comb Filter, with input from buffer).
+  const GSVector4i acc_coef = GSVector4i(rr.ACC_COEF_A, rr.ACC_COEF_B, rr.ACC_COEF_C, rr.ACC_COEF_D);
+  const s32 acc_left = gather(resolve(ro.acc_left)).mul32l(acc_coef).sra32<14>().addv_s32();
+  const s32 acc_right = gather(resolve(ro.acc_right)).mul32l(acc_coef).sra32<14>().addv_s32();
+  const GSVector4i acc = GSVector4i(acc_left, acc_right, acc_left, acc_right);
+
+  // Lanes: [left, right, left, right].
+  const GSVector4i fb = gather(resolve(ro.fb));
+  const GSVector4i fb_a = fb.xyxy();
+  const GSVector4i fb_b = fb.zwzw();
+  const s32 neg_fb_alpha = (rr.FB_ALPHA == -32768) ? 0x7FFF : -rr.FB_ALPHA;
+  const s32 neg_fb_x = (rr.FB_X == -32768) ? 0x7FFF : -rr.FB_X;
+
+  // Late Reverb APF1 (All Pass Filter 1, with input from COMB).
+  const GSVector4i mda = clamp16(acc.add32(fb_a.mul32l(GSVector4i(neg_fb_alpha)).sra32<14>()).sra32<1>());
+
+  // Late Reverb APF2 (All Pass Filter 2, with input from APF1).
+  const GSVector4i mdb = clamp16(fb_a.add32(mda.mul32l(GSVector4i(rr.FB_ALPHA))
+                                              .sra32<14>()
+                                              .add32(fb_b.mul32l(GSVector4i(neg_fb_x)).sra32<14>())
+                                              .sra32<1>()));
+
+  // 22050hz sample output.
+  const GSVector4i out = clamp16(fb_b.add32(mdb.mul32l(GSVector4i(rr.FB_X)).sra32<15>()));
+
+  if (master_enable)
+  {
+    alignas(VECTOR_ALIGNMENT) u32 iir_dest[4];
+    alignas(VECTOR_ALIGNMENT) u32 mix_dest[4];
+    alignas(VECTOR_ALIGNMENT) s32 iir_values[4];
+    alignas(VECTOR_ALIGNMENT) s32 mix_values[4];
+    GSVector4i::store<true>(iir_dest, resolve(ro.iir_dest));
+    GSVector4i::store<true>(mix_dest, resolve(ro.mix_dest));
+    GSVector4i::store<true>(iir_values, iir);
+    GSVector4i::store<true>(mix_values, mda.blend32<0xC>(mdb));
+
+    // Same order as the scalar implementation, in case the destinations overlap.
+    for (u32 channel = 0; channel < 2; channel++)
+    {
+      for (const u32 lane : {channel, channel + 2})
+      {
+        const s16 value = static_cast<s16>(iir_values[lane]);
+        std::memcpy(&wa.ram[iir_dest[lane]], &value, sizeof(value));
+      }
+      for (const u32 lane : {channel, channel + 2})
+      {
+        const s16 value = static_cast<s16>(mix_values[lane]);
+        std::memcpy(&wa.ram[mix_dest[lane]], &value, sizeof(value));
+      }
+    }
+  }
+
+  return {static_cast<s16>(out.extract32<0>()), static_cast<s16>(out.extract32<1>())};
+}
+
+} // namespace SPU::DSP
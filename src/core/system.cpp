@@ -69,6 +69,7 @@
 #include "common/path.h"
 #include "common/ryml_helpers.h"
 #include "common/string_util.h"
+#include "common/task_queue.h"
 #include "common/time_helpers.h"
 #include "common/timer.h"
 
@@ -125,6 +126,8 @@ static constexpr const char FALLBACK_EXE_NAME[] = "PSX.EXE";
 static constexpr u32 MAX_SKIPPED_DUPLICATE_FRAME_COUNT = 2; // 20fps minimum
 static constexpr u32 MAX_SKIPPED_TIMEOUT_FRAME_COUNT = 1;   // 30fps minimum
 static constexpr u8 MEMORY_CARD_FAST_FORWARD_FRAMES = 30;
+static constexpr size_t MEMORY_STATE_DELTA_CHUNK_SIZE = 4096;
+static constexpr int MEMORY_STATE_COMPRESSION_LEVEL = 1;
 
 namespace {
 
@@ -226,6 +229,13 @@ static u32 CompressAndWriteStateData(std::FILE* fp, std::span<const u8> src, Sav
                                      u32* header_type, Error* error);
 static bool DoState(StateWrapper& sw, bool update_display);
 static void DoMemoryState(StateWrapper& sw, MemorySaveState& mss, bool update_display);
+static void EncodeMemoryStateDelta(DynamicHeapArray<u8>& delta, std::span<const u8> old_state,
+                                   std::span<const u8> new_state);
+static size_t ApplyMemoryStateDelta(std::span<u8> state, std::span<const u8> delta);
+static void WaitForMemoryStateCompression();
+static void CompressMemoryState(MemorySaveState& mss);
+static void DecompressMemoryState(MemorySaveState& mss);
+static MemorySaveState& GetLastMemoryState();
 
 static bool IsExecutionInterrupted();
 static void CheckForAndExitExecution();
@@ -305,6 +315,20 @@ struct ALIGN_TO_CACHE_LINE StateVars
   u32 memory_save_state_front = 0;
   u32 memory_save_state_count = 0;
 
+  // In delta mode only the newest memory state is stored in full, older states are deltas against the next one.
+  bool memory_save_state_deltas = false;
+  size_t memory_save_state_max_size = 0;
+  DynamicHeapArray<u8> memory_save_state_spare;
+
+  // Rewind states can be compressed on a worker thread after they are saved.
+  bool memory_save_state_compression = false;
+  Timer::Value memory_save_state_decompress_time = 0;
+  std::atomic<u64> memory_save_state_uncompressed_bytes{0};
+  std::atomic<u64> memory_save_state_compressed_bytes{0};
+  std::atomic<u64> memory_save_state_compress_time{0};
+  std::atomic<u32> memory_save_state_compress_count{0};
+  TaskQueue memory_save_state_compress_queue;
+
   const BIOS::ImageInfo* bios_image_info = nullptr;
   BIOS::ImageInfo::Hash bios_hash = {};
   u32 taints = 0;
@@ -2166,6 +2190,7 @@ void System::DestroySystem()
   g_gpu.Shutdown();
   DMA::Shutdown();
   PIO::Shutdown();
+  CPU::CodeCache::SaveBlockCache();
   CPU::CodeCache::Shutdown();
   CPU::PGXP::Shutdown();
   CPU::Shutdown();
@@ -2264,6 +2289,10 @@ void System::Execute()
 
 void System::FrameDone()
 {
+  // Runahead catch-up frames are never presented, so anything that isn't emulated state can wait for the frame
+  // that is. The last catch-up frame is the one which gets presented.
+  const bool runahead_catching_up = (s_state.runahead_replay_frames > 1);
+
   // Generate any pending samples from the SPU before sleeping, this way we reduce the chances of underruns.
   // TODO: when running ahead, we can skip this (and the flush above)
   if (!IsReplayingGPUDump()) [[likely]]
@@ -2274,18 +2303,24 @@ void System::FrameDone()
 
     Cheats::ApplyFrameEndCodes();
 
+    if (!runahead_catching_up)
+      CPU::CodeCache::PrecompileCachedBlocks();
+
     if (Achievements::IsActive())
       Achievements::FrameUpdate();
   }
 
+  if (!runahead_catching_up)
+  {
 #ifdef ENABLE_DISCORD_PRESENCE
-  PollDiscordPresence();
+    PollDiscordPresence();
 #endif
 
 #ifdef ENABLE_SOCKET_MULTIPLEXER
-  if (s_state.socket_multiplexer)
-    s_state.socket_multiplexer->PollEventsWithTimeout(0);
+    if (s_state.socket_multiplexer)
+      s_state.socket_multiplexer->PollEventsWithTimeout(0);
 #endif
+  }
 
   // Save states for rewind and runahead.
   if (s_state.rewind_save_counter >= 0)
@@ -2696,6 +2731,8 @@ bool System::DoState(StateWrapper& sw, bool update_display)
 
 System::MemorySaveState& System::AllocateMemoryState()
 {
+  WaitForMemoryStateCompression();
+
   const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
   DebugAssert(s_state.memory_save_state_count <= max_count);
   if (s_state.memory_save_state_count < max_count)
@@ -2708,6 +2745,8 @@ System::MemorySaveState& System::AllocateMemoryState()
 
 System::MemorySaveState& System::GetFirstMemoryState()
 {
+  WaitForMemoryStateCompression();
+
   const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
   DebugAssert(s_state.memory_save_state_count > 0);
 
@@ -2717,20 +2756,53 @@ System::MemorySaveState& System::GetFirstMemoryState()
   return s_state.memory_save_states[idx];
 }
 
+System::MemorySaveState& System::GetLastMemoryState()
+{
+  WaitForMemoryStateCompression();
+
+  const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
+  DebugAssert(s_state.memory_save_state_count > 0);
+  return s_state.memory_save_states[(s_state.memory_save_state_front + max_count - 1) % max_count];
+}
+
 System::MemorySaveState& System::PopMemoryState()
 {
+  WaitForMemoryStateCompression();
+
   const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
   DebugAssert(s_state.memory_save_state_count > 0);
   s_state.memory_save_state_count--;
 
   const s32 front = static_cast<s32>(s_state.memory_save_state_front) - 1;
   s_state.memory_save_state_front = static_cast<u32>((front < 0) ? (front + static_cast<s32>(max_count)) : front);
-  return s_state.memory_save_states[s_state.memory_save_state_front];
+  MemorySaveState& ret = s_state.memory_save_states[s_state.memory_save_state_front];
+
+  // Rebuild the state before this one from its delta, leaving the popped state intact so it can be loaded.
+  if (s_state.memory_save_state_deltas && s_state.memory_save_state_count > 0)
+  {
+    const u32 newest_index = (s_state.memory_save_state_front + max_count - 1) % max_count;
+    MemorySaveState& newest = s_state.memory_save_states[newest_index];
+    DebugAssert(!ret.state_is_delta && !ret.state_is_compressed && newest.state_is_delta);
+    if (newest.state_is_compressed)
+      DecompressMemoryState(newest);
+
+    if (s_state.memory_save_state_spare.size() != s_state.memory_save_state_max_size)
+      s_state.memory_save_state_spare.resize(s_state.memory_save_state_max_size);
+
+    std::memcpy(s_state.memory_save_state_spare.data(), ret.state_data.data(), ret.state_size);
+    newest.state_size =
+      ApplyMemoryStateDelta(s_state.memory_save_state_spare.span(), newest.state_data.cspan(0, newest.state_size));
+    newest.state_data.swap(s_state.memory_save_state_spare);
+    newest.state_is_delta = false;
+  }
+
+  return ret;
 }
 
 bool System::AllocateMemoryStates(size_t state_count, bool recycle_old_textures)
 {
   DEV_LOG("Allocating {} memory save state slots", state_count);
+  WaitForMemoryStateCompression();
 
   if (state_count != s_state.memory_save_states.size())
   {
@@ -2738,15 +2810,30 @@ bool System::AllocateMemoryStates(size_t state_count, bool recycle_old_textures)
     s_state.memory_save_states.resize(state_count);
   }
 
-  // Allocate CPU buffers.
+  // Allocate CPU buffers. Delta states are sized on demand, only the newest state needs a full buffer.
   // TODO: Maybe look at host memory limits here...
   const size_t size = GetMaxMemorySaveStateSize(g_settings.cpu_enable_8mb_ram, CPU::PGXP::ShouldSavePGXPState());
+  s_state.memory_save_state_max_size = size;
   for (MemorySaveState& mss : s_state.memory_save_states)
   {
     mss.state_size = 0;
-    if (mss.state_data.size() != size)
+    mss.state_is_delta = false;
+    mss.state_is_compressed = false;
+    if (s_state.memory_save_state_deltas || s_state.memory_save_state_compression)
+      mss.state_data.deallocate();
+    else if (mss.state_data.size() != size)
       mss.state_data.resize(size);
   }
+  if (s_state.memory_save_state_deltas)
+    s_state.memory_save_state_spare.resize(size);
+  else
+    s_state.memory_save_state_spare.deallocate();
+
+  s_state.memory_save_state_decompress_time = 0;
+  s_state.memory_save_state_uncompressed_bytes.store(0, std::memory_order_relaxed);
+  s_state.memory_save_state_compressed_bytes.store(0, std::memory_order_relaxed);
+  s_state.memory_save_state_compress_time.store(0, std::memory_order_relaxed);
+  s_state.memory_save_state_compress_count.store(0, std::memory_order_relaxed);
 
   // Allocate GPU buffers.
   Error error;
@@ -2771,6 +2858,7 @@ bool System::AllocateMemoryStates(size_t state_count, bool recycle_old_textures)
 
 void System::ClearMemorySaveStates(bool reallocate_resources, bool recycle_textures)
 {
+  WaitForMemoryStateCompression();
   s_state.memory_save_state_front = 0;
   s_state.memory_save_state_count = 0;
 
@@ -2786,6 +2874,8 @@ void System::ClearMemorySaveStates(bool reallocate_resources, bool recycle_textu
 
 void System::FreeMemoryStateStorage(bool release_memory, bool release_textures, bool recycle_textures)
 {
+  WaitForMemoryStateCompression();
+
   if (release_memory || release_textures)
   {
     // TODO: use non-copyable function, that way we don't need to store raw pointers
@@ -2831,6 +2921,8 @@ void System::FreeMemoryStateStorage(bool release_memory, bool release_textures,
   if (release_memory)
   {
     s_state.memory_save_states = std::vector<MemorySaveState>();
+    s_state.memory_save_state_spare.deallocate();
+    s_state.memory_save_state_compress_queue.SetWorkerCount(0);
     s_state.memory_save_state_front = 0;
     s_state.memory_save_state_count = 0;
   }
@@ -2842,6 +2934,10 @@ void System::LoadMemoryState(MemorySaveState& mss, bool update_display)
   Timer load_timer;
 #endif
 
+  DebugAssert(!mss.state_is_delta);
+  if (mss.state_is_compressed)
+    DecompressMemoryState(mss);
+
   StateWrapper sw(mss.state_data.cspan(0, mss.state_size), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
   DoMemoryState(sw, mss, update_display);
   DebugAssert(!sw.HasError());
@@ -2861,10 +2957,55 @@ void System::SaveMemoryState(MemorySaveState& mss)
   Timer save_timer;
 #endif
 
+  // Delta/compressed modes: the slot being reused holds a smaller buffer, swap in the spare full-size buffer.
+  if ((s_state.memory_save_state_deltas || s_state.memory_save_state_compression) &&
+      mss.state_data.size() != s_state.memory_save_state_max_size)
+  {
+    if (s_state.memory_save_state_spare.size() == s_state.memory_save_state_max_size)
+    {
+      mss.state_data.swap(s_state.memory_save_state_spare);
+    }
+    else
+    {
+      mss.state_data.deallocate();
+      mss.state_data.resize(s_state.memory_save_state_max_size);
+    }
+  }
+
   StateWrapper sw(mss.state_data.span(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
   DoMemoryState(sw, mss, false);
   DebugAssert(!sw.HasError());
   mss.state_size = sw.GetPosition();
+  mss.state_is_delta = false;
+  mss.state_is_compressed = false;
+  mss.controller_transfer_count = Pad::GetControllerTransferCount();
+
+  // Replace the previous newest state with the chunks that differ from this one, and recycle its buffer.
+  if (s_state.memory_save_state_deltas && s_state.memory_save_state_count > 1)
+  {
+    const u32 max_count = static_cast<u32>(s_state.memory_save_states.size());
+    const u32 prev_index = (static_cast<u32>(&mss - s_state.memory_save_states.data()) + max_count - 1) % max_count;
+    MemorySaveState& prev = s_state.memory_save_states[prev_index];
+    DebugAssert(!prev.state_is_delta && !prev.state_is_compressed);
+
+    DynamicHeapArray<u8> delta;
+    EncodeMemoryStateDelta(delta, prev.state_data.cspan(0, prev.state_size), mss.state_data.cspan(0, mss.state_size));
+    s_state.memory_save_state_spare.swap(prev.state_data);
+    prev.state_data.swap(delta);
+    prev.state_size = prev.state_data.size();
+    prev.state_is_delta = true;
+
+    DEBUG_LOG("Memory state slot {} compressed to {} byte delta", prev_index, prev.state_size);
+
+    // Newest state is needed in full to build the next delta, so only the deltas get compressed.
+    if (s_state.memory_save_state_compression)
+      CompressMemoryState(prev);
+  }
+  else if (s_state.memory_save_state_compression && !s_state.memory_save_state_deltas)
+  {
+    // With deltas, the first state after a clear is the newest, and must stay uncompressed for the next delta.
+    CompressMemoryState(mss);
+  }
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
   DEV_LOG("Saving frame {} to memory state slot {} took {} bytes and {:.4f} ms", s_state.frame_number,
@@ -2874,6 +3015,144 @@ void System::SaveMemoryState(MemorySaveState& mss)
 #endif
 }
 
+void System::EncodeMemoryStateDelta(DynamicHeapArray<u8>& delta, std::span<const u8> old_state,
+                                    std::span<const u8> new_state)
+{
+  // Format: u32 old state size, u32 chunk count, then each chunk of the old state that differs as u32 index + data.
+  // Most of the state is RAM at a fixed offset, so comparing aligned chunks picks up the pages the game wrote.
+  static constexpr size_t CHUNK_SIZE = MEMORY_STATE_DELTA_CHUNK_SIZE;
+  const size_t old_size = old_state.size();
+  const size_t new_size = new_state.size();
+
+  std::vector<u32> changed_chunks;
+  size_t delta_size = sizeof(u32) * 2;
+  for (size_t offset = 0; offset < old_size; offset += CHUNK_SIZE)
+  {
+    const size_t length = std::min(CHUNK_SIZE, old_size - offset);
+    if ((offset + length) <= new_size && std::memcmp(&old_state[offset], &new_state[offset], length) == 0)
+      continue;
+
+    changed_chunks.push_back(static_cast<u32>(offset / CHUNK_SIZE));
+    delta_size += sizeof(u32) + length;
+  }
+
+  delta.resize(delta_size);
+  u8* out = delta.data();
+  const u32 header[2] = {static_cast<u32>(old_size), static_cast<u32>(changed_chunks.size())};
+  std::memcpy(out, header, sizeof(header));
+  out += sizeof(header);
+  for (const u32 chunk : changed_chunks)
+  {
+    const size_t offset = static_cast<size_t>(chunk) * CHUNK_SIZE;
+    const size_t length = std::min(CHUNK_SIZE, old_size - offset);
+    std::memcpy(out, &chunk, sizeof(chunk));
+    std::memcpy(out + sizeof(chunk), &old_state[offset], length);
+    out += sizeof(chunk) + length;
+  }
+}
+
+size_t System::ApplyMemoryStateDelta(std::span<u8> state, std::span<const u8> delta)
+{
+  static constexpr size_t CHUNK_SIZE = MEMORY_STATE_DELTA_CHUNK_SIZE;
+
+  u32 header[2];
+  std::memcpy(header, delta.data(), sizeof(header));
+  const size_t old_size = header[0];
+  DebugAssert(old_size <= state.size());
+
+  const u8* in = delta.data() + sizeof(header);
+  for (u32 i = 0; i < header[1]; i++)
+  {
+    u32 chunk;
+    std::memcpy(&chunk, in, sizeof(chunk));
+    const size_t offset = static_cast<size_t>(chunk) * CHUNK_SIZE;
+    const size_t length = std::min(CHUNK_SIZE, old_size - offset);
+    std::memcpy(&state[offset], in + sizeof(chunk), length);
+    in += sizeof(chunk) + length;
+  }
+
+  return old_size;
+}
+
+void System::WaitForMemoryStateCompression()
+{
+  if (s_state.memory_save_state_compression)
+    s_state.memory_save_state_compress_queue.WaitForAll();
+}
+
+void System::CompressMemoryState(MemorySaveState& mss)
+{
+  DebugAssert(!mss.state_is_compressed);
+
+  // Slots are only accessed after waiting for the queue, so the worker can own this one until then.
+  s_state.memory_save_state_compress_queue.SubmitTask([&mss]() {
+    const Timer::Value start_time = Timer::GetCurrentValue();
+
+    Error error;
+    DynamicHeapArray<u8> compressed;
+    if (!CompressHelpers::CompressToBuffer(compressed, CompressHelpers::CompressType::Zstandard,
+                                           mss.state_data.cspan(0, mss.state_size), MEMORY_STATE_COMPRESSION_LEVEL,
+                                           &error))
+    {
+      ERROR_LOG("Failed to compress memory save state: {}", error.GetDescription());
+      return;
+    }
+
+    s_state.memory_save_state_uncompressed_bytes.fetch_add(mss.state_size, std::memory_order_relaxed);
+    s_state.memory_save_state_compressed_bytes.fetch_add(compressed.size(), std::memory_order_relaxed);
+    s_state.memory_save_state_compress_time.fetch_add(Timer::GetCurrentValue() - start_time,
+                                                      std::memory_order_relaxed);
+    s_state.memory_save_state_compress_count.fetch_add(1, std::memory_order_relaxed);
+
+    mss.state_data.swap(compressed);
+    mss.state_is_compressed = true;
+  });
+}
+
+void System::DecompressMemoryState(MemorySaveState& mss)
+{
+  DebugAssert(mss.state_is_compressed);
+  const Timer::Value start_time = Timer::GetCurrentValue();
+
+  // Full states get a full-size buffer, so it can be reused when the slot is saved to again.
+  Error error;
+  DynamicHeapArray<u8> data(mss.state_is_delta ? mss.state_size : s_state.memory_save_state_max_size);
+  if (!CompressHelpers::DecompressBuffer(data.span(), CompressHelpers::CompressType::Zstandard,
+                                         mss.state_data.cspan(), mss.state_size, &error))
+  {
+    ERROR_LOG("Failed to decompress memory save state: {}", error.GetDescription());
+    Panic("Failed to decompress memory save state");
+  }
+
+  mss.state_data.swap(data);
+  mss.state_is_compressed = false;
+  s_state.memory_save_state_decompress_time = Timer::GetCurrentValue() - start_time;
+}
+
+bool System::FormatMemorySaveStateStats(SmallStringBase& str)
+{
+  // NOTE: Racey read, only used for display.
+  const u32 count = s_state.memory_save_state_compress_count.load(std::memory_order_relaxed);
+  if (!s_state.memory_save_state_compression || count == 0)
+    return false;
+
+  const u64 uncompressed_bytes = s_state.memory_save_state_uncompressed_bytes.load(std::memory_order_relaxed);
+  const u64 compressed_bytes = s_state.memory_save_state_compressed_bytes.load(std::memory_order_relaxed);
+  const double compress_time =
+    Timer::ConvertValueToMilliseconds(s_state.memory_save_state_compress_time.load(std::memory_order_relaxed)) /
+    static_cast<double>(count);
+
+#define BOLD(text) "\x02" text "\x01"
+
+  str.format(BOLD("RWND:") " {:.1f}% " BOLD("Ratio") " | {:.2f}ms " BOLD("Comp") " | {:.2f}ms " BOLD("Decomp"),
+             (static_cast<double>(compressed_bytes) * 100.0) / static_cast<double>(uncompressed_bytes), compress_time,
+             Timer::ConvertValueToMilliseconds(s_state.memory_save_state_decompress_time));
+
+#undef BOLD
+
+  return true;
+}
+
 void System::DoMemoryState(StateWrapper& sw, MemorySaveState& mss, bool update_display)
 {
 #if defined(_DEBUG) || defined(_DEVEL)
@@ -4284,6 +4563,8 @@ void System::RemoveMedia()
 
 void System::UpdateRunningGame(const std::string& path, CDImage* image, bool booting)
 {
+  CPU::CodeCache::SaveBlockCache();
+
   const std::string prev_serial = std::move(s_state.running_game_serial);
 
   s_state.running_game_path.clear();
@@ -4391,6 +4672,8 @@ void System::UpdateRunningGame(const std::string& path, CDImage* image, bool boo
   UpdateGameSettingsLayer();
   ApplySettings(true);
 
+  CPU::CodeCache::LoadBlockCache();
+
   if (!IsReplayingGPUDump())
   {
     // Cheats are loaded later in Initialize().
@@ -4704,6 +4987,9 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         (g_settings.cpu_recompiler_memory_exceptions != old_settings.cpu_recompiler_memory_exceptions ||
          g_settings.cpu_recompiler_block_linking != old_settings.cpu_recompiler_block_linking ||
          g_settings.cpu_recompiler_icache != old_settings.cpu_recompiler_icache ||
+         g_settings.cpu_recompiler_background_compile != old_settings.cpu_recompiler_background_compile ||
+         g_settings.cpu_recompiler_superblocks != old_settings.cpu_recompiler_superblocks ||
+         g_settings.cpu_recompiler_subpage_invalidation != old_settings.cpu_recompiler_subpage_invalidation ||
          g_settings.bios_tty_logging != old_settings.bios_tty_logging))
     {
       Host::AddIconOSDMessage(OSDMessageType::Info, "CPUFlushAllBlocks", ICON_FA_MICROCHIP,
@@ -4711,6 +4997,14 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       CPU::CodeCache::Reset();
       CPU::g_state.bus_error = false;
     }
+
+    if (g_settings.cpu_recompiler_block_cache != old_settings.cpu_recompiler_block_cache ||
+        g_settings.cpu_execution_mode != old_settings.cpu_execution_mode)
+    {
+      // Write out what was compiled so far, then pick the cache up again or drop it if it's no longer in use.
+      CPU::CodeCache::SaveBlockCache();
+      CPU::CodeCache::LoadBlockCache();
+    }
     else if (g_settings.cpu_execution_mode == CPUExecutionMode::Interpreter &&
              g_settings.bios_tty_logging != old_settings.bios_tty_logging)
     {
@@ -4807,6 +5101,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       if (g_settings.rewind_enable == old_settings.rewind_enable &&
           g_settings.rewind_save_frequency == old_settings.rewind_save_frequency &&
           g_settings.rewind_save_slots == old_settings.rewind_save_slots &&
+          g_settings.rewind_delta_states == old_settings.rewind_delta_states &&
+          g_settings.rewind_compress_states == old_settings.rewind_compress_states &&
           g_settings.runahead_frames == old_settings.runahead_frames)
       {
         // done below if rewind settings changed
@@ -4821,7 +5117,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
       }
     }
     else if (const bool device_settings_changed = g_settings.AreGPUDeviceSettingsChanged(old_settings);
-             device_settings_changed || g_settings.display_show_messages != old_settings.display_show_messages ||
+             device_settings_changed || g_settings.gpu_sw_threads != old_settings.gpu_sw_threads ||
+             g_settings.display_show_messages != old_settings.display_show_messages ||
              g_settings.display_animate_messages != old_settings.display_animate_messages ||
              g_settings.display_blur_message_backgrounds != old_settings.display_blur_message_backgrounds ||
              g_settings.display_show_fps != old_settings.display_show_fps ||
@@ -4860,6 +5157,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         if (g_settings.rewind_enable == old_settings.rewind_enable &&
             g_settings.rewind_save_frequency == old_settings.rewind_save_frequency &&
             g_settings.rewind_save_slots == old_settings.rewind_save_slots &&
+            g_settings.rewind_delta_states == old_settings.rewind_delta_states &&
+            g_settings.rewind_compress_states == old_settings.rewind_compress_states &&
             g_settings.runahead_frames == old_settings.runahead_frames)
         {
           // done below if rewind settings changed
@@ -4910,6 +5209,22 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.cdrom_readahead_sectors != old_settings.cdrom_readahead_sectors)
       CDROM::SetReadaheadSectors(g_settings.cdrom_readahead_sectors);
 
+    if (g_settings.cdrom_decompression_cache_blocks != old_settings.cdrom_decompression_cache_blocks ||
+        g_settings.cdrom_decompression_prefetch_blocks != old_settings.cdrom_decompression_prefetch_blocks)
+    {
+      CDROM::SetDecompressionCache(g_settings.cdrom_decompression_cache_blocks,
+                                   g_settings.cdrom_decompression_prefetch_blocks);
+    }
+
+    if (g_settings.cdrom_memory_map_images != old_settings.cdrom_memory_map_images)
+      CDROM::SetMemoryMapping(g_settings.cdrom_memory_map_images);
+
+    if (g_settings.mdec_async_decode != old_settings.mdec_async_decode)
+      MDEC::SetAsyncDecode(g_settings.mdec_async_decode);
+
+    if (g_settings.spu_predict_ram_irq != old_settings.spu_predict_ram_irq)
+      SPU::SetRAMIRQPrediction(g_settings.spu_predict_ram_irq);
+
     bool controllers_updated = false;
     for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
     {
@@ -4935,6 +5250,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
         g_settings.rewind_save_frequency != old_settings.rewind_save_frequency ||
         g_settings.rewind_save_slots != old_settings.rewind_save_slots ||
+        g_settings.rewind_delta_states != old_settings.rewind_delta_states ||
+        g_settings.rewind_compress_states != old_settings.rewind_compress_states ||
         g_settings.runahead_frames != old_settings.runahead_frames)
     {
       UpdateMemorySaveStateSettings();
@@ -5288,8 +5605,13 @@ void System::UpdateMemorySaveStateSettings()
   }
 
   u32 num_slots = 0;
+  s_state.memory_save_state_deltas = false;
+  s_state.memory_save_state_compression = false;
   if (g_settings.rewind_enable && !g_settings.IsRunaheadEnabled())
   {
+    s_state.memory_save_state_deltas = g_settings.rewind_delta_states;
+    s_state.memory_save_state_compression = g_settings.rewind_compress_states;
+    s_state.memory_save_state_compress_queue.SetWorkerCount(s_state.memory_save_state_compression ? 1 : 0);
     s_state.rewind_save_frequency =
       static_cast<s32>(std::ceil(g_settings.rewind_save_frequency * s_state.video_frame_rate));
     s_state.rewind_save_counter = 0;
@@ -5430,13 +5752,36 @@ bool System::DoRunahead()
     if (s_state.memory_save_state_count == 0)
       return false;
 
-    LoadMemoryState(GetFirstMemoryState(), false);
+    if (g_settings.runahead_partial_replay && Pad::IsInputOnlyReadByTransfers())
+    {
+      // Frames which didn't read the controllers come out the same with the new input, so nothing needs replaying
+      // if none did, and otherwise only from the newest state saved before the first read.
+      const u64 first_transfer_count = GetFirstMemoryState().controller_transfer_count;
+      if (Pad::GetControllerTransferCount() == first_transfer_count)
+        return false;
 
-    // figure out how many frames we need to run to catch up
-    s_state.runahead_replay_frames = s_state.memory_save_state_count;
+      const u32 saved_frames = s_state.memory_save_state_count;
+      while (s_state.memory_save_state_count > 1 &&
+             GetLastMemoryState().controller_transfer_count != first_transfer_count)
+      {
+        PopMemoryState();
+      }
 
-    // and throw away all the states, forcing us to catch up below
-    ClearMemorySaveStates(false, false);
+      LoadMemoryState(GetLastMemoryState(), false);
+
+      // figure out how many frames we need to run to catch up, the loaded state stays as the oldest one
+      s_state.runahead_replay_frames = saved_frames - s_state.memory_save_state_count + 1;
+    }
+    else
+    {
+      LoadMemoryState(GetFirstMemoryState(), false);
+
+      // figure out how many frames we need to run to catch up
+      s_state.runahead_replay_frames = s_state.memory_save_state_count;
+
+      // and throw away all the states, forcing us to catch up below
+      ClearMemorySaveStates(false, false);
+    }
 
     // run the frames with no audio
     SPU::SetAudioOutputMuted(true);
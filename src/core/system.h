@@ -251,6 +251,9 @@ bool PopulateGameListEntryFromCurrentGame(GameList::Entry* entry, Error* error);
 
 void FormatLatencyStats(SmallStringBase& str);
 
+/// Formats rewind state compression statistics, returns false if compression is not active.
+bool FormatMemorySaveStateStats(SmallStringBase& str);
+
 /// Loads global settings (i.e. EmuConfig).
 void LoadSettings(bool display_osd_messages);
 void SetDefaultSettings(SettingsInterface& si);
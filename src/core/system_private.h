@@ -17,10 +17,14 @@ struct MemorySaveState
 {
   DynamicHeapArray<u8> state_data;
   size_t state_size;
+  bool state_is_delta;      // Only the chunks that differ from the next newer state, see EncodeMemoryStateDelta().
+  bool state_is_compressed; // state_data is zstd compressed, state_size is the uncompressed size.
 
   std::unique_ptr<GPUTexture> vram_texture;
   DynamicHeapArray<u8> gpu_state_data;
   size_t gpu_state_size;
+
+  u64 controller_transfer_count; // Pad::GetControllerTransferCount() when saved.
 };
 
 MemorySaveState& AllocateMemoryState();
@@ -11,31 +11,48 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/small_string.h"
+#include "common/timer.h"
 #include "common/thirdparty/SmallVector.h"
 
+#include <algorithm>
+#include <vector>
+
 LOG_CHANNEL(TimingEvents);
 
 namespace TimingEvents {
 
 static GlobalTicks GetTimestampForNewEvent();
 
-static void SortEvent(TimingEvent* event);
+static TimingEvent* GetHeadEvent();
+static u32 GetActiveEventCount();
+template<typename T>
+static void EnumerateActiveEvents(const T& callback);
+static void SortEvent(TimingEvent* event, GlobalTicks next_run_time);
 static void AddActiveEvent(TimingEvent* event);
 static void RemoveActiveEvent(TimingEvent* event);
+static void LinearizeActiveEvents();
 static void SortEvents();
 static TimingEvent* FindActiveEvent(const std::string_view name);
 static void CommitGlobalTicks(const GlobalTicks new_global_ticks);
+static void AddEventCallbackTime(const TimingEvent* event, Timer::Value time);
+static bool IsEventBefore(const TimingEvent* lhs, const TimingEvent* rhs);
+static void SiftEventUp(TimingEvent* event, u32 index);
+static void SiftEventDown(TimingEvent* event, u32 index);
 
 namespace {
 struct TimingEventsState
 {
-  TimingEvent* active_events_head = nullptr;
-  TimingEvent* active_events_tail = nullptr;
+  // Binary min-heap ordered by next run time, the front is always the next event to run.
+  llvm::SmallVector<TimingEvent*, 32> active_events;
+  s64 lowest_event_order = 0;
+  s64 highest_event_order = 0;
   TimingEvent* current_event = nullptr;
-  u32 active_event_count = 0;
   GlobalTicks current_event_next_run_time = 0;
   GlobalTicks global_tick_counter = 0;
   GlobalTicks event_run_tick_counter = 0;
+  bool profiling = false;
+  Statistics stats = {};
+  std::vector<EventStatistics> event_stats;
 };
 } // namespace
 
@@ -73,236 +90,224 @@ void TimingEvents::Reset()
 
 void TimingEvents::Shutdown()
 {
-  Assert(s_state.active_event_count == 0);
+  Assert(GetActiveEventCount() == 0);
 }
 
 void TimingEvents::UpdateCPUDowncount()
 {
-  DebugAssert(s_state.active_events_head->m_next_run_time >= s_state.global_tick_counter);
-  const u32 event_downcount =
-    static_cast<u32>(s_state.active_events_head->m_next_run_time - s_state.global_tick_counter);
+  const TimingEvent* head = GetHeadEvent();
+  DebugAssert(head->m_next_run_time >= s_state.global_tick_counter);
+  const u32 event_downcount = static_cast<u32>(head->m_next_run_time - s_state.global_tick_counter);
   CPU::g_state.downcount = CPU::HasPendingInterrupt() ? 0 : event_downcount;
 }
 
-TimingEvent** TimingEvents::GetHeadEventPtr()
+const TimingEvents::Statistics& TimingEvents::GetStatistics()
 {
-  return &s_state.active_events_head;
+  return s_state.stats;
 }
 
-void TimingEvents::SetGlobalTickCounter(GlobalTicks ticks)
+std::span<const TimingEvents::EventStatistics> TimingEvents::GetEventStatistics()
 {
-  s_state.global_tick_counter = ticks;
+  return s_state.event_stats;
 }
 
-void TimingEvents::SortEvent(TimingEvent* event)
+void TimingEvents::ResetStatistics()
 {
-  const GlobalTicks event_runtime = event->m_next_run_time;
+  s_state.stats = {};
+  s_state.event_stats.clear();
+}
 
-  if (event->prev && event->prev->m_next_run_time > event_runtime)
+void TimingEvents::AddEventCallbackTime(const TimingEvent* event, Timer::Value time)
+{
+  // Only a couple of dozen distinct events, a linear search is fine.
+  for (EventStatistics& es : s_state.event_stats)
   {
-    // move backwards
-    TimingEvent* current = event->prev;
-    while (current && current->m_next_run_time > event_runtime)
-      current = current->prev;
-
-    // unlink
-    if (event->prev)
-      event->prev->next = event->next;
-    else
-      s_state.active_events_head = event->next;
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_state.active_events_tail = event->prev;
-
-    // insert after current
-    if (current)
+    if (es.name == event->m_name)
     {
-      event->next = current->next;
-      if (current->next)
-        current->next->prev = event;
-      else
-        s_state.active_events_tail = event;
-
-      event->prev = current;
-      current->next = event;
-    }
-    else
-    {
-      // insert at front
-      DebugAssert(s_state.active_events_head);
-      s_state.active_events_head->prev = event;
-      event->prev = nullptr;
-      event->next = s_state.active_events_head;
-      s_state.active_events_head = event;
-      UpdateCPUDowncount();
+      es.invocations++;
+      es.callback_time += time;
+      return;
     }
   }
-  else if (event->next && event_runtime > event->next->m_next_run_time)
-  {
-    // move forwards
-    TimingEvent* current = event->next;
-    while (current && event_runtime > current->m_next_run_time)
-      current = current->next;
 
-    // unlink
-    if (event->prev)
-    {
-      event->prev->next = event->next;
-    }
-    else
-    {
-      s_state.active_events_head = event->next;
-      if (!s_state.current_event)
-        UpdateCPUDowncount();
-    }
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_state.active_events_tail = event->prev;
+  s_state.event_stats.push_back(EventStatistics{event->m_name, 1, time});
+}
 
-    // insert before current
-    if (current)
-    {
-      event->next = current;
-      event->prev = current->prev;
+void TimingEvents::SetProfilingEnabled(bool enabled)
+{
+  s_state.profiling = enabled;
+}
 
-      if (current->prev)
-      {
-        current->prev->next = event;
-      }
-      else
-      {
-        s_state.active_events_head = event;
-        if (!s_state.current_event)
-          UpdateCPUDowncount();
-      }
+void TimingEvents::SetGlobalTickCounter(GlobalTicks ticks)
+{
+  s_state.global_tick_counter = ticks;
+}
 
-      current->prev = event;
-    }
-    else
-    {
-      // insert at back
-      DebugAssert(s_state.active_events_tail);
-      s_state.active_events_tail->next = event;
-      event->next = nullptr;
-      event->prev = s_state.active_events_tail;
-      s_state.active_events_tail = event;
-    }
-  }
+ALWAYS_INLINE_RELEASE TimingEvent* TimingEvents::GetHeadEvent()
+{
+  return s_state.active_events.front();
 }
 
-void TimingEvents::AddActiveEvent(TimingEvent* event)
+u32 TimingEvents::GetActiveEventCount()
 {
-  DebugAssert(!event->prev && !event->next);
-  s_state.active_event_count++;
+  return static_cast<u32>(s_state.active_events.size());
+}
 
-  const GlobalTicks event_runtime = event->m_next_run_time;
-  TimingEvent* current = nullptr;
-  TimingEvent* next = s_state.active_events_head;
-  while (next && event_runtime > next->m_next_run_time)
-  {
-    current = next;
-    next = next->next;
-  }
+template<typename T>
+void TimingEvents::EnumerateActiveEvents(const T& callback)
+{
+  for (TimingEvent* event : s_state.active_events)
+    callback(event);
+}
 
-  if (!next)
-  {
-    // new tail
-    event->prev = s_state.active_events_tail;
-    if (s_state.active_events_tail)
-    {
-      s_state.active_events_tail->next = event;
-      s_state.active_events_tail = event;
-    }
-    else
-    {
-      // first event
-      s_state.active_events_tail = event;
-      s_state.active_events_head = event;
-      UpdateCPUDowncount();
-    }
-  }
-  else if (!current)
+ALWAYS_INLINE bool TimingEvents::IsEventBefore(const TimingEvent* lhs, const TimingEvent* rhs)
+{
+  return (lhs->m_next_run_time < rhs->m_next_run_time ||
+          (lhs->m_next_run_time == rhs->m_next_run_time && lhs->m_heap_order < rhs->m_heap_order));
+}
+
+void TimingEvents::SiftEventUp(TimingEvent* event, u32 index)
+{
+  while (index > 0)
   {
-    // new head
-    event->next = s_state.active_events_head;
-    s_state.active_events_head->prev = event;
-    s_state.active_events_head = event;
-    UpdateCPUDowncount();
+    const u32 parent_index = (index - 1) / 2;
+    TimingEvent* parent = s_state.active_events[parent_index];
+    if (!IsEventBefore(event, parent))
+      break;
+
+    s_state.active_events[index] = parent;
+    parent->m_heap_index = index;
+    index = parent_index;
   }
-  else
+
+  s_state.active_events[index] = event;
+  event->m_heap_index = index;
+}
+
+void TimingEvents::SiftEventDown(TimingEvent* event, u32 index)
+{
+  const u32 count = static_cast<u32>(s_state.active_events.size());
+  for (;;)
   {
-    // inbetween current < event > next
-    event->prev = current;
-    event->next = next;
-    current->next = event;
-    next->prev = event;
+    u32 child_index = index * 2 + 1;
+    if (child_index >= count)
+      break;
+
+    TimingEvent* child = s_state.active_events[child_index];
+    if ((child_index + 1) < count && IsEventBefore(s_state.active_events[child_index + 1], child))
+      child = s_state.active_events[++child_index];
+    if (IsEventBefore(event, child))
+      break;
+
+    s_state.active_events[index] = child;
+    child->m_heap_index = index;
+    index = child_index;
   }
+
+  s_state.active_events[index] = event;
+  event->m_heap_index = index;
 }
 
-void TimingEvents::RemoveActiveEvent(TimingEvent* event)
+void TimingEvents::SortEvent(TimingEvent* event, GlobalTicks next_run_time)
 {
-  DebugAssert(s_state.active_event_count > 0);
+  const u32 index = event->m_heap_index;
+  DebugAssert(index < s_state.active_events.size() && s_state.active_events[index] == event);
+  s_state.stats.queue_updates++;
 
-  if (event->next)
+  // Events with the same run time have to keep running in the order the old sorted list gave them. It moved an
+  // event that got later in front of the others at its new time, and one that got earlier behind them.
+  const GlobalTicks old_run_time = event->m_next_run_time;
+  event->m_next_run_time = next_run_time;
+  if (next_run_time > old_run_time)
   {
-    event->next->prev = event->prev;
+    event->m_heap_order = --s_state.lowest_event_order;
+    SiftEventDown(event, index);
   }
-  else
+  else if (next_run_time < old_run_time)
   {
-    s_state.active_events_tail = event->prev;
-  }
-
-  if (event->prev)
-  {
-    event->prev->next = event->next;
+    event->m_heap_order = ++s_state.highest_event_order;
+    SiftEventUp(event, index);
   }
   else
   {
-    s_state.active_events_head = event->next;
-    if (s_state.active_events_head && !s_state.current_event)
-      UpdateCPUDowncount();
+    return;
   }
 
-  event->prev = nullptr;
-  event->next = nullptr;
+  // Like the old list, only update the downcount when the front changes. An event moving to the front always does it,
+  // otherwise it gets updated at the end of the event loop.
+  const bool was_head = (index == 0);
+  const bool is_head = (event->m_heap_index == 0);
+  if (was_head != is_head && (is_head || !s_state.current_event))
+    UpdateCPUDowncount();
+}
 
-  s_state.active_event_count--;
+void TimingEvents::AddActiveEvent(TimingEvent* event)
+{
+  s_state.stats.queue_updates++;
+
+  // New events go in front of any others with the same run time.
+  event->m_heap_order = --s_state.lowest_event_order;
+
+  const u32 index = static_cast<u32>(s_state.active_events.size());
+  s_state.active_events.push_back(event);
+  SiftEventUp(event, index);
+
+  if (event->m_heap_index == 0)
+    UpdateCPUDowncount();
 }
 
-void TimingEvents::SortEvents()
+void TimingEvents::RemoveActiveEvent(TimingEvent* event)
 {
-  llvm::SmallVector<TimingEvent*, 16> events;
-  events.reserve(s_state.active_event_count);
+  const u32 index = event->m_heap_index;
+  DebugAssert(index < s_state.active_events.size() && s_state.active_events[index] == event);
+  s_state.stats.queue_updates++;
 
-  TimingEvent* next = s_state.active_events_head;
-  while (next)
+  // Fill the hole with the last event, and move it into place.
+  TimingEvent* last = s_state.active_events.back();
+  s_state.active_events.pop_back();
+  if (last != event)
   {
-    TimingEvent* current = next;
-    events.push_back(current);
-    next = current->next;
-    current->prev = nullptr;
-    current->next = nullptr;
+    if (index > 0 && IsEventBefore(last, s_state.active_events[(index - 1) / 2]))
+      SiftEventUp(last, index);
+    else
+      SiftEventDown(last, index);
   }
 
-  s_state.active_events_head = nullptr;
-  s_state.active_events_tail = nullptr;
-  s_state.active_event_count = 0;
+  event->m_heap_index = 0;
+
+  if (index == 0 && !s_state.active_events.empty() && !s_state.current_event)
+    UpdateCPUDowncount();
+}
+
+void TimingEvents::LinearizeActiveEvents()
+{
+  // A sorted array is still a valid heap, this just puts the events in the order they'll run.
+  std::sort(s_state.active_events.begin(), s_state.active_events.end(), &IsEventBefore);
+  for (u32 i = 0; i < static_cast<u32>(s_state.active_events.size()); i++)
+    s_state.active_events[i]->m_heap_index = i;
+}
+
+void TimingEvents::SortEvents()
+{
+  // Run times have all changed, so rebuild the heap from scratch. The old list did this by adding the events again in
+  // their previous run order, which DoState() puts the array in before loading, so order ties the same way.
+  for (TimingEvent* event : s_state.active_events)
+    event->m_heap_order = --s_state.lowest_event_order;
 
-  for (TimingEvent* event : events)
-    AddActiveEvent(event);
+  const u32 count = static_cast<u32>(s_state.active_events.size());
+  for (u32 i = count / 2; i > 0; i--)
+    SiftEventDown(s_state.active_events[i - 1], i - 1);
 }
 
 static TimingEvent* TimingEvents::FindActiveEvent(const std::string_view name)
 {
-  for (TimingEvent* event = s_state.active_events_head; event; event = event->next)
-  {
-    if (event->GetName() == name)
-      return event;
-  }
+  TimingEvent* found = nullptr;
+  EnumerateActiveEvents([name, &found](TimingEvent* event) {
+    if (!found && event->GetName() == name)
+      found = event;
+  });
 
-  return nullptr;
+  return found;
 }
 
 bool TimingEvents::IsRunningEvents()
@@ -319,8 +324,7 @@ void TimingEvents::CancelRunningEvent()
   // Might need to sort it, since we're bailing out.
   if (event->IsActive())
   {
-    event->m_next_run_time = s_state.current_event_next_run_time;
-    SortEvent(event);
+    SortEvent(event, s_state.current_event_next_run_time);
   }
 
   s_state.current_event = nullptr;
@@ -330,9 +334,13 @@ ALWAYS_INLINE_RELEASE void TimingEvents::CommitGlobalTicks(const GlobalTicks new
 {
   s_state.event_run_tick_counter = new_global_ticks;
 
+  const bool profiling = s_state.profiling;
+  const Timer::Value start_time = profiling ? Timer::GetCurrentValue() : 0;
+  Timer::Value callback_time = 0;
+
   do
   {
-    TimingEvent* event = s_state.active_events_head;
+    TimingEvent* event = GetHeadEvent();
     s_state.global_tick_counter = std::min(new_global_ticks, event->m_next_run_time);
 
     // Now we can actually run the callbacks.
@@ -349,19 +357,37 @@ ALWAYS_INLINE_RELEASE void TimingEvents::CommitGlobalTicks(const GlobalTicks new
       // may be inserted at the front, despite having a higher downcount than the next.
       s_state.current_event_next_run_time = event->m_next_run_time + static_cast<u32>(event->m_interval);
       event->m_last_run_time = s_state.global_tick_counter;
+      s_state.stats.dispatched_events++;
 
       // The cycles_late is only an indicator, it doesn't modify the cycles to execute.
-      event->m_callback(event->m_callback_param, ticks_to_execute, ticks_late);
+      if (profiling) [[unlikely]]
+      {
+        const Timer::Value callback_start_time = Timer::GetCurrentValue();
+        event->m_callback(event->m_callback_param, ticks_to_execute, ticks_late);
+        const Timer::Value this_callback_time = Timer::GetCurrentValue() - callback_start_time;
+        AddEventCallbackTime(event, this_callback_time);
+        callback_time += this_callback_time;
+      }
+      else
+      {
+        event->m_callback(event->m_callback_param, ticks_to_execute, ticks_late);
+      }
+
       if (event->m_active)
       {
-        event->m_next_run_time = s_state.current_event_next_run_time;
-        SortEvent(event);
+        SortEvent(event, s_state.current_event_next_run_time);
       }
 
-      event = s_state.active_events_head;
+      event = GetHeadEvent();
     }
   } while (new_global_ticks > s_state.global_tick_counter);
   s_state.current_event = nullptr;
+
+  if (profiling) [[unlikely]]
+  {
+    s_state.stats.dispatch_time += (Timer::GetCurrentValue() - start_time) - callback_time;
+    s_state.stats.callback_time += callback_time;
+  }
 }
 
 void TimingEvents::RunEvents()
@@ -373,7 +399,7 @@ void TimingEvents::RunEvents()
   {
     const GlobalTicks new_global_ticks =
       s_state.event_run_tick_counter + static_cast<GlobalTicks>(CPU::GetPendingTicks());
-    if (new_global_ticks >= s_state.active_events_head->m_next_run_time)
+    if (new_global_ticks >= GetHeadEvent()->m_next_run_time)
     {
       CPU::ResetPendingTicks();
       CommitGlobalTicks(new_global_ticks);
@@ -403,6 +429,10 @@ void TimingEvents::CommitLeftoverTicks()
 
 bool TimingEvents::DoState(StateWrapper& sw)
 {
+  // SortEvents() relies on the previous run order when loading. Saving doesn't care, events are found by name.
+  if (sw.IsReading())
+    LinearizeActiveEvents();
+
   if (sw.GetVersion() < 71) [[unlikely]]
   {
     u32 old_global_tick_counter = 0;
@@ -505,10 +535,10 @@ bool TimingEvents::DoState(StateWrapper& sw)
     }
     else
     {
-      sw.Do(&s_state.active_event_count);
+      u32 event_count = GetActiveEventCount();
+      sw.Do(&event_count);
 
-      for (TimingEvent* event = s_state.active_events_head; event; event = event->next)
-      {
+      EnumerateActiveEvents([&sw](TimingEvent* event) {
         sw.Do(&event->m_name);
         GlobalTicks next_run_time =
           (s_state.current_event == event) ? s_state.current_event_next_run_time : event->m_next_run_time;
@@ -516,9 +546,9 @@ bool TimingEvents::DoState(StateWrapper& sw)
         sw.Do(&event->m_last_run_time);
         sw.Do(&event->m_period);
         sw.Do(&event->m_interval);
-      }
+      });
 
-      DEBUG_LOG("Wrote {} events to save state.", s_state.active_event_count);
+      DEBUG_LOG("Wrote {} events to save state.", event_count);
     }
   }
 
@@ -564,9 +594,8 @@ void TimingEvent::Delay(TickCount ticks)
 
   DebugAssert(TimingEvents::s_state.current_event != this);
 
-  m_next_run_time += static_cast<u32>(ticks);
-  SortEvent(this);
-  if (s_state.active_events_head == this)
+  SortEvent(this, m_next_run_time + static_cast<u32>(ticks));
+  if (GetHeadEvent() == this)
     UpdateCPUDowncount();
 }
 
@@ -595,9 +624,8 @@ void TimingEvent::Schedule(TickCount ticks)
     // If this is a call from an IO handler for example, re-sort the event queue.
     if (s_state.current_event != this)
     {
-      m_next_run_time = next_run_time;
-      SortEvent(this);
-      if (s_state.active_events_head == this)
+      SortEvent(this, next_run_time);
+      if (GetHeadEvent() == this)
         UpdateCPUDowncount();
     }
   }
@@ -637,12 +665,11 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   if (!force && ticks_to_execute < m_period)
     return;
 
-  m_next_run_time = ts + static_cast<u32>(m_interval);
   m_last_run_time = ts;
 
   // Since we've changed the downcount, we need to re-sort the events.
-  SortEvent(this);
-  if (s_state.active_events_head == this)
+  SortEvent(this, ts + static_cast<u32>(m_interval));
+  if (GetHeadEvent() == this)
     UpdateCPUDowncount();
 
   m_callback(m_callback_param, ticks_to_execute, 0);
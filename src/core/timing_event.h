@@ -5,6 +5,7 @@
 
 #include "types.h"
 
+#include <span>
 #include <string_view>
 
 class StateWrapper;
@@ -58,8 +59,11 @@ public:
   void SetInterval(TickCount interval) { m_interval = interval; }
   void SetPeriod(TickCount period) { m_period = period; }
 
-  TimingEvent* prev = nullptr;
-  TimingEvent* next = nullptr;
+  // Position in the active event heap, only valid while the event is active.
+  u32 m_heap_index = 0;
+
+  // Breaks ties between events with the same run time, see TimingEvents::SortEvent().
+  s64 m_heap_order = 0;
 
   TimingEventCallback m_callback;
   void* m_callback_param;
@@ -92,7 +96,27 @@ void CommitLeftoverTicks();
 
 void UpdateCPUDowncount();
 
-TimingEvent** GetHeadEventPtr();
+// Scheduler statistics, used for benchmarking the event loop.
+struct Statistics
+{
+  u64 dispatched_events;    // Callbacks invoked by the event loop.
+  u64 queue_updates;        // Insertions, removals and re-sorts of the event queue.
+  u64 dispatch_time;        // Host timer ticks spent in the event loop excluding callbacks, only when profiling.
+  u64 callback_time;        // Host timer ticks spent in callbacks, only when profiling.
+};
+
+// Callback cost per event name, only collected when profiling.
+struct EventStatistics
+{
+  std::string_view name;
+  u64 invocations;
+  u64 callback_time;        // Host timer ticks.
+};
+
+const Statistics& GetStatistics();
+std::span<const EventStatistics> GetEventStatistics();
+void ResetStatistics();
+void SetProfilingEnabled(bool enabled);
 
 // Tick counter injection, only for GPU dump replayer.
 void SetGlobalTickCounter(GlobalTicks ticks);
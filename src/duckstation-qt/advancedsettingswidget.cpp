@@ -287,11 +287,23 @@ void AdvancedSettingsWidget::addTweakOptions()
                          Settings::DEFAULT_GPU_FIFO_SIZE, tr(" words"));
   addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("GPU Max Runahead"), "Hacks", "GPUMaxRunAhead", 0, 1000,
                          Settings::DEFAULT_GPU_MAX_RUN_AHEAD, tr(" cycles"));
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Asynchronous MDEC Decoding"), "Hacks", "MDECAsyncDecode",
+                        false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Predict SPU RAM IRQ"), "Hacks", "SPUPredictRAMIRQ",
+                        false);
 
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Memory Exceptions"), "CPU",
                         "RecompilerMemoryExceptions", false);
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Block Linking"), "CPU",
                         "RecompilerBlockLinking", true);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Background Compilation"), "CPU",
+                        "RecompilerBackgroundCompile", false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Block Cache"), "CPU",
+                        "RecompilerBlockCache", false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Superblocks"), "CPU",
+                        "RecompilerSuperblocks", false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Sub-Page Invalidation"), "CPU",
+                        "RecompilerSubPageInvalidation", false);
   addChoiceTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Fast Memory Access"), "CPU",
                        "FastmemMode", Settings::ParseCPUFastmemMode, Settings::GetCPUFastmemModeName,
                        Settings::GetCPUFastmemModeDisplayName, static_cast<u32>(CPUFastmemMode::Count),
@@ -303,6 +315,14 @@ void AdvancedSettingsWidget::addTweakOptions()
                        Settings::DEFAULT_CDROM_MECHACON_VERSION);
   addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CD-ROM Readahead Sectors"), "CDROM", "ReadaheadSectors",
                          0, 32, Settings::DEFAULT_CDROM_READAHEAD_SECTORS, tr(" sectors"));
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CD-ROM Decompression Cache"), "CDROM",
+                         "DecompressionCacheBlocks", 1, 64, Settings::DEFAULT_CDROM_DECOMPRESSION_CACHE_BLOCKS,
+                         tr(" blocks"));
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CD-ROM Decompression Prefetch"), "CDROM",
+                         "DecompressionPrefetchBlocks", 0, 16, Settings::DEFAULT_CDROM_DECOMPRESSION_PREFETCH_BLOCKS,
+                         tr(" blocks"));
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CD-ROM Memory Map Images"), "CDROM", "MemoryMapImages",
+                        false);
   addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("CD-ROM Max Read Speedup Cycles"), "CDROM",
                          "MaxReadSpeedupCycles", 1, 1000000, Settings::DEFAULT_CDROM_MAX_READ_SPEEDUP_CYCLES,
                          tr(" cycles"));
@@ -348,14 +368,25 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
                            static_cast<int>(Settings::DEFAULT_GPU_FIFO_SIZE)); // GPU FIFO size
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                            static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD)); // GPU max runahead
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Asynchronous MDEC decoding
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Predict SPU RAM IRQ
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler memory exceptions
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, true);                       // Recompiler block linking
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler background compile
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler block cache
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler superblocks
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Recompiler sub-page invalidation
     setChoiceTweakOption(m_ui.tweakOptionTable, i++,
                          Settings::DEFAULT_CPU_FASTMEM_MODE); // Recompiler fastmem mode
     setChoiceTweakOption(m_ui.tweakOptionTable, i++,
                          Settings::DEFAULT_CDROM_MECHACON_VERSION); // CDROM Mechacon Version
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                            Settings::DEFAULT_CDROM_READAHEAD_SECTORS); // CD-ROM Readahead Sectors
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                           Settings::DEFAULT_CDROM_DECOMPRESSION_CACHE_BLOCKS); // CD-ROM Decompression Cache
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                           Settings::DEFAULT_CDROM_DECOMPRESSION_PREFETCH_BLOCKS); // CD-ROM Decompression Prefetch
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false); // CD-ROM Memory Map Images
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                            Settings::DEFAULT_CDROM_MAX_READ_SPEEDUP_CYCLES); // CD-ROM Max Speedup Read Cycles
     setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
@@ -389,12 +420,21 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   sif->DeleteValue("Hacks", "DMAHaltTicks");
   sif->DeleteValue("Hacks", "GPUFIFOSize");
   sif->DeleteValue("Hacks", "GPUMaxRunAhead");
+  sif->DeleteValue("Hacks", "MDECAsyncDecode");
+  sif->DeleteValue("Hacks", "SPUPredictRAMIRQ");
   sif->DeleteValue("Hacks", "ExportSharedMemory");
   sif->DeleteValue("CPU", "RecompilerMemoryExceptions");
   sif->DeleteValue("CPU", "RecompilerBlockLinking");
+  sif->DeleteValue("CPU", "RecompilerBackgroundCompile");
+  sif->DeleteValue("CPU", "RecompilerBlockCache");
+  sif->DeleteValue("CPU", "RecompilerSuperblocks");
+  sif->DeleteValue("CPU", "RecompilerSubPageInvalidation");
   sif->DeleteValue("CPU", "FastmemMode");
   sif->DeleteValue("CDROM", "MechaconVersion");
   sif->DeleteValue("CDROM", "ReadaheadSectors");
+  sif->DeleteValue("CDROM", "DecompressionCacheBlocks");
+  sif->DeleteValue("CDROM", "DecompressionPrefetchBlocks");
+  sif->DeleteValue("CDROM", "MemoryMapImages");
   sif->DeleteValue("CDROM", "MaxReadSpeedupCycles");
   sif->DeleteValue("CDROM", "MaxSeekSpeedupCycles");
   sif->DeleteValue("CDROM", "DisableSpeedupOnMDEC");
@@ -32,9 +32,12 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
                                                "UseSoftwareRendererForMemoryStates", false);
   SettingWidgetBinder::BindWidgetToFloatSetting(sif, m_ui.rewindSaveFrequency, "Main", "RewindFrequency", 10.0f);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.rewindSaveSlots, "Main", "RewindSaveSlots", 10);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindDeltaStates, "Main", "RewindDeltaStates", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.rewindCompressStates, "Main", "RewindCompressStates", false);
   SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.runaheadFrames, "Main", "RunaheadFrameCount", 0);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.runaheadForAnalogInput, "Main", "RunaheadForAnalogInput",
                                                false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.runaheadPartialReplay, "Main", "RunaheadPartialReplay", false);
 
   const float effective_emulation_speed = m_dialog->getEffectiveFloatValue("Main", "EmulationSpeed", 1.0f);
   fillComboBoxWithEmulationSpeeds(m_ui.emulationSpeed, effective_emulation_speed);
@@ -152,6 +155,14 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
                              tr("Uses the software renderer when creating rewind states to prevent additional VRAM "
                                 "usage. Especially useful when upscaling, as this will significantly reduce the system "
                                 "requirements for rewinding."));
+  dialog->registerWidgetHelp(m_ui.rewindDeltaStates, tr("Store Only Changes Between Rewind States"), tr("Unchecked"),
+                             tr("Only the most recent rewind state is kept in full, older states only store the "
+                                "memory that changed. Greatly reduces RAM usage, allowing many more rewind slots, "
+                                "at a small cost when creating and loading states."));
+  dialog->registerWidgetHelp(m_ui.rewindCompressStates, tr("Compress Rewind States"), tr("Unchecked"),
+                             tr("Compresses rewind states on a background thread after they are created, and "
+                                "decompresses them when rewinding. Reduces RAM usage at the cost of additional CPU "
+                                "usage. Statistics are shown with the CPU usage overlay."));
 
   dialog->registerWidgetHelp(
     m_ui.runaheadFrames, tr("Runahead"), tr("Disabled"),
@@ -160,6 +171,11 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
   dialog->registerWidgetHelp(
     m_ui.runaheadForAnalogInput, tr("Enable for Analog Input"), tr("Unchecked"),
     tr("Activates runahead when analog input changes, which significantly increases system requirements."));
+  dialog->registerWidgetHelp(
+    m_ui.runaheadPartialReplay, tr("Only Replay From Controller Reads"), tr("Unchecked"),
+    tr("Skips replaying frames which ran before the game read the controllers. Reduces the cost of runahead, but "
+       "games which read input in unusual ways may respond late. Always off for light guns timed from the aim "
+       "position."));
 
   onOptimalFramePacingChanged();
   updateSkipDuplicateFramesEnabled();
@@ -257,7 +273,10 @@ void EmulationSettingsWidget::updateRewind()
   const bool rewind_active = (!runahead_enabled && rewind_enabled);
   m_ui.rewindEnable->setEnabled(!runahead_enabled);
   m_ui.runaheadForAnalogInput->setEnabled(runahead_enabled);
+  m_ui.runaheadPartialReplay->setEnabled(runahead_enabled);
   m_ui.useSoftwareRendererForMemoryStates->setEnabled(rewind_active);
+  m_ui.rewindDeltaStates->setEnabled(rewind_active);
+  m_ui.rewindCompressStates->setEnabled(rewind_active);
 
   if (rewind_active)
   {
@@ -175,6 +175,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.scaledInterlacing, "GPU", "ScaledInterlacing", true);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.useSoftwareRendererForReadbacks, "GPU",
                                                "UseSoftwareRendererForReadbacks", false);
+  SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.softwareRendererThreads, "GPU", "SoftwareRendererThreads", 0);
 
   connect(m_ui.displayFineCropMode, &QComboBox::currentIndexChanged, this,
           &GraphicsSettingsWidget::onFineCropModeChanged);
@@ -453,6 +454,10 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* dialog, QWidget*
     m_ui.useSoftwareRendererForReadbacks, tr("Software Renderer Readbacks"), tr("Unchecked"),
     tr("Runs the software renderer in parallel for VRAM readbacks. On some systems, this may result in greater "
        "performance when using graphical enhancements with the hardware renderer."));
+  dialog->registerWidgetHelp(
+    m_ui.softwareRendererThreads, tr("Software Renderer Threads"), tr("0"),
+    tr("Splits VRAM into tiles and rasterizes them in parallel with the specified number of threads when using the "
+       "software renderer. Values of 0 or 1 draw everything on the video thread."));
 
   // PGXP Tab
 
@@ -2,12 +2,15 @@
 // SPDX-License-Identifier: CC-BY-NC-ND-4.0
 
 #include "core/achievements.h"
+#include "core/bios.h"
 #include "core/bus.h"
 #include "core/controller.h"
 #include "core/core_private.h"
+#include "core/cpu_code_cache.h"
 #include "core/cpu_core.h"
 #include "core/fullscreenui.h"
 #include "core/fullscreenui_widgets.h"
+#include "core/game_database.h"
 #include "core/game_list.h"
 #include "core/gpu.h"
 #include "core/gpu_backend.h"
@@ -15,6 +18,7 @@
 #include "core/spu.h"
 #include "core/system.h"
 #include "core/system_private.h"
+#include "core/timing_event.h"
 #include "core/video_presenter.h"
 #include "core/video_thread.h"
 
@@ -41,9 +45,23 @@
 
 #include "fmt/format.h"
 
+#include <xxhash.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <csignal>
 #include <cstdio>
 #include <ctime>
+#include <thread>
+
+#ifdef _WIN32
+#include "common/windows_headers.h"
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
 
 LOG_CHANNEL(Host);
 
@@ -57,6 +75,20 @@ static void InitializeEarlyConsole();
 static void HookSignals();
 static bool SetNewDataRoot(const std::string& filename);
 static void DumpSystemStateHashes();
+static std::string GetHashString(std::span<const u8> data);
+static bool OpenHashTrace(Error* error);
+static void WriteHashTraceFrame();
+static bool DiffHashTraces(const char* path1, const char* path2);
+static void DumpEventStatistics();
+static bool RunBatch(int argc, char* argv[]);
+static std::vector<std::string> GetBatchChildArguments(int argc, char* argv[]);
+static void AddBatchBIOSArguments(std::vector<std::string>& args);
+static int RunChildProcess(const std::string& program, const std::vector<std::string>& args);
+static void BeginBenchmark();
+static void BeginBenchmarkProfiling();
+static void UpdateBenchmark();
+static void EndBenchmark();
+static bool WriteBenchmarkReport(Error* error);
 static std::string GetFrameDumpPath(u32 frame);
 static void ProcessCoreThreadEvents();
 static void VideoThreadEntryPoint();
@@ -69,7 +101,65 @@ struct RegTestHostState
   u32 blocking_cpu_events_pending = 0;
 };
 
+// Per-frame component hashes, written with -hashtrace and compared with -hashdiff.
+enum class HashTraceComponent : u32
+{
+  SaveState,
+  CPURegisters,
+  RAM,
+  SPURAM,
+  VRAM,
+  Count
+};
+
+static constexpr u32 HASH_TRACE_MAGIC = 0x54485344; // DSHT
+static constexpr u32 HASH_TRACE_VERSION = 1;
+
+static constexpr const char* s_hash_trace_component_names[] = {"Save State", "CPU Registers", "RAM", "SPU RAM",
+                                                               "VRAM"};
+static_assert(std::size(s_hash_trace_component_names) == static_cast<size_t>(HashTraceComponent::Count));
+
+struct HashTraceHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_components;
+  u32 reserved;
+};
+
+struct HashTraceFrame
+{
+  u32 frame_number;
+  u32 reserved;
+  u64 hashes[static_cast<size_t>(HashTraceComponent::Count)];
+};
+
+struct BenchmarkState
+{
+  std::string report_path;
+  u32 warmup_frames = 300;
+  u32 warmup_frames_remaining = 0;
+  u32 timing_frames_remaining = 0;
+
+  // Timing pass, with profiling off so it doesn't skew the frame times.
+  Timer::Value start_time = 0;
+  Timer::Value last_frame_time = 0;
+  CPU::CodeCache::Statistics start_code_cache_stats = {};
+  CPU::CodeCache::Statistics end_code_cache_stats = {};
+  std::vector<double> frame_times;
+
+  // Profiling pass, which the subsystem breakdown comes from.
+  u64 start_core_thread_time = 0;
+  u64 start_video_thread_time = 0;
+  bool profiling = false;
+
+  bool report_written = false;
+};
+
 static RegTestHostState s_state;
+static BenchmarkState s_benchmark_state;
+static FileSystem::ManagedCFilePtr s_hash_trace_file;
+static DynamicHeapArray<u8> s_hash_trace_state_buffer;
 ALIGN_TO_CACHE_LINE static TaskQueue s_async_task_queue;
 
 } // namespace RegTestHost
@@ -79,6 +169,15 @@ static Threading::Thread s_video_thread;
 static u32 s_frames_to_run = 60 * 60;
 static u32 s_frames_remaining = 0;
 static u32 s_frame_dump_interval = 0;
+static bool s_event_statistics = false;
+static bool s_benchmark = false;
+static bool s_fast_hash = false;
+static std::string s_hash_trace_path;
+static std::string s_hash_diff_paths[2];
+static std::string s_hash_file_path;
+static std::string s_batch_list_path;
+static std::string s_batch_report_path;
+static u32 s_batch_jobs = 0;
 static std::string s_dump_base_directory;
 
 bool RegTestHost::InitializeFoldersAndConfig(Error* error)
@@ -323,9 +422,19 @@ void Host::PumpMessagesOnCoreThread()
 {
   RegTestHost::ProcessCoreThreadEvents();
 
+  if (s_benchmark)
+    RegTestHost::UpdateBenchmark();
+  if (RegTestHost::s_hash_trace_file)
+    RegTestHost::WriteHashTraceFrame();
+
   s_frames_remaining--;
   if (s_frames_remaining == 0)
   {
+    if (s_event_statistics)
+      RegTestHost::DumpEventStatistics();
+    if (s_benchmark)
+      RegTestHost::EndBenchmark();
+
     RegTestHost::DumpSystemStateHashes();
     System::ShutdownSystem(false);
   }
@@ -718,6 +827,7 @@ void RegTestHost::VideoThreadEntryPoint()
 void RegTestHost::DumpSystemStateHashes()
 {
   Error error;
+  std::vector<std::pair<const char*, std::string>> hashes;
 
   // don't save full state on gpu dump, it's not going to be complete...
   if (!System::IsReplayingGPUDump())
@@ -730,15 +840,659 @@ void RegTestHost::DumpSystemStateHashes()
       return;
     }
 
-    INFO_LOG("Save State Hash: {}",
-             SHA256Digest::DigestToString(SHA256Digest::GetDigest(state_data.cspan(0, state_data_size))));
-    INFO_LOG("RAM Hash: {}",
-             SHA256Digest::DigestToString(SHA256Digest::GetDigest(std::span<const u8>(Bus::g_ram, Bus::g_ram_size))));
-    INFO_LOG("SPU RAM Hash: {}", SHA256Digest::DigestToString(SHA256Digest::GetDigest(SPU::GetRAM())));
+    hashes.emplace_back("Save State Hash", GetHashString(state_data.cspan(0, state_data_size)));
+    hashes.emplace_back("RAM Hash", GetHashString(std::span<const u8>(Bus::g_ram, Bus::g_ram_size)));
+    hashes.emplace_back("SPU RAM Hash", GetHashString(SPU::GetRAM()));
+  }
+
+  hashes.emplace_back("VRAM Hash", GetHashString(std::span<const u8>(reinterpret_cast<const u8*>(g_vram), VRAM_SIZE)));
+
+  std::string hash_file_data;
+  for (const auto& [name, hash] : hashes)
+  {
+    INFO_LOG("{}: {}", name, hash);
+    fmt::format_to(std::back_inserter(hash_file_data), "{}: {}\n", name, hash);
+  }
+
+  // Picked up by the batch runner.
+  if (!s_hash_file_path.empty() && !FileSystem::WriteStringToFile(s_hash_file_path.c_str(), hash_file_data, &error))
+    ERROR_LOG("Failed to write hash file: {}", error.GetDescription());
+}
+
+std::string RegTestHost::GetHashString(std::span<const u8> data)
+{
+  if (!s_fast_hash)
+    return SHA256Digest::DigestToString(SHA256Digest::GetDigest(data));
+
+  const XXH128_hash_t hash = XXH3_128bits(data.data(), data.size());
+  return fmt::format("{:016X}{:016X}", hash.high64, hash.low64);
+}
+
+bool RegTestHost::OpenHashTrace(Error* error)
+{
+  s_hash_trace_file = FileSystem::OpenManagedCFile(s_hash_trace_path.c_str(), "wb", error);
+  if (!s_hash_trace_file)
+    return false;
+
+  const HashTraceHeader header = {HASH_TRACE_MAGIC, HASH_TRACE_VERSION,
+                                  static_cast<u32>(HashTraceComponent::Count), 0};
+  if (std::fwrite(&header, sizeof(header), 1, s_hash_trace_file.get()) != 1)
+  {
+    Error::SetErrno(error, "fwrite() failed: ", errno);
+    s_hash_trace_file.reset();
+    return false;
+  }
+
+  s_hash_trace_state_buffer.resize(System::GetMaxSaveStateSize(g_settings.cpu_enable_8mb_ram));
+  return true;
+}
+
+void RegTestHost::WriteHashTraceFrame()
+{
+  HashTraceFrame frame = {};
+  frame.frame_number = System::GetFrameNumber();
+
+  // Saving the state also synchronizes VRAM with the video thread, so it has to come first.
+  // GPU dumps don't have a complete state, same as the final hashes.
+  if (!System::IsReplayingGPUDump())
+  {
+    Error error;
+    size_t state_data_size;
+    if (System::SaveStateDataToBuffer(s_hash_trace_state_buffer, &state_data_size, &error))
+    {
+      frame.hashes[static_cast<size_t>(HashTraceComponent::SaveState)] =
+        XXH3_64bits(s_hash_trace_state_buffer.data(), state_data_size);
+    }
+    else
+    {
+      ERROR_LOG("Failed to save system state for hash trace: {}", error.GetDescription());
+    }
+
+    frame.hashes[static_cast<size_t>(HashTraceComponent::CPURegisters)] =
+      XXH3_64bits(&CPU::g_state.regs, sizeof(CPU::g_state.regs));
+    frame.hashes[static_cast<size_t>(HashTraceComponent::RAM)] = XXH3_64bits(Bus::g_ram, Bus::g_ram_size);
+    frame.hashes[static_cast<size_t>(HashTraceComponent::SPURAM)] =
+      XXH3_64bits(SPU::GetRAM().data(), SPU::GetRAM().size());
+  }
+
+  frame.hashes[static_cast<size_t>(HashTraceComponent::VRAM)] = XXH3_64bits(g_vram, VRAM_SIZE);
+
+  if (std::fwrite(&frame, sizeof(frame), 1, s_hash_trace_file.get()) != 1)
+  {
+    ERROR_LOG("Failed to write hash trace, stopping trace.");
+    s_hash_trace_file.reset();
+  }
+}
+
+bool RegTestHost::DiffHashTraces(const char* path1, const char* path2)
+{
+  InitializeEarlyConsole();
+
+  Error error;
+  FileSystem::ManagedCFilePtr fp[2];
+  const char* paths[2] = {path1, path2};
+  for (size_t i = 0; i < std::size(fp); i++)
+  {
+    HashTraceHeader header;
+    if (!(fp[i] = FileSystem::OpenManagedCFile(paths[i], "rb", &error)))
+    {
+      ERROR_LOG("Failed to open '{}': {}", paths[i], error.GetDescription());
+      return false;
+    }
+    else if (std::fread(&header, sizeof(header), 1, fp[i].get()) != 1 || header.magic != HASH_TRACE_MAGIC ||
+             header.version != HASH_TRACE_VERSION ||
+             header.num_components != static_cast<u32>(HashTraceComponent::Count))
+    {
+      ERROR_LOG("'{}' is not a compatible hash trace.", paths[i]);
+      return false;
+    }
+  }
+
+  u32 num_frames = 0;
+  for (;;)
+  {
+    HashTraceFrame frames[2];
+    const bool has_frame1 = (std::fread(&frames[0], sizeof(frames[0]), 1, fp[0].get()) == 1);
+    const bool has_frame2 = (std::fread(&frames[1], sizeof(frames[1]), 1, fp[1].get()) == 1);
+    if (!has_frame1 || !has_frame2)
+    {
+      if (has_frame1 != has_frame2)
+      {
+        ERROR_LOG("Traces are identical for {} frames, but '{}' ends first.", num_frames,
+                  has_frame1 ? path2 : path1);
+        return false;
+      }
+
+      INFO_LOG("Traces are identical ({} frames).", num_frames);
+      return true;
+    }
+
+    if (frames[0].frame_number != frames[1].frame_number)
+    {
+      ERROR_LOG("Frame numbers diverge after {} frames: {} vs {}", num_frames, frames[0].frame_number,
+                frames[1].frame_number);
+      return false;
+    }
+
+    bool diverged = false;
+    for (size_t i = 0; i < static_cast<size_t>(HashTraceComponent::Count); i++)
+    {
+      if (frames[0].hashes[i] == frames[1].hashes[i])
+        continue;
+
+      if (!diverged)
+        ERROR_LOG("First divergence at frame {}:", frames[0].frame_number);
+
+      ERROR_LOG("  {}: {:016X} vs {:016X}", s_hash_trace_component_names[i], frames[0].hashes[i],
+                frames[1].hashes[i]);
+      diverged = true;
+    }
+    if (diverged)
+      return false;
+
+    num_frames++;
+  }
+}
+
+void RegTestHost::DumpEventStatistics()
+{
+  const TimingEvents::Statistics& stats = TimingEvents::GetStatistics();
+  const double frames = static_cast<double>(s_frames_to_run);
+  const double dispatch_time_us = Timer::ConvertValueToNanoseconds(stats.dispatch_time) / 1000.0;
+  const double callback_time_us = Timer::ConvertValueToNanoseconds(stats.callback_time) / 1000.0;
+  INFO_LOG("Events dispatched: {} ({:.1f} per frame)", stats.dispatched_events,
+           static_cast<double>(stats.dispatched_events) / frames);
+  INFO_LOG("Event queue updates: {} ({:.1f} per frame)", stats.queue_updates,
+           static_cast<double>(stats.queue_updates) / frames);
+  INFO_LOG("Event dispatch time: {:.2f}us per frame, {:.1f}ns per event", dispatch_time_us / frames,
+           (stats.dispatched_events > 0) ? (dispatch_time_us * 1000.0 / static_cast<double>(stats.dispatched_events)) :
+                                           0.0);
+  INFO_LOG("Event callback time: {:.2f}us per frame", callback_time_us / frames);
+}
+
+void RegTestHost::BeginBenchmark()
+{
+  BenchmarkState& bs = s_benchmark_state;
+  CPU::CodeCache::GetStatistics(&bs.start_code_cache_stats);
+  bs.frame_times.clear();
+  bs.frame_times.reserve(s_frames_to_run);
+  bs.timing_frames_remaining = s_frames_to_run;
+
+  bs.start_time = Timer::GetCurrentValue();
+  bs.last_frame_time = bs.start_time;
+}
+
+void RegTestHost::BeginBenchmarkProfiling()
+{
+  BenchmarkState& bs = s_benchmark_state;
+  CPU::CodeCache::GetStatistics(&bs.end_code_cache_stats);
+  bs.start_core_thread_time = System::GetCoreThreadHandle().GetCPUTime();
+  bs.start_video_thread_time = VideoThread::Internal::GetThreadHandle().GetCPUTime();
+  bs.profiling = true;
+
+  // Per-event timing is what the subsystem breakdown is built from.
+  TimingEvents::ResetStatistics();
+  TimingEvents::SetProfilingEnabled(true);
+}
+
+void RegTestHost::UpdateBenchmark()
+{
+  BenchmarkState& bs = s_benchmark_state;
+  if (bs.warmup_frames_remaining > 0)
+  {
+    if (--bs.warmup_frames_remaining == 0)
+    {
+      INFO_LOG("Warm-up complete, measuring {} frames...", s_frames_to_run);
+      BeginBenchmark();
+    }
+
+    return;
+  }
+  else if (bs.profiling)
+  {
+    return;
+  }
+
+  const Timer::Value current_time = Timer::GetCurrentValue();
+  bs.frame_times.push_back(Timer::ConvertValueToMilliseconds(current_time - bs.last_frame_time));
+  bs.last_frame_time = current_time;
+
+  if (--bs.timing_frames_remaining == 0)
+  {
+    INFO_LOG("Timing complete, profiling {} frames...", s_frames_to_run);
+    BeginBenchmarkProfiling();
+  }
+}
+
+void RegTestHost::EndBenchmark()
+{
+  Error error;
+  if (!WriteBenchmarkReport(&error))
+  {
+    ERROR_LOG("Failed to write benchmark report: {}", error.GetDescription());
+    return;
+  }
+
+  s_benchmark_state.report_written = true;
+}
+
+static void AppendJSONString(std::string& dest, std::string_view str)
+{
+  dest.push_back('"');
+  for (const char ch : str)
+  {
+    if (ch == '"' || ch == '\\')
+    {
+      dest.push_back('\\');
+      dest.push_back(ch);
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20)
+    {
+      fmt::format_to(std::back_inserter(dest), "\\u{:04x}", static_cast<unsigned>(ch));
+    }
+    else
+    {
+      dest.push_back(ch);
+    }
+  }
+  dest.push_back('"');
+}
+
+bool RegTestHost::WriteBenchmarkReport(Error* error)
+{
+  const BenchmarkState& bs = s_benchmark_state;
+  const double total_time_ms = Timer::ConvertValueToMilliseconds(bs.last_frame_time - bs.start_time);
+  const u64 core_thread_ticks = System::GetCoreThreadHandle().GetCPUTime() - bs.start_core_thread_time;
+  const u64 video_thread_ticks = VideoThread::Internal::GetThreadHandle().GetCPUTime() - bs.start_video_thread_time;
+  const double thread_ticks_to_ms = 1000.0 / static_cast<double>(Threading::GetThreadTicksPerSecond());
+  const double core_thread_ms = static_cast<double>(core_thread_ticks) * thread_ticks_to_ms;
+  const double video_thread_ms = static_cast<double>(video_thread_ticks) * thread_ticks_to_ms;
+
+  std::vector<double> sorted_frame_times = bs.frame_times;
+  std::sort(sorted_frame_times.begin(), sorted_frame_times.end());
+  const size_t num_frames = sorted_frame_times.size();
+  const auto percentile = [&sorted_frame_times, num_frames](double pct) {
+    // Nearest-rank method.
+    if (num_frames == 0)
+      return 0.0;
+    const size_t rank = static_cast<size_t>(std::ceil((pct / 100.0) * static_cast<double>(num_frames)));
+    return sorted_frame_times[std::clamp<size_t>(rank, 1, num_frames) - 1];
+  };
+  double frame_time_sum = 0.0;
+  for (const double ft : sorted_frame_times)
+    frame_time_sum += ft;
+
+  // Group the event callbacks by the subsystem that owns them. Whatever the core thread spent outside the event loop
+  // is attributed to the CPU, this includes memory-mapped I/O handlers invoked by CPU code.
+  double gpu_ms = 0.0, spu_ms = 0.0, cdrom_ms = 0.0, other_events_ms = 0.0;
+  std::vector<TimingEvents::EventStatistics> events(TimingEvents::GetEventStatistics().begin(),
+                                                    TimingEvents::GetEventStatistics().end());
+  std::sort(events.begin(), events.end(),
+            [](const auto& lhs, const auto& rhs) { return (lhs.callback_time > rhs.callback_time); });
+  for (const TimingEvents::EventStatistics& es : events)
+  {
+    const double ms = Timer::ConvertValueToMilliseconds(es.callback_time);
+    if (es.name.starts_with("GPU"))
+      gpu_ms += ms;
+    else if (es.name.starts_with("SPU"))
+      spu_ms += ms;
+    else if (es.name.starts_with("CDROM"))
+      cdrom_ms += ms;
+    else
+      other_events_ms += ms;
+  }
+
+  const TimingEvents::Statistics& event_stats = TimingEvents::GetStatistics();
+  const double events_ms = Timer::ConvertValueToMilliseconds(event_stats.dispatch_time);
+  const double cpu_ms = std::max(
+    core_thread_ms - Timer::ConvertValueToMilliseconds(event_stats.dispatch_time + event_stats.callback_time), 0.0);
+
+  std::string json;
+  json.reserve(4096);
+  json += "{\n  \"game\": ";
+  AppendJSONString(json, System::GetGamePath());
+  json += ",\n  \"renderer\": ";
+  AppendJSONString(json, Settings::GetRendererName(g_settings.gpu_renderer));
+  json += ",\n  \"cpu_execution_mode\": ";
+  AppendJSONString(json, Settings::GetCPUExecutionModeName(g_settings.cpu_execution_mode));
+  fmt::format_to(std::back_inserter(json),
+                 ",\n  \"warmup_frames\": {},\n  \"frames\": {},\n  \"profile_frames\": {},\n"
+                 "  \"total_time_ms\": {:.3f},\n  \"average_fps\": {:.2f},\n",
+                 bs.warmup_frames, num_frames, s_frames_to_run, total_time_ms,
+                 (total_time_ms > 0.0) ? (static_cast<double>(num_frames) / total_time_ms * 1000.0) : 0.0);
+  fmt::format_to(std::back_inserter(json),
+                 "  \"frame_time_ms\": {{\"min\": {:.3f}, \"avg\": {:.3f}, \"p50\": {:.3f}, \"p90\": {:.3f}, "
+                 "\"p95\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f}}},\n",
+                 (num_frames > 0) ? sorted_frame_times.front() : 0.0,
+                 (num_frames > 0) ? (frame_time_sum / static_cast<double>(num_frames)) : 0.0, percentile(50.0),
+                 percentile(90.0), percentile(95.0), percentile(99.0),
+                 (num_frames > 0) ? sorted_frame_times.back() : 0.0);
+  fmt::format_to(std::back_inserter(json),
+                 "  \"subsystem_time_ms\": {{\"cpu\": {:.3f}, \"gpu\": {:.3f}, \"gpu_backend\": {:.3f}, "
+                 "\"spu\": {:.3f}, \"cdrom\": {:.3f}, \"other_events\": {:.3f}, \"timing_events\": {:.3f}}},\n",
+                 cpu_ms, gpu_ms, video_thread_ms, spu_ms, cdrom_ms, other_events_ms, events_ms);
+  fmt::format_to(std::back_inserter(json), "  \"thread_time_ms\": {{\"core\": {:.3f}, \"video\": {:.3f}}},\n",
+                 core_thread_ms, video_thread_ms);
+
+  json += "  \"events\": [";
+  for (size_t i = 0; i < events.size(); i++)
+  {
+    json += (i == 0) ? "\n    {\"name\": " : ",\n    {\"name\": ";
+    AppendJSONString(json, events[i].name);
+    fmt::format_to(std::back_inserter(json), ", \"invocations\": {}, \"time_ms\": {:.3f}}}", events[i].invocations,
+                   Timer::ConvertValueToMilliseconds(events[i].callback_time));
+  }
+  json += events.empty() ? "],\n" : "\n  ],\n";
+
+  const CPU::CodeCache::Statistics& start_ccs = bs.start_code_cache_stats;
+  const CPU::CodeCache::Statistics& code_cache_stats = bs.end_code_cache_stats;
+  fmt::format_to(std::back_inserter(json),
+                 "  \"code_cache\": {{\"blocks_created\": {}, \"blocks_compiled\": {}, \"blocks_invalidated\": {}, "
+                 "\"code_buffer_used\": {}, \"code_buffer_size\": {}, \"far_code_buffer_used\": {}, "
+                 "\"far_code_buffer_size\": {}}}\n}}\n",
+                 code_cache_stats.blocks_created - start_ccs.blocks_created,
+                 code_cache_stats.blocks_compiled - start_ccs.blocks_compiled,
+                 code_cache_stats.blocks_invalidated - start_ccs.blocks_invalidated, code_cache_stats.code_buffer_used,
+                 code_cache_stats.code_buffer_size, code_cache_stats.far_code_buffer_used,
+                 code_cache_stats.far_code_buffer_size);
+
+  if (bs.report_path == "-")
+  {
+    std::fwrite(json.data(), json.size(), 1, stdout);
+    std::fflush(stdout);
+    return true;
+  }
+
+  return FileSystem::WriteStringToFile(bs.report_path.c_str(), json, error);
+}
+
+std::vector<std::string> RegTestHost::GetBatchChildArguments(int argc, char* argv[])
+{
+  // Everything except the batch options is passed through to each game's runner.
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!std::strcmp(argv[i], "--"))
+      break;
+
+    if ((!std::strcmp(argv[i], "-batch") || !std::strcmp(argv[i], "-jobs") || !std::strcmp(argv[i], "-report")) &&
+        (i + 1) < argc)
+    {
+      i++;
+      continue;
+    }
+
+    args.emplace_back(argv[i]);
   }
 
-  INFO_LOG("VRAM Hash: {}", SHA256Digest::DigestToString(SHA256Digest::GetDigest(
-                              std::span<const u8>(reinterpret_cast<const u8*>(g_vram), VRAM_SIZE))));
+  return args;
+}
+
+void RegTestHost::AddBatchBIOSArguments(std::vector<std::string>& args)
+{
+  // Identifying the BIOS means hashing every image in the directory, do it once rather than in every child.
+  const std::vector<std::pair<std::string, const BIOS::ImageInfo*>> images =
+    BIOS::FindBIOSImagesInDirectory(EmuFolders::Bios.c_str());
+
+  static constexpr const std::pair<ConsoleRegion, const char*> regions[] = {
+    {ConsoleRegion::NTSC_U, "-bios-ntscu"},
+    {ConsoleRegion::NTSC_J, "-bios-ntscj"},
+    {ConsoleRegion::PAL, "-bios-pal"},
+  };
+  for (const auto& [region, arg] : regions)
+  {
+    // Same precedence as BIOS::FindBIOSImageInDirectory().
+    const std::pair<std::string, const BIOS::ImageInfo*>* best = nullptr;
+    bool best_region_match = false;
+    for (const auto& image : images)
+    {
+      const bool region_match = (image.second && BIOS::IsValidBIOSForRegion(region, image.second->region));
+      if (best && ((best->second && !image.second) || (best_region_match && !region_match) ||
+                   (best->second && image.second && best->second->priority < image.second->priority)))
+      {
+        continue;
+      }
+
+      best = &image;
+      best_region_match = region_match;
+    }
+
+    if (!best)
+      continue;
+
+    INFO_LOG("Using '{}' for {} games.", best->first, Settings::GetConsoleRegionName(region));
+    args.emplace_back(arg);
+    args.push_back(best->first);
+  }
+}
+
+int RegTestHost::RunChildProcess(const std::string& program, const std::vector<std::string>& args)
+{
+#ifdef _WIN32
+  // CommandLineToArgvW() quoting rules.
+  std::wstring command_line;
+  const auto append_arg = [&command_line](const std::string& arg) {
+    const std::wstring warg = StringUtil::UTF8StringToWideString(arg);
+    if (!command_line.empty())
+      command_line.push_back(L' ');
+    if (!warg.empty() && warg.find_first_of(L" \t\"") == std::wstring::npos)
+    {
+      command_line.append(warg);
+      return;
+    }
+
+    command_line.push_back(L'"');
+    size_t num_backslashes = 0;
+    for (const wchar_t ch : warg)
+    {
+      if (ch == L'\\')
+      {
+        num_backslashes++;
+        continue;
+      }
+
+      command_line.append((ch == L'"') ? (num_backslashes * 2 + 1) : num_backslashes, L'\\');
+      command_line.push_back(ch);
+      num_backslashes = 0;
+    }
+    command_line.append(num_backslashes * 2, L'\\');
+    command_line.push_back(L'"');
+  };
+  append_arg(program);
+  for (const std::string& arg : args)
+    append_arg(arg);
+
+  STARTUPINFOW si = {};
+  si.cb = sizeof(si);
+  PROCESS_INFORMATION pi = {};
+  if (!CreateProcessW(StringUtil::UTF8StringToWideString(program).c_str(), command_line.data(), nullptr, nullptr,
+                      FALSE, 0, nullptr, nullptr, &si, &pi))
+  {
+    ERROR_LOG("CreateProcessW() failed: {}", GetLastError());
+    return -1;
+  }
+
+  WaitForSingleObject(pi.hProcess, INFINITE);
+
+  DWORD exit_code = static_cast<DWORD>(-1);
+  GetExitCodeProcess(pi.hProcess, &exit_code);
+  CloseHandle(pi.hThread);
+  CloseHandle(pi.hProcess);
+  return static_cast<int>(exit_code);
+#else
+  std::vector<char*> argv;
+  argv.reserve(args.size() + 2);
+  argv.push_back(const_cast<char*>(program.c_str()));
+  for (const std::string& arg : args)
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  argv.push_back(nullptr);
+
+  pid_t pid;
+  const int res = posix_spawn(&pid, program.c_str(), nullptr, nullptr, argv.data(), environ);
+  if (res != 0)
+  {
+    ERROR_LOG("posix_spawn() failed: {}", res);
+    return -1;
+  }
+
+  int status;
+  while (waitpid(pid, &status, 0) < 0)
+  {
+    if (errno != EINTR)
+      return -1;
+  }
+
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+bool RegTestHost::RunBatch(int argc, char* argv[])
+{
+  struct BatchGame
+  {
+    std::string path;
+    std::string hash_file_path;
+    std::string hashes;
+    int exit_code;
+    double time_ms;
+  };
+
+  // Progress is reported even without -console, that's passed through to the children.
+  InitializeEarlyConsole();
+
+  Error error;
+  std::optional<std::string> list = FileSystem::ReadFileToString(s_batch_list_path.c_str(), &error);
+  if (!list.has_value())
+  {
+    ERROR_LOG("Failed to read batch list: {}", error.GetDescription());
+    return false;
+  }
+
+  std::string program = FileSystem::GetProgramPath(&error);
+  if (program.empty())
+  {
+    ERROR_LOG("Failed to get program path: {}", error.GetDescription());
+    return false;
+  }
+
+  const std::string report_path =
+    s_batch_report_path.empty() ? Path::Combine(EmuFolders::DataRoot, "regtest_report.json") : s_batch_report_path;
+
+  std::vector<BatchGame> games;
+  for (const std::string_view line : StringUtil::SplitString(list.value(), '\n'))
+  {
+    const std::string_view path = StringUtil::StripWhitespace(line);
+    if (path.empty() || path.front() == '#')
+      continue;
+
+    BatchGame& game = games.emplace_back();
+    game.path = path;
+    game.hash_file_path = fmt::format("{}.{}.hashes", report_path, games.size() - 1);
+    game.exit_code = -1;
+    game.time_ms = 0.0;
+  }
+  if (games.empty())
+  {
+    ERROR_LOG("No games in batch list '{}'.", s_batch_list_path);
+    return false;
+  }
+
+  // Resolve everything the children share up front: the game database cache is written if it's stale, so each
+  // child only has to read it, and the BIOS images are passed by name instead of being searched for.
+  GameDatabase::EnsureLoaded();
+  std::vector<std::string> child_args = GetBatchChildArguments(argc, argv);
+  AddBatchBIOSArguments(child_args);
+
+  const u32 num_jobs = std::min<u32>((s_batch_jobs > 0) ? s_batch_jobs :
+                                                          std::max(std::thread::hardware_concurrency(), 1u),
+                                     static_cast<u32>(games.size()));
+  INFO_LOG("Running {} games with {} jobs...", games.size(), num_jobs);
+
+  const Timer::Value start_time = Timer::GetCurrentValue();
+  std::atomic<u32> next_game{0};
+  std::atomic<u32> games_completed{0};
+  const auto worker = [&]() {
+    for (;;)
+    {
+      const u32 index = next_game.fetch_add(1, std::memory_order_relaxed);
+      if (index >= games.size())
+        break;
+
+      BatchGame& game = games[index];
+      std::vector<std::string> args = child_args;
+      args.emplace_back("-hashfile");
+      args.push_back(game.hash_file_path);
+      args.emplace_back("--");
+      args.push_back(game.path);
+
+      FileSystem::DeleteFile(game.hash_file_path.c_str());
+
+      const Timer::Value game_start_time = Timer::GetCurrentValue();
+      game.exit_code = RunChildProcess(program, args);
+      game.time_ms = Timer::ConvertValueToMilliseconds(Timer::GetCurrentValue() - game_start_time);
+      if (std::optional<std::string> hashes = FileSystem::ReadFileToString(game.hash_file_path.c_str()))
+      {
+        game.hashes = std::move(hashes.value());
+        FileSystem::DeleteFile(game.hash_file_path.c_str());
+      }
+
+      const u32 completed = games_completed.fetch_add(1, std::memory_order_relaxed) + 1;
+      INFO_LOG("[{}/{}] {}: {} ({:.0f}ms)", completed, games.size(), Path::GetFileName(game.path),
+               (game.exit_code == 0) ? "OK" : "FAILED", game.time_ms);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_jobs - 1);
+  for (u32 i = 1; i < num_jobs; i++)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  const double total_time_ms = Timer::ConvertValueToMilliseconds(Timer::GetCurrentValue() - start_time);
+  u32 num_failed = 0;
+
+  std::string json;
+  json += "{\n  \"games\": [";
+  for (size_t i = 0; i < games.size(); i++)
+  {
+    const BatchGame& game = games[i];
+    num_failed += BoolToUInt32(game.exit_code != 0);
+
+    json += (i == 0) ? "\n    {\"path\": " : ",\n    {\"path\": ";
+    AppendJSONString(json, game.path);
+    fmt::format_to(std::back_inserter(json), ", \"exit_code\": {}, \"time_ms\": {:.0f}, \"hashes\": {{",
+                   game.exit_code, game.time_ms);
+
+    bool first_hash = true;
+    for (const std::string_view line : StringUtil::SplitString(game.hashes, '\n'))
+    {
+      const std::string_view::size_type pos = line.find(": ");
+      if (pos == std::string_view::npos)
+        continue;
+
+      json += first_hash ? "" : ", ";
+      AppendJSONString(json, line.substr(0, pos));
+      json += ": ";
+      AppendJSONString(json, StringUtil::StripWhitespace(line.substr(pos + 2)));
+      first_hash = false;
+    }
+    json += "}}";
+  }
+  fmt::format_to(std::back_inserter(json),
+                 "\n  ],\n  \"passed\": {},\n  \"failed\": {},\n  \"total_time_ms\": {:.0f}\n}}\n",
+                 games.size() - num_failed, num_failed, total_time_ms);
+
+  if (!FileSystem::WriteStringToFile(report_path.c_str(), json, &error))
+  {
+    ERROR_LOG("Failed to write batch report: {}", error.GetDescription());
+    return false;
+  }
+
+  INFO_LOG("{} of {} games passed in {:.2f}s, report written to '{}'.", games.size() - num_failed, games.size(),
+           total_time_ms / 1000.0, report_path);
+  return (num_failed == 0);
 }
 
 void RegTestHost::InitializeEarlyConsole()
@@ -770,6 +1524,21 @@ void RegTestHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -dumpdir: Set frame dump base directory (will be dumped to basedir/gametitle).\n");
   std::fprintf(stderr, "  -dumpinterval: Dumps every N frames.\n");
   std::fprintf(stderr, "  -frames: Sets the number of frames to execute.\n");
+  std::fprintf(stderr, "  -eventstats: Measures the cost of timing event dispatch per frame.\n");
+  std::fprintf(stderr, "  -benchmark <file>: Writes a JSON performance report to file, or stdout if '-'.\n"
+                       "    Disables frame dumping and audio output. Frame times are measured first, then the\n"
+                       "    subsystem breakdown over the same number of frames with event profiling enabled.\n");
+  std::fprintf(stderr, "  -warmup <frames>: Frames to run before measuring in benchmark mode. Defaults to 300.\n");
+  std::fprintf(stderr, "  -batch <file>: Runs each game listed in file, one per line, in a separate process.\n"
+                       "    All other parameters are passed through to each game's process.\n");
+  std::fprintf(stderr, "  -jobs <count>: Number of games to run concurrently in batch mode. Defaults to CPU count.\n");
+  std::fprintf(stderr, "  -report <file>: Writes the hashes of all games in batch mode to a JSON file.\n");
+  std::fprintf(stderr, "  -hashfile <file>: Writes the system state hashes to file when execution completes.\n");
+  std::fprintf(stderr, "  -fasthash: Uses XXH3-128 instead of SHA-256 for the system state hashes.\n");
+  std::fprintf(stderr, "  -hashtrace <file>: Writes per-component state hashes for every frame to file.\n");
+  std::fprintf(stderr, "  -hashdiff <file1> <file2>: Compares two hash traces, reporting the first divergent frame.\n");
+  std::fprintf(stderr, "  -bios-ntscu/-bios-ntscj/-bios-pal <file>: Uses the BIOS image in the BIOS directory\n"
+                       "    for games of that region, instead of searching for one.\n");
   std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
   std::fprintf(stderr, "  -console: Enables console logging output.\n");
   std::fprintf(stderr, "  -pgxp: Enables PGXP.\n");
@@ -843,6 +1612,92 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
 
         continue;
       }
+      else if (CHECK_ARG("-eventstats"))
+      {
+        s_event_statistics = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        s_benchmark_state.report_path = argv[++i];
+        if (s_benchmark_state.report_path.empty())
+        {
+          ERROR_LOG("Invalid benchmark report path specified.");
+          return false;
+        }
+
+        s_benchmark = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-warmup"))
+      {
+        const std::optional<u32> warmup_frames = StringUtil::FromChars<u32>(argv[++i]);
+        if (!warmup_frames.has_value())
+        {
+          ERROR_LOG("Invalid warm-up frame count specified: {}", argv[i]);
+          return false;
+        }
+
+        s_benchmark_state.warmup_frames = warmup_frames.value();
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-batch"))
+      {
+        s_batch_list_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-jobs"))
+      {
+        s_batch_jobs = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_batch_jobs == 0)
+        {
+          ERROR_LOG("Invalid job count specified: {}", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-report"))
+      {
+        s_batch_report_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-hashfile"))
+      {
+        s_hash_file_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG("-fasthash"))
+      {
+        s_fast_hash = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-hashtrace"))
+      {
+        s_hash_trace_path = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG("-hashdiff") && (i + 2) < argc)
+      {
+        s_hash_diff_paths[0] = argv[++i];
+        s_hash_diff_paths[1] = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-bios-ntscu"))
+      {
+        Core::SetBaseStringSettingValue("BIOS", "PathNTSCU", argv[++i]);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-bios-ntscj"))
+      {
+        Core::SetBaseStringSettingValue("BIOS", "PathNTSCJ", argv[++i]);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-bios-pal"))
+      {
+        Core::SetBaseStringSettingValue("BIOS", "PathPAL", argv[++i]);
+        continue;
+      }
       else if (CHECK_ARG_PARAM("-log"))
       {
         std::optional<Log::Level> level = Settings::ParseLogLevelName(argv[++i]);
@@ -991,12 +1846,41 @@ int main(int argc, char* argv[])
   if (!RegTestHost::ParseCommandLineParameters(argc, argv, autoboot))
     return EXIT_FAILURE;
 
+  if (!s_hash_diff_paths[0].empty())
+  {
+    const bool diff_result = RegTestHost::DiffHashTraces(s_hash_diff_paths[0].c_str(), s_hash_diff_paths[1].c_str());
+    System::ProcessShutdown();
+    return diff_result ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (!s_batch_list_path.empty())
+  {
+    if (autoboot.has_value() || s_benchmark || !s_hash_trace_path.empty())
+    {
+      ERROR_LOG("Batch mode can't be combined with a boot path, benchmark mode or hash tracing.");
+      return EXIT_FAILURE;
+    }
+
+    const bool batch_result = RegTestHost::RunBatch(argc, argv);
+    System::ProcessShutdown();
+    return batch_result ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
   if (!autoboot || autoboot->path.empty())
   {
     ERROR_LOG("No boot path specified.");
     return EXIT_FAILURE;
   }
 
+  if (s_benchmark)
+  {
+    // Frame dumps and dev logging to file would dominate the measurements.
+    if (!s_dump_base_directory.empty() || s_frame_dump_interval > 0)
+      WARNING_LOG("Frame dumping is disabled in benchmark mode.");
+    s_dump_base_directory = {};
+    s_frame_dump_interval = 0;
+  }
+
   if (!RegTestHost::SetNewDataRoot(autoboot->path))
     return EXIT_FAILURE;
 
@@ -1013,6 +1897,7 @@ int main(int argc, char* argv[])
   s_video_thread.Start(&RegTestHost::VideoThreadEntryPoint);
 
   int result = -1;
+  u32 total_frames;
   INFO_LOG("Trying to boot '{}'...", autoboot->path);
   if (!System::BootSystem(std::move(autoboot.value()), &error))
   {
@@ -1038,8 +1923,42 @@ int main(int argc, char* argv[])
     INFO_LOG("Dumping every {}th frame to '{}'.", s_frame_dump_interval, s_dump_base_directory);
   }
 
-  INFO_LOG("Running for {} frames...", s_frames_to_run);
-  s_frames_remaining = s_frames_to_run;
+  if (!s_hash_trace_path.empty())
+  {
+    if (!RegTestHost::OpenHashTrace(&error))
+    {
+      ERROR_LOG("Failed to open hash trace: {}", error.GetDescription());
+      goto cleanup;
+    }
+
+    INFO_LOG("Writing hash trace to '{}'.", s_hash_trace_path);
+  }
+
+  total_frames = s_frames_to_run;
+  if (s_benchmark)
+  {
+    SPU::SetAudioOutputMuted(true);
+
+    // Timing and profiling passes of the same length.
+    INFO_LOG("Benchmarking for {} frames after {} warm-up frames...", s_frames_to_run,
+             RegTestHost::s_benchmark_state.warmup_frames);
+    total_frames = RegTestHost::s_benchmark_state.warmup_frames + s_frames_to_run * 2;
+    RegTestHost::s_benchmark_state.warmup_frames_remaining = RegTestHost::s_benchmark_state.warmup_frames;
+    if (RegTestHost::s_benchmark_state.warmup_frames == 0)
+      RegTestHost::BeginBenchmark();
+  }
+  else
+  {
+    INFO_LOG("Running for {} frames...", s_frames_to_run);
+  }
+
+  s_frames_remaining = total_frames;
+
+  if (s_event_statistics && !s_benchmark)
+  {
+    TimingEvents::ResetStatistics();
+    TimingEvents::SetProfilingEnabled(true);
+  }
 
   {
     const Timer::Value start_time = Timer::GetCurrentValue();
@@ -1049,14 +1968,19 @@ int main(int argc, char* argv[])
     const Timer::Value elapsed_time = Timer::GetCurrentValue() - start_time;
     const double elapsed_time_ms = Timer::ConvertValueToMilliseconds(elapsed_time);
     INFO_LOG("Total execution time: {:.2f}ms, average frame time {:.2f}ms, {:.2f} FPS", elapsed_time_ms,
-             elapsed_time_ms / static_cast<double>(s_frames_to_run),
-             static_cast<double>(s_frames_to_run) / elapsed_time_ms * 1000.0);
+             elapsed_time_ms / static_cast<double>(total_frames),
+             static_cast<double>(total_frames) / elapsed_time_ms * 1000.0);
   }
 
+  if (s_benchmark && !RegTestHost::s_benchmark_state.report_written)
+    goto cleanup;
+
   INFO_LOG("Exiting with success.");
   result = 0;
 
 cleanup:
+  RegTestHost::s_hash_trace_file.reset();
+
   if (s_video_thread.Joinable())
   {
     VideoThread::Internal::RequestShutdown();
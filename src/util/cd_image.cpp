@@ -357,6 +357,14 @@ bool CDImage::IsPrecached() const
   return false;
 }
 
+void CDImage::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+}
+
+void CDImage::SetMemoryMapping(bool enabled)
+{
+}
+
 s64 CDImage::GetSizeOnDisk() const
 {
   return -1;
@@ -277,6 +277,14 @@ public:
   virtual PrecacheResult Precache(ProgressCallback* progress, Error* error);
   virtual bool IsPrecached() const;
 
+  // Sets the number of decompressed blocks kept in memory, and how many blocks past the last read are decompressed
+  // ahead of time on a worker thread. Only used by compressed formats.
+  virtual void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks);
+
+  // Serves sectors of uncompressed images from a memory mapping of the file, instead of reading it. If the file is
+  // truncated or the storage goes away, accessing the mapping crashes instead of failing the read.
+  virtual void SetMemoryMapping(bool enabled);
+
   // Returns the size on disk of the image. This could be multiple files.
   // If this function returns -1, it means the size could not be computed.
   virtual s64 GetSizeOnDisk() const;
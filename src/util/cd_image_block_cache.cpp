@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2019-2026 Connor McLaughlin <stenzek@gmail.com> and contributors.
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#include "cd_image_block_cache.h"
+
+#include "common/assert.h"
+#include "common/log.h"
+
+#include <algorithm>
+#include <limits>
+
+LOG_CHANNEL(CDImage);
+
+CDImageBlockCache::CDImageBlockCache() = default;
+
+CDImageBlockCache::~CDImageBlockCache()
+{
+  StopPrefetchThread();
+}
+
+void CDImageBlockCache::Reset(u32 block_size, u32 block_count, u32 cache_blocks, u32 prefetch_blocks,
+                              DecompressFunction decompress)
+{
+  StopPrefetchThread();
+
+  // Prefetched blocks need somewhere to go that isn't the block currently being read from.
+  m_prefetch_count = std::min(prefetch_blocks, block_count);
+  const u32 num_slots = std::max(std::max(cache_blocks, 1u), (m_prefetch_count > 0) ? (m_prefetch_count + 1) : 0u);
+  DEV_LOG("Caching {} blocks, prefetching {} blocks", num_slots, m_prefetch_count);
+
+  m_decompress = std::move(decompress);
+  m_block_size = block_size;
+  m_block_count = block_count;
+  m_cache.resize(num_slots * block_size);
+  m_cache_slots.assign(num_slots, CacheSlot{INVALID_BLOCK, 0, false});
+  m_current_block_data = nullptr;
+  m_current_block = INVALID_BLOCK;
+  m_current_slot = INVALID_BLOCK;
+  m_cache_use_counter = 0;
+  m_prefetch_next = 0;
+  m_prefetch_end = 0;
+
+  if (m_prefetch_count > 0)
+  {
+    m_prefetch_shutdown = false;
+    m_prefetch_thread = std::thread(&CDImageBlockCache::PrefetchThreadEntryPoint, this);
+  }
+}
+
+void CDImageBlockCache::Shutdown()
+{
+  StopPrefetchThread();
+
+  for (CacheSlot& slot : m_cache_slots)
+    slot = CacheSlot{INVALID_BLOCK, 0, false};
+  m_current_block_data = nullptr;
+  m_current_block = INVALID_BLOCK;
+  m_current_slot = INVALID_BLOCK;
+  m_prefetch_count = 0;
+  m_prefetch_next = 0;
+  m_prefetch_end = 0;
+}
+
+void CDImageBlockCache::StopPrefetchThread()
+{
+  if (!m_prefetch_thread.joinable())
+    return;
+
+  {
+    std::unique_lock lock(m_mutex);
+    m_prefetch_shutdown = true;
+    m_prefetch_cv.notify_one();
+  }
+
+  m_prefetch_thread.join();
+}
+
+void CDImageBlockCache::PrefetchThreadEntryPoint()
+{
+  std::unique_lock lock(m_mutex);
+  for (;;)
+  {
+    m_prefetch_cv.wait(lock, [this]() { return (m_prefetch_shutdown || m_prefetch_next < m_prefetch_end); });
+    if (m_prefetch_shutdown)
+      break;
+
+    const u32 block_index = m_prefetch_next++;
+    if (FindCacheSlot(block_index) != INVALID_BLOCK)
+      continue;
+
+    const u32 slot = GetEvictionSlot(true);
+    if (slot == INVALID_BLOCK)
+    {
+      m_prefetch_next = m_prefetch_end;
+      continue;
+    }
+
+    m_cache_slots[slot] = CacheSlot{block_index, ++m_cache_use_counter, true};
+    lock.unlock();
+
+    const bool result = m_decompress(block_index, &m_cache[slot * m_block_size], true);
+
+    lock.lock();
+    m_cache_slots[slot].loading = false;
+    if (!result)
+      m_cache_slots[slot].block_index = INVALID_BLOCK;
+    m_slot_loaded_cv.notify_one();
+  }
+}
+
+u32 CDImageBlockCache::FindCacheSlot(u32 block_index) const
+{
+  for (u32 i = 0; i < static_cast<u32>(m_cache_slots.size()); i++)
+  {
+    if (m_cache_slots[i].block_index == block_index)
+      return i;
+  }
+
+  return INVALID_BLOCK;
+}
+
+u32 CDImageBlockCache::GetEvictionSlot(bool for_prefetch) const
+{
+  u32 best_slot = INVALID_BLOCK;
+  u32 best_last_used = std::numeric_limits<u32>::max();
+  for (u32 i = 0; i < static_cast<u32>(m_cache_slots.size()); i++)
+  {
+    const CacheSlot& slot = m_cache_slots[i];
+    if (slot.loading || (for_prefetch && i == m_current_slot))
+      continue;
+
+    if (slot.last_used <= best_last_used)
+    {
+      best_slot = i;
+      best_last_used = slot.last_used;
+    }
+  }
+
+  return best_slot;
+}
+
+const u8* CDImageBlockCache::GetBlock(u32 block_index)
+{
+  if (m_current_block == block_index)
+    return m_current_block_data;
+
+  std::unique_lock lock(m_mutex);
+  u32 slot = FindCacheSlot(block_index);
+  if (slot != INVALID_BLOCK && m_cache_slots[slot].loading)
+  {
+    // prefetch thread is still decompressing it, which is still quicker than starting over
+    m_slot_loaded_cv.wait(lock, [this, slot]() { return !m_cache_slots[slot].loading; });
+    if (m_cache_slots[slot].block_index != block_index)
+      slot = INVALID_BLOCK;
+  }
+
+  if (slot == INVALID_BLOCK)
+  {
+    // at most one slot is being prefetched, and there's always at least two when prefetching
+    slot = GetEvictionSlot(false);
+    DebugAssert(slot != INVALID_BLOCK);
+    m_cache_slots[slot] = CacheSlot{block_index, 0, true};
+    m_current_slot = slot;
+    lock.unlock();
+
+    const bool result = m_decompress(block_index, &m_cache[slot * m_block_size], false);
+
+    lock.lock();
+    m_cache_slots[slot].loading = false;
+    if (!result)
+    {
+      // data might have been partially written
+      m_cache_slots[slot].block_index = INVALID_BLOCK;
+      m_current_block_data = nullptr;
+      m_current_block = INVALID_BLOCK;
+      return nullptr;
+    }
+  }
+
+  m_cache_slots[slot].last_used = ++m_cache_use_counter;
+  m_current_slot = slot;
+  m_current_block_data = &m_cache[slot * m_block_size];
+  m_current_block = block_index;
+
+  // queue up the following blocks, assuming the read is sequential
+  if (m_prefetch_count > 0)
+  {
+    m_prefetch_next = block_index + 1;
+    m_prefetch_end = std::min(block_index + 1 + m_prefetch_count, m_block_count);
+    m_prefetch_cv.notify_one();
+  }
+
+  return m_current_block_data;
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2019-2026 Connor McLaughlin <stenzek@gmail.com> and contributors.
+// SPDX-License-Identifier: CC-BY-NC-ND-4.0
+
+#pragma once
+
+#include "common/heap_array.h"
+#include "common/types.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// LRU cache of decompressed blocks for compressed disc images, with an optional thread which decompresses the blocks
+// following the last one read, assuming the reads are sequential.
+class CDImageBlockCache
+{
+public:
+  // Decompresses a block into the buffer, returning false on error. Called from both the reading thread and the
+  // prefetch thread, for_prefetch says which so that each can use its own decompression state.
+  using DecompressFunction = std::function<bool(u32 block_index, u8* buffer, bool for_prefetch)>;
+
+  CDImageBlockCache();
+  ~CDImageBlockCache();
+
+  // Drops any cached blocks, and starts the prefetch thread if prefetch_blocks is not zero.
+  void Reset(u32 block_size, u32 block_count, u32 cache_blocks, u32 prefetch_blocks, DecompressFunction decompress);
+
+  // Stops the prefetch thread and drops any cached blocks, later reads decompress on the calling thread. Has to be
+  // called before anything the prefetch thread uses goes away or changes.
+  void Shutdown();
+
+  // Returns the decompressed block, which stays valid until the next call. Null if it couldn't be decompressed.
+  const u8* GetBlock(u32 block_index);
+
+private:
+  static constexpr u32 INVALID_BLOCK = static_cast<u32>(-1);
+
+  struct CacheSlot
+  {
+    u32 block_index;
+    u32 last_used;
+    bool loading;
+  };
+
+  u32 FindCacheSlot(u32 block_index) const;
+  u32 GetEvictionSlot(bool for_prefetch) const;
+
+  void StopPrefetchThread();
+  void PrefetchThreadEntryPoint();
+
+  DecompressFunction m_decompress;
+  u32 m_block_size = 0;
+  u32 m_block_count = 0;
+
+  // Only accessed by the reading thread.
+  const u8* m_current_block_data = nullptr;
+  u32 m_current_block = INVALID_BLOCK;
+
+  // Shared with the prefetch thread. The slot of the current block is never evicted.
+  DynamicHeapArray<u8, 16> m_cache;
+  std::vector<CacheSlot> m_cache_slots;
+  u32 m_current_slot = INVALID_BLOCK;
+  u32 m_cache_use_counter = 0;
+  u32 m_prefetch_count = 0;
+  u32 m_prefetch_next = 0;
+  u32 m_prefetch_end = 0;
+  bool m_prefetch_shutdown = false;
+
+  std::mutex m_mutex;
+  std::condition_variable m_prefetch_cv;
+  std::condition_variable m_slot_loaded_cv;
+  std::thread m_prefetch_thread;
+};
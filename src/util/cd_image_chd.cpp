@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: CC-BY-NC-ND-4.0
 
 #include "cd_image.h"
+#include "cd_image_block_cache.h"
 
 #include "common/align.h"
 #include "common/assert.h"
@@ -9,7 +10,6 @@
 #include "common/file_system.h"
 #include "common/gsvector.h"
 #include "common/hash_combine.h"
-#include "common/heap_array.h"
 #include "common/log.h"
 #include "common/path.h"
 #include "common/progress_callback.h"
@@ -27,6 +27,7 @@
 #include <limits>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 LOG_CHANNEL(CDImage);
 
@@ -69,6 +70,7 @@ public:
   bool HasSubchannelData() const override;
   PrecacheResult Precache(ProgressCallback* progress, Error* error) override;
   bool IsPrecached() const override;
+  void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks) override;
   s64 GetSizeOnDisk() const override;
 
 protected:
@@ -82,15 +84,23 @@ private:
   chd_file* OpenCHD(std::string_view filename, FileSystem::ManagedCFilePtr fp, Error* error, u32 recursion_level);
   bool UpdateHunkBuffer(const Index& index, LBA lba_in_index, u32& hunk_offset);
 
+  bool ReadHunk(u32 hunk_index, u8* buffer);
+
   static void CopyAndSwap(void* dst_ptr, const u8* src_ptr);
 
   chd_file* m_chd = nullptr;
   u32 m_hunk_size = 0;
+  u32 m_hunk_count = 0;
   u32 m_sectors_per_hunk = 0;
 
-  DynamicHeapArray<u8, 16> m_hunk_buffer;
-  u32 m_current_hunk_index = static_cast<u32>(-1);
+  // Only accessed by the reading thread.
+  const u8* m_hunk_buffer = nullptr;
   bool m_precached = false;
+
+  CDImageBlockCache m_hunk_cache;
+
+  // libchdr is not thread-safe, hunk reads from both threads go through this.
+  std::mutex m_chd_mutex;
 };
 } // namespace
 
@@ -98,6 +108,8 @@ CDImageCHD::CDImageCHD() = default;
 
 CDImageCHD::~CDImageCHD()
 {
+  m_hunk_cache.Shutdown();
+
   if (m_chd)
     chd_close(m_chd);
 }
@@ -259,8 +271,9 @@ bool CDImageCHD::Open(const char* filename, Error* error)
     return false;
   }
 
+  m_hunk_count = header->totalhunks;
   m_sectors_per_hunk = m_hunk_size / CHD_CD_SECTOR_DATA_SIZE;
-  m_hunk_buffer.resize(m_hunk_size);
+  SetDecompressionCache(1, 0);
   m_filename = filename;
 
   u32 disc_lba = 0;
@@ -463,6 +476,7 @@ CDImage::PrecacheResult CDImageCHD::Precache(ProgressCallback* progress, Error*
     static_cast<ProgressCallback*>(param)->SetStatusText(TinyString::from_format("{}MB of {}MB", pos_mb, total_mb));
   };
 
+  std::unique_lock lock(m_chd_mutex);
   if (const chd_error err = chd_precache_progress(m_chd, callback, progress); err != CHDERR_NONE)
   {
     Error::SetStringFmt(error, "chd_precache_progress() failed: {}", chd_error_string(err));
@@ -478,6 +492,26 @@ bool CDImageCHD::IsPrecached() const
   return m_precached;
 }
 
+void CDImageCHD::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+  m_hunk_buffer = nullptr;
+  m_hunk_cache.Reset(m_hunk_size, m_hunk_count, cache_blocks, prefetch_blocks,
+                     [this](u32 hunk_index, u8* buffer, bool) { return ReadHunk(hunk_index, buffer); });
+}
+
+bool CDImageCHD::ReadHunk(u32 hunk_index, u8* buffer)
+{
+  std::unique_lock lock(m_chd_mutex);
+  const chd_error err = chd_read(m_chd, hunk_index, buffer);
+  if (err != CHDERR_NONE)
+  {
+    ERROR_LOG("chd_read({}) failed: {}", hunk_index, chd_error_string(err));
+    return false;
+  }
+
+  return true;
+}
+
 ALWAYS_INLINE_RELEASE void CDImageCHD::CopyAndSwap(void* dst_ptr, const u8* src_ptr)
 {
   constexpr u32 data_size = RAW_SECTOR_SIZE;
@@ -519,21 +553,8 @@ ALWAYS_INLINE_RELEASE bool CDImageCHD::UpdateHunkBuffer(const Index& index, LBA
   hunk_offset = static_cast<u32>((disc_frame % m_sectors_per_hunk) * CHD_CD_SECTOR_DATA_SIZE);
   DebugAssert((m_hunk_size - hunk_offset) >= CHD_CD_SECTOR_DATA_SIZE);
 
-  if (m_current_hunk_index == hunk_index)
-    return true;
-
-  const chd_error err = chd_read(m_chd, hunk_index, m_hunk_buffer.data());
-  if (err != CHDERR_NONE)
-  {
-    ERROR_LOG("chd_read({}) failed: {}", hunk_index, chd_error_string(err));
-
-    // data might have been partially written
-    m_current_hunk_index = static_cast<u32>(-1);
-    return false;
-  }
-
-  m_current_hunk_index = hunk_index;
-  return true;
+  m_hunk_buffer = m_hunk_cache.GetBlock(hunk_index);
+  return (m_hunk_buffer != nullptr);
 }
 
 s64 CDImageCHD::GetSizeOnDisk() const
@@ -12,7 +12,9 @@
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/memmap.h"
 #include "common/path.h"
+#include "common/progress_callback.h"
 #include "common/string_util.h"
 
 #include "fmt/format.h"
@@ -42,6 +44,11 @@ public:
 
   virtual bool Read(void* buffer, u64 offset, u32 size, Error* error) = 0;
 
+  virtual bool IsMemoryMapped() const;
+  virtual bool LockInMemory(Error* error);
+  virtual void UnlockInMemory();
+  virtual void SetMemoryMapping(bool enabled);
+
 protected:
   std::string m_filename;
 };
@@ -57,9 +64,17 @@ public:
 
   bool Read(void* buffer, u64 offset, u32 size, Error* error) override;
 
+  bool IsMemoryMapped() const override;
+  bool LockInMemory(Error* error) override;
+  void UnlockInMemory() override;
+  void SetMemoryMapping(bool enabled) override;
+
 private:
   FileSystem::ManagedCFilePtr m_file;
   u64 m_file_position = 0;
+
+  // Sectors are copied straight out of the mapping when available, the file is only read from as a fallback.
+  MappedFile m_mapping;
 };
 
 class ECMTrackFileInterface final : public TrackFileInterface
@@ -146,11 +161,16 @@ public:
 
   s64 GetSizeOnDisk() const override;
 
+  PrecacheResult Precache(ProgressCallback* progress, Error* error) override;
+  bool IsPrecached() const override;
+  void SetMemoryMapping(bool enabled) override;
+
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
 
 private:
   std::vector<std::unique_ptr<TrackFileInterface>> m_files;
+  bool m_precached = false;
 };
 
 } // namespace
@@ -163,6 +183,25 @@ TrackFileInterface::TrackFileInterface(std::string filename) : m_filename(std::m
 
 TrackFileInterface::~TrackFileInterface() = default;
 
+bool TrackFileInterface::IsMemoryMapped() const
+{
+  return false;
+}
+
+bool TrackFileInterface::LockInMemory(Error* error)
+{
+  Error::SetStringView(error, "Not supported for this file type.");
+  return false;
+}
+
+void TrackFileInterface::UnlockInMemory()
+{
+}
+
+void TrackFileInterface::SetMemoryMapping(bool enabled)
+{
+}
+
 BinaryTrackFileInterface::BinaryTrackFileInterface(std::string filename, FileSystem::ManagedCFilePtr file)
   : TrackFileInterface(std::move(filename)), m_file(std::move(file))
 {
@@ -194,6 +233,18 @@ std::unique_ptr<TrackFileInterface> TrackFileInterface::OpenBinaryFile(const std
 
 bool BinaryTrackFileInterface::Read(void* buffer, u64 offset, u32 size, Error* error)
 {
+  if (m_mapping.IsMapped())
+  {
+    if (offset > m_mapping.GetSize() || size > (m_mapping.GetSize() - offset)) [[unlikely]]
+    {
+      Error::SetStringFmt(error, "Read of {} bytes at offset {} is past the end of the file", size, offset);
+      return false;
+    }
+
+    std::memcpy(buffer, m_mapping.GetData() + offset, size);
+    return true;
+  }
+
   if (m_file_position != offset)
   {
     if (!FileSystem::FSeek64(m_file.get(), static_cast<s64>(offset), SEEK_SET, error)) [[unlikely]]
@@ -225,6 +276,39 @@ u64 BinaryTrackFileInterface::GetDiskSize()
   return static_cast<u64>(std::max<s64>(FileSystem::FSize64(m_file.get()), 0));
 }
 
+bool BinaryTrackFileInterface::IsMemoryMapped() const
+{
+  return m_mapping.IsMapped();
+}
+
+bool BinaryTrackFileInterface::LockInMemory(Error* error)
+{
+  return m_mapping.Lock(error);
+}
+
+void BinaryTrackFileInterface::UnlockInMemory()
+{
+  m_mapping.Unlock();
+}
+
+void BinaryTrackFileInterface::SetMemoryMapping(bool enabled)
+{
+  if (!enabled)
+  {
+    m_mapping.Unmap();
+    return;
+  }
+
+  if (m_mapping.IsMapped())
+    return;
+
+  Error error;
+  if (m_mapping.Map(m_file.get(), &error))
+    m_mapping.AdviseSequential();
+  else
+    DEV_LOG("Failed to map '{}', using file reads instead: {}", m_filename, error.GetDescription());
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 ECMTrackFileInterface::ECMTrackFileInterface(std::string path, FileSystem::ManagedCFilePtr file)
@@ -882,6 +966,57 @@ bool CDImageCueSheet::ReadSectorFromIndex(void* buffer, const Index& index, LBA
   return true;
 }
 
+CDImage::PrecacheResult CDImageCueSheet::Precache(ProgressCallback* progress, Error* error)
+{
+  if (m_precached)
+    return CDImage::PrecacheResult::Success;
+
+  // Only worth it if everything is mapped, otherwise a copy in memory is still needed.
+  for (const std::unique_ptr<TrackFileInterface>& tf : m_files)
+  {
+    if (!tf->IsMemoryMapped())
+      return CDImage::PrecacheResult::Unsupported;
+  }
+
+  progress->SetTitle("Locking CD image in memory...");
+  progress->SetProgressRange(static_cast<u32>(m_files.size()));
+
+  for (size_t i = 0; i < m_files.size(); i++)
+  {
+    progress->SetProgressValue(static_cast<u32>(i));
+
+    // Commonly hit with the default RLIMIT_MEMLOCK. Any file left out could still stall on reads, so fall back to a
+    // copy in memory, and don't keep the others pinned on top of it.
+    Error lock_error;
+    if (!m_files[i]->LockInMemory(&lock_error))
+    {
+      WARNING_LOG("Failed to lock '{}' in memory: {}", m_files[i]->GetFileName(), lock_error.GetDescription());
+      for (size_t j = 0; j < i; j++)
+        m_files[j]->UnlockInMemory();
+
+      return CDImage::PrecacheResult::Unsupported;
+    }
+  }
+
+  m_precached = true;
+  return CDImage::PrecacheResult::Success;
+}
+
+bool CDImageCueSheet::IsPrecached() const
+{
+  return m_precached;
+}
+
+void CDImageCueSheet::SetMemoryMapping(bool enabled)
+{
+  // Precaching only locked the mappings.
+  if (!enabled)
+    m_precached = false;
+
+  for (const std::unique_ptr<TrackFileInterface>& tf : m_files)
+    tf->SetMemoryMapping(enabled);
+}
+
 s64 CDImageCueSheet::GetSizeOnDisk() const
 {
   // Doesn't include the cue.. but they're tiny anyway, whatever.
@@ -35,6 +35,7 @@ public:
   u32 GetCurrentSubImage() const override;
   std::string GetSubImageTitle(u32 index) const override;
   bool SwitchSubImage(u32 index, Error* error) override;
+  void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks) override;
 
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
@@ -50,6 +51,8 @@ private:
   std::vector<Entry> m_entries;
   std::unique_ptr<CDImage> m_current_image;
   u32 m_current_image_index = UINT32_C(0xFFFFFFFF);
+  u32 m_cache_blocks = 0;
+  u32 m_prefetch_blocks = 0;
   bool m_apply_patches = false;
 };
 
@@ -150,6 +153,9 @@ bool CDImageM3u::SwitchSubImage(u32 index, Error* error)
     return false;
   }
 
+  if (m_cache_blocks > 0)
+    new_image->SetDecompressionCache(m_cache_blocks, m_prefetch_blocks);
+
   CopyTOC(new_image.get());
   m_current_image = std::move(new_image);
   m_current_image_index = index;
@@ -159,6 +165,14 @@ bool CDImageM3u::SwitchSubImage(u32 index, Error* error)
   return true;
 }
 
+void CDImageM3u::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+  // Remembered so that it also applies to the other discs when switching.
+  m_cache_blocks = cache_blocks;
+  m_prefetch_blocks = prefetch_blocks;
+  m_current_image->SetDecompressionCache(cache_blocks, prefetch_blocks);
+}
+
 std::string CDImageM3u::GetSubImageTitle(u32 index) const
 {
   std::string ret;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: CC-BY-NC-ND-4.0
 
 #include "cd_image.h"
+#include "cd_image_block_cache.h"
 
 #include "common/assert.h"
 #include "common/bcdutils.h"
@@ -9,15 +10,20 @@
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/progress_callback.h"
 #include "common/string_util.h"
+#include "common/task_queue.h"
 
 #include "fmt/format.h"
 #include "zlib.h"
 
 #include <array>
+#include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <vector>
@@ -142,10 +148,19 @@ public:
   bool SwitchSubImage(u32 index, Error* error) override;
   std::string GetSubImageTitle(u32 index) const override;
 
+  PrecacheResult Precache(ProgressCallback* progress, Error* error) override;
+  bool IsPrecached() const override;
+  void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks) override;
+
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
 
 private:
+  static constexpr u32 INVALID_BLOCK = static_cast<u32>(-1);
+
+  // Blocks decompressed per task when precaching.
+  static constexpr u32 PRECACHE_BLOCKS_PER_TASK = 64;
+
   struct BlockInfo
   {
     u32 offset; // Absolute offset from start of file
@@ -166,10 +181,17 @@ private:
 
   bool IsValidEboot(Error* error);
 
-  bool InitDecompressionStream();
-  bool DecompressBlock(const BlockInfo& block_info);
+  static bool InitDecompressionStream(z_stream* stream);
+  bool DecompressBlock(const BlockInfo& block_info, z_stream* stream, std::vector<u8>& compressed_block,
+                       u8* decompressed_block);
 
   bool OpenDisc(u32 index, Error* error);
+  u32 GetDiscBlockCount() const;
+
+  bool UpdateCurrentBlock(u32 block_index);
+  bool DecompressCachedBlock(u32 block_index, u8* buffer, bool for_prefetch);
+  void ResetBlockCache();
+  void ReleasePrecache();
 
   static const std::string* LookupStringSFOTableEntry(const char* key, const SFOTable& table);
 
@@ -189,20 +211,41 @@ private:
 
   std::array<TOCEntry, TOC_NUM_ENTRIES> m_toc;
 
-  u32 m_current_block = static_cast<u32>(-1);
-  std::array<u8, DECOMPRESSED_BLOCK_SIZE> m_decompressed_block;
+  // Only accessed by the reading thread.
+  const u8* m_decompressed_block = nullptr;
+  u32 m_current_block = INVALID_BLOCK;
   std::vector<u8> m_compressed_block;
 
   z_stream m_inflate_stream;
+
+  // Whole disc, decompressed on all cores.
+  u8* m_precache_data = nullptr;
+
+  CDImageBlockCache m_block_cache;
+  u32 m_cache_blocks = 1;
+  u32 m_prefetch_count = 0;
+
+  // Only accessed by the prefetch thread, created the first time it runs.
+  z_stream m_prefetch_stream;
+  std::vector<u8> m_prefetch_compressed_block;
+  bool m_prefetch_stream_initialized = false;
+
+  // m_file is shared between the reading, prefetch and precache threads.
+  std::mutex m_file_mutex;
 };
 } // namespace
 
 CDImagePBP::~CDImagePBP()
 {
+  m_block_cache.Shutdown();
+  ReleasePrecache();
+
   if (m_file)
     std::fclose(m_file);
 
   inflateEnd(&m_inflate_stream);
+  if (m_prefetch_stream_initialized)
+    inflateEnd(&m_prefetch_stream);
 }
 
 bool CDImagePBP::LoadPBPHeader(Error* error)
@@ -501,10 +544,14 @@ bool CDImagePBP::OpenDisc(u32 index, Error* error)
     return false;
   }
 
-  m_current_block = static_cast<u32>(-1);
+  // the block table is about to change under the prefetch thread
+  m_block_cache.Shutdown();
+  ReleasePrecache();
+
+  m_current_block = INVALID_BLOCK;
+  m_decompressed_block = nullptr;
   m_blockinfo_table.fill({});
   m_toc.fill({});
-  m_decompressed_block.fill(0x00);
   m_compressed_block.clear();
 
   // Go to ISO header
@@ -719,12 +766,14 @@ bool CDImagePBP::OpenDisc(u32 index, Error* error)
   AddLeadOutIndex();
 
   // Initialize zlib stream
-  if (!InitDecompressionStream())
+  if (!InitDecompressionStream(&m_inflate_stream))
   {
     ERROR_LOG("Failed to initialize zlib decompression stream");
     return false;
   }
 
+  ResetBlockCache();
+
   m_current_disc = index;
   return Seek(1, Position{0, 0, 0});
 }
@@ -742,45 +791,46 @@ const std::string* CDImagePBP::LookupStringSFOTableEntry(const char* key, const
   return &std::get<std::string>(data_value);
 }
 
-bool CDImagePBP::InitDecompressionStream()
+bool CDImagePBP::InitDecompressionStream(z_stream* stream)
 {
-  m_inflate_stream = {};
-  m_inflate_stream.next_in = Z_NULL;
-  m_inflate_stream.avail_in = 0;
-  m_inflate_stream.zalloc = Z_NULL;
-  m_inflate_stream.zfree = Z_NULL;
-  m_inflate_stream.opaque = Z_NULL;
-
-  int ret = inflateInit2(&m_inflate_stream, -MAX_WBITS);
+  *stream = {};
+  stream->next_in = Z_NULL;
+  stream->avail_in = 0;
+  stream->zalloc = Z_NULL;
+  stream->zfree = Z_NULL;
+  stream->opaque = Z_NULL;
+
+  int ret = inflateInit2(stream, -MAX_WBITS);
   return ret == Z_OK;
 }
 
-bool CDImagePBP::DecompressBlock(const BlockInfo& block_info)
+bool CDImagePBP::DecompressBlock(const BlockInfo& block_info, z_stream* stream, std::vector<u8>& compressed_block,
+                                 u8* decompressed_block)
 {
-  if (FileSystem::FSeek64(m_file, block_info.offset, SEEK_SET) != 0)
-    return false;
-
-  // Compression level 0 has compressed size == decompressed size.
-  if (block_info.size == m_decompressed_block.size())
   {
-    return (std::fread(m_decompressed_block.data(), sizeof(u8), m_decompressed_block.size(), m_file) ==
-            m_decompressed_block.size());
-  }
+    std::unique_lock lock(m_file_mutex);
+    if (FileSystem::FSeek64(m_file, block_info.offset, SEEK_SET) != 0)
+      return false;
 
-  m_compressed_block.resize(block_info.size);
+    // Compression level 0 has compressed size == decompressed size.
+    if (block_info.size == DECOMPRESSED_BLOCK_SIZE)
+      return (std::fread(decompressed_block, sizeof(u8), DECOMPRESSED_BLOCK_SIZE, m_file) == DECOMPRESSED_BLOCK_SIZE);
 
-  if (std::fread(m_compressed_block.data(), sizeof(u8), m_compressed_block.size(), m_file) != m_compressed_block.size())
-    return false;
+    compressed_block.resize(block_info.size);
+
+    if (std::fread(compressed_block.data(), sizeof(u8), compressed_block.size(), m_file) != compressed_block.size())
+      return false;
+  }
 
-  m_inflate_stream.next_in = m_compressed_block.data();
-  m_inflate_stream.avail_in = static_cast<uInt>(m_compressed_block.size());
-  m_inflate_stream.next_out = m_decompressed_block.data();
-  m_inflate_stream.avail_out = static_cast<uInt>(m_decompressed_block.size());
+  stream->next_in = compressed_block.data();
+  stream->avail_in = static_cast<uInt>(compressed_block.size());
+  stream->next_out = decompressed_block;
+  stream->avail_out = DECOMPRESSED_BLOCK_SIZE;
 
-  if (inflateReset(&m_inflate_stream) != Z_OK)
+  if (inflateReset(stream) != Z_OK)
     return false;
 
-  int err = inflate(&m_inflate_stream, Z_FINISH);
+  int err = inflate(stream, Z_FINISH);
   if (err != Z_STREAM_END) [[unlikely]]
   {
     ERROR_LOG("Inflate error {}", err);
@@ -790,6 +840,167 @@ bool CDImagePBP::DecompressBlock(const BlockInfo& block_info)
   return true;
 }
 
+u32 CDImagePBP::GetDiscBlockCount() const
+{
+  u64 file_size = 0;
+  for (const Index& index : m_indices)
+  {
+    if (index.file_sector_size > 0)
+      file_size = std::max(file_size, index.file_offset + static_cast<u64>(index.length) * index.file_sector_size);
+  }
+
+  return static_cast<u32>(std::min<u64>((file_size + (DECOMPRESSED_BLOCK_SIZE - 1)) / DECOMPRESSED_BLOCK_SIZE,
+                                        BLOCK_TABLE_NUM_ENTRIES));
+}
+
+void CDImagePBP::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+  m_cache_blocks = std::max(cache_blocks, 1u);
+  m_prefetch_count = prefetch_blocks;
+  ResetBlockCache();
+}
+
+void CDImagePBP::ResetBlockCache()
+{
+  // no point prefetching when the whole disc is already in memory
+  m_block_cache.Reset(DECOMPRESSED_BLOCK_SIZE, BLOCK_TABLE_NUM_ENTRIES, m_cache_blocks,
+                      m_precache_data ? 0 : m_prefetch_count,
+                      [this](u32 block_index, u8* buffer, bool for_prefetch) {
+                        return DecompressCachedBlock(block_index, buffer, for_prefetch);
+                      });
+  m_decompressed_block = nullptr;
+  m_current_block = INVALID_BLOCK;
+}
+
+bool CDImagePBP::DecompressCachedBlock(u32 block_index, u8* buffer, bool for_prefetch)
+{
+  const BlockInfo& bi = m_blockinfo_table[block_index];
+  if (!for_prefetch)
+    return DecompressBlock(bi, &m_inflate_stream, m_compressed_block, buffer);
+
+  // blocks past the end of the disc aren't worth an error
+  if (bi.size == 0)
+    return false;
+
+  if (!m_prefetch_stream_initialized)
+  {
+    if (!InitDecompressionStream(&m_prefetch_stream))
+    {
+      ERROR_LOG("Failed to initialize zlib decompression stream for prefetching");
+      return false;
+    }
+
+    m_prefetch_stream_initialized = true;
+  }
+
+  return DecompressBlock(bi, &m_prefetch_stream, m_prefetch_compressed_block, buffer);
+}
+
+bool CDImagePBP::UpdateCurrentBlock(u32 block_index)
+{
+  if (m_precache_data)
+  {
+    m_decompressed_block = &m_precache_data[static_cast<size_t>(block_index) * DECOMPRESSED_BLOCK_SIZE];
+    m_current_block = block_index;
+    return true;
+  }
+
+  m_decompressed_block = m_block_cache.GetBlock(block_index);
+  m_current_block = m_decompressed_block ? block_index : INVALID_BLOCK;
+  return (m_decompressed_block != nullptr);
+}
+
+CDImage::PrecacheResult CDImagePBP::Precache(ProgressCallback* progress, Error* error)
+{
+  if (m_precache_data)
+    return CDImage::PrecacheResult::Success;
+
+  const u32 num_blocks = GetDiscBlockCount();
+  m_precache_data = static_cast<u8*>(std::malloc(static_cast<size_t>(num_blocks) * DECOMPRESSED_BLOCK_SIZE));
+  if (!m_precache_data)
+  {
+    Error::SetStringFmt(error, "Failed to allocate memory for {} blocks", num_blocks);
+    return CDImage::PrecacheResult::ReadError;
+  }
+
+  progress->SetTitle("Decompressing PBP image...");
+  progress->SetProgressRange(num_blocks);
+  progress->SetProgressValue(0);
+
+  // Each task has its own zlib stream, only the file reads are serialized.
+  const u32 num_workers = std::max(std::thread::hardware_concurrency(), 1u);
+  TaskQueue queue;
+  queue.SetWorkerCount(num_workers);
+
+  std::atomic_bool failed{false};
+  u32 next_block = 0;
+  while (next_block < num_blocks && !failed.load(std::memory_order_relaxed))
+  {
+    // wait after each round, so there's some progress to show
+    const u32 round_end = std::min(next_block + PRECACHE_BLOCKS_PER_TASK * num_workers, num_blocks);
+    for (; next_block < round_end; next_block += PRECACHE_BLOCKS_PER_TASK)
+    {
+      const u32 first_block = next_block;
+      const u32 last_block = std::min(next_block + PRECACHE_BLOCKS_PER_TASK, round_end);
+      queue.SubmitTask([this, first_block, last_block, &failed]() {
+        z_stream stream;
+        if (!InitDecompressionStream(&stream))
+        {
+          failed.store(true, std::memory_order_relaxed);
+          return;
+        }
+
+        std::vector<u8> compressed_block;
+        for (u32 i = first_block; i < last_block; i++)
+        {
+          // blocks which aren't in the file error out when read, same as without precaching
+          const BlockInfo& bi = m_blockinfo_table[i];
+          if (bi.size == 0)
+            continue;
+
+          if (!DecompressBlock(bi, &stream, compressed_block,
+                               &m_precache_data[static_cast<size_t>(i) * DECOMPRESSED_BLOCK_SIZE]))
+          {
+            ERROR_LOG("Failed to decompress block {}", i);
+            failed.store(true, std::memory_order_relaxed);
+            break;
+          }
+        }
+
+        inflateEnd(&stream);
+      });
+    }
+
+    queue.WaitForAll();
+    progress->SetProgressValue(next_block);
+  }
+
+  if (failed.load(std::memory_order_relaxed))
+  {
+    ReleasePrecache();
+    Error::SetStringView(error, "Failed to decompress PBP image.");
+    return CDImage::PrecacheResult::ReadError;
+  }
+
+  // reads come straight from the precached data from now on
+  ResetBlockCache();
+  return CDImage::PrecacheResult::Success;
+}
+
+bool CDImagePBP::IsPrecached() const
+{
+  return (m_precache_data != nullptr);
+}
+
+void CDImagePBP::ReleasePrecache()
+{
+  if (!m_precache_data)
+    return;
+
+  std::free(m_precache_data);
+  m_precache_data = nullptr;
+}
+
 bool CDImagePBP::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
 {
   const u32 offset_in_file = static_cast<u32>(index.file_offset) + (lba_in_index * index.file_sector_size);
@@ -809,7 +1020,7 @@ bool CDImagePBP::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
     return false;
   }
 
-  if (m_current_block != requested_block && !DecompressBlock(bi)) [[unlikely]]
+  if (m_current_block != requested_block && !UpdateCurrentBlock(requested_block)) [[unlikely]]
   {
     ERROR_LOG("Failed to decompress block {}", requested_block);
     return false;
@@ -42,6 +42,7 @@ public:
   std::string GetSubImageTitle(u32 index) const override;
 
   PrecacheResult Precache(ProgressCallback* progress, Error* error) override;
+  void SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks) override;
 
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
@@ -468,6 +469,11 @@ CDImage::PrecacheResult CDImagePPF::Precache(ProgressCallback* progress, Error*
   return m_parent_image->Precache(progress, error);
 }
 
+void CDImagePPF::SetDecompressionCache(u32 cache_blocks, u32 prefetch_blocks)
+{
+  m_parent_image->SetDecompressionCache(cache_blocks, prefetch_blocks);
+}
+
 bool CDImagePPF::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
 {
   DebugAssert(index.file_index == 0);